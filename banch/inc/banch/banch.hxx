@@ -5,8 +5,17 @@
 ///
 /// \brief everything needed for drink-recipe keeping
 
-#include "nostl/set.hxx"
+#include "nostl/allocator.hxx"
+#include "nostl/cow_string.hxx"
+#include "nostl/hash_map.hxx"
+#include "nostl/hash_set.hxx"
 #include "nostl/serializable.hxx"
+#include "banch/binary.hxx"
+#include "banch/mapped_file.hxx"
+#include "banch/registry.hxx"
+#include "banch/symbols.hxx"
+
+#include <memory>
 
 /// \brief this class uses the standard C++ string implementation
 using std::string;
@@ -18,6 +27,113 @@ namespace banch {
 // DECLARATIONS //
 //////////////////
 
+/// \brief the kind of set Recipes and RecipeBooks keep their entries in
+///
+/// A HashSet, so adding an entry doesn't have to scan all the others for
+/// duplicates, while iterating still goes in insertion order. It also finds
+/// the n-th entry in O(log n), which is what the numbered views use. Its
+/// tables come from the heap, or from the Arena of a RecipeBook in arena mode.
+template <typename T>
+using Collection = nostl::HashSet<T, nostl::Hash<T>, nostl::EqualTo<T>,
+									nostl::ArenaStorage>;
+
+class Ingredient;
+
+/// \brief an Ingredient of one of the built-in kinds, as a plain value
+///
+/// A tagged union of a Beverage and an Extra: the kinds share the fields, so
+/// the value is small and needs no allocation of its own (a name loaded
+/// through a mapping stays a view). See CompactRecipe for a Recipe that keeps
+/// these in a contiguous array.
+struct IngredientValue {
+	/// \brief the kinds a value can be
+	enum Kind : std::uint8_t {
+		BEVERAGE = BINARY_TAG_BEVERAGE, ///< name and quanta of a Beverage
+		EXTRA = BINARY_TAG_EXTRA ///< text of an Extra (in name)
+	};
+
+	/// \brief create the value of a Beverage
+	///
+	/// \param name of the beverage
+	/// \param quanta the quantity expressed in units
+	/// \param symbol id of the name in the SymbolTable it is a view of
+	///
+	/// \return the value
+	static IngredientValue beverage(nostl::CowString name, unsigned int quanta,
+									std::uint32_t symbol = SymbolTable::NONE)
+	{
+		IngredientValue value = { BEVERAGE, std::move(name), quanta, symbol };
+		return value;
+	}
+
+	/// \brief create the value of an Extra
+	///
+	/// \param text of the extra
+	/// \param symbol id of the text in the SymbolTable it is a view of
+	///
+	/// \return the value
+	static IngredientValue extra(nostl::CowString text,
+									std::uint32_t symbol = SymbolTable::NONE)
+	{
+		IngredientValue value = { EXTRA, std::move(text), 0, symbol };
+		return value;
+	}
+
+	/// \brief create the matching heap object (adapter for the hierarchy)
+	///
+	/// \return a new Beverage or Extra
+	inline Ingredient * toIngredient() const;
+
+	/// \brief create the matching object in an arena
+	///
+	/// \param arena to create it in
+	/// \param symbols to intern the name into (nullptr copies it into the
+	/// arena)
+	///
+	/// \return a Beverage or Extra that must not be deleted
+	inline Ingredient * toIngredient(nostl::Arena & arena,
+										SymbolTable * symbols = nullptr) const;
+
+	/// \brief equals operator
+	///
+	/// \param rhs value to check equality with
+	///
+	/// \return true if kind and fields are the same (the symbols don't
+	/// matter)
+	bool operator==(IngredientValue const & rhs) const
+	{
+		return this->kind == rhs.kind && this->name == rhs.name &&
+				this->quanta == rhs.quanta;
+	}
+
+	Kind kind; ///< which kind of Ingredient this is
+	nostl::CowString name; ///< name of a Beverage, text of an Extra
+	unsigned int quanta; ///< quantity of a Beverage (0 for an Extra)
+	std::uint32_t symbol; ///< id of the interned name (SymbolTable::NONE if
+							///< the name isn't interned)
+}; // struct IngredientValue
+
+/// \brief call the visitor's method matching the kind of a value
+///
+/// \param value to visit
+/// \param visitor with beverage(name, quanta) and extra(text) methods
+///
+/// A switch over the tag instead of a virtual call, so the visitor's methods
+/// can be inlined.
+template <typename Visitor>
+inline void visit(IngredientValue const & value, Visitor & visitor)
+{
+	switch (value.kind)
+	{
+		case IngredientValue::BEVERAGE:
+			visitor.beverage(value.name, value.quanta);
+			break;
+		case IngredientValue::EXTRA:
+			visitor.extra(value.name);
+			break;
+	}
+}
+
 /// \brief abstract class for drink ingredients
 class Ingredient : public nostl::Serializable {
 public:
@@ -26,6 +142,53 @@ public:
 	/// \param stream to print into
 	virtual void print(std::ostream &) const = 0;
 
+	/// \brief virtual method for deserializing in place
+	///
+	/// \param scanner to take the lines from (keyword already read), names
+	/// may be views into its memory
+	virtual void deserialize(LineScanner &) = 0;
+
+	/// \brief deserialization from streams (see Serializable)
+	using nostl::Serializable::deserialize;
+
+	/// \brief virtual method for serializing into the binary format
+	///
+	/// \param writer to serialize into (type tag first)
+	virtual void serializeBinary(BinaryWriter &) const = 0;
+
+	/// \brief virtual method for deserializing from the binary format
+	///
+	/// \param reader to deserialize from (type tag already read)
+	virtual void deserializeBinary(BinaryReader &) = 0;
+
+	/// \brief virtual method for turning the ingredient into a plain value
+	///
+	/// \param value to store the ingredient in
+	///
+	/// \return false if the kind has no value representation (the default)
+	virtual bool toValue(IngredientValue &) const { return false; }
+
+	/// \brief virtual method for hashing the contents of the ingredient
+	///
+	/// \return hash of the kind and the fields (equal ingredients hash the
+	/// same), by default the hash of the text serialization
+	virtual std::uint64_t fingerprint() const;
+
+	/// \brief virtual method for comparing the contents of two ingredients
+	///
+	/// \param rhs ingredient to compare with
+	///
+	/// \return true if both are of the same kind with the same fields, by
+	/// default if their text serializations are the same
+	virtual bool equals(Ingredient const &) const;
+
+	/// \brief virtual method for sharing the names of the ingredient through
+	/// a symbol table (RecipeBooks call it on the Ingredients they get)
+	///
+	/// \param symbols to intern the names into, the ingredient may keep views
+	/// of them and their ids (the default keeps its names as they are)
+	virtual void intern(SymbolTable &) {}
+
 	/// \brief virtual destructor
 	virtual ~Ingredient() {}
 }; // class Ingredient
@@ -37,8 +200,9 @@ public:
 	///
 	/// \param name the name we can refer to the beverage as
 	/// \param quanta the quantity used in the recipe expressed in units
-	Beverage(string const name = "", unsigned int const quanta = 0)
-		:	name_(name), quanta_(quanta) {}
+	Beverage(nostl::CowString name = "", unsigned int const quanta = 0)
+		:	name_(std::move(name)), quanta_(quanta), symbol_(SymbolTable::NONE)
+	{}
 
 	/// \brief implementation of the print method
 	///
@@ -48,19 +212,72 @@ public:
 
 	/// \brief implementation of the serialization method
 	///
-	/// \param os stream to serialize into
-	inline void serialize(std::ostream & os) const;
+	/// \param sink to serialize into
+	inline void serialize(nostl::Sink & sink) const;
+
+	/// \brief serialization into streams (see Serializable)
+	using nostl::Serializable::serialize;
 
 	/// \brief implementation of the deserialization method
 	///
 	/// \param is stream to deserialize from
 	inline void deserialize(std::istream & is);
 
+	/// \brief implementation of the in place deserialization method
+	///
+	/// \param scanner to take the lines from
+	inline void deserialize(LineScanner & scanner);
+
+
+	/// \brief implementation of the binary serialization method
+	///
+	/// \param writer to serialize into
+	inline void serializeBinary(BinaryWriter & writer) const;
+
+	/// \brief implementation of the binary deserialization method
+	///
+	/// \param reader to deserialize from
+	inline void deserializeBinary(BinaryReader & reader);
+
+	/// \brief implementation of the value conversion method
+	///
+	/// \param value to store the ingredient in
+	///
+	/// \return true
+	inline bool toValue(IngredientValue & value) const;
+
+	/// \brief implementation of the fingerprint method
+	///
+	/// \return hash of the kind and the fields
+	inline std::uint64_t fingerprint() const;
+
+	/// \brief implementation of the content comparison method
+	///
+	/// \param rhs ingredient to compare with
+	///
+	/// \return true if rhs is an equal Beverage
+	inline bool equals(Ingredient const & rhs) const;
+
+	/// \brief implementation of the interning method (the name is swapped
+	/// for a view of the interned one)
+	///
+	/// \param symbols to intern the name into
+	inline void intern(SymbolTable & symbols);
+
+	/// \brief get the id of the name
+	///
+	/// \return its id in the SymbolTable it was interned into last
+	/// (SymbolTable::NONE if it wasn't)
+	inline std::uint32_t symbol() const { return this->symbol_; }
+
 
 private:
-	string name_; ///< the name of the beverage, for example: "Coke"
+	nostl::CowString name_; ///< the name of the beverage, for example: "Coke"
 	unsigned int quanta_; ///< the quantity of the beverage in the recipe
 							///< expressed in units
+	std::uint32_t symbol_; ///< id of the interned name
+
+	friend struct IngredientValue;
 }; // class Beverage
 
 /// \brief a derived ingredient class for everything that's not a beverage
@@ -72,7 +289,8 @@ public:
 	/// \brief constructor with default argument
 	///
 	/// \param text the extra itself
-	Extra(string const text = "") : text_(text) {}
+	Extra(nostl::CowString text = "")
+		:	text_(std::move(text)), symbol_(SymbolTable::NONE) {}
 
 	/// \brief implementation of the print method
 	///
@@ -82,37 +300,178 @@ public:
 
 	/// \brief implementation of the serialization method
 	///
-	/// \param os stream to serialize into
-	inline void serialize(std::ostream & os) const;
+	/// \param sink to serialize into
+	inline void serialize(nostl::Sink & sink) const;
+
+	/// \brief serialization into streams (see Serializable)
+	using nostl::Serializable::serialize;
 
 	/// \brief implementation of the deserialization method
 	///
 	/// \param is stream to deserialize from
 	inline void deserialize(std::istream & is);
 
+	/// \brief implementation of the in place deserialization method
+	///
+	/// \param scanner to take the lines from
+	inline void deserialize(LineScanner & scanner);
+
+
+	/// \brief implementation of the binary serialization method
+	///
+	/// \param writer to serialize into
+	inline void serializeBinary(BinaryWriter & writer) const;
+
+	/// \brief implementation of the binary deserialization method
+	///
+	/// \param reader to deserialize from
+	inline void deserializeBinary(BinaryReader & reader);
+
+	/// \brief implementation of the value conversion method
+	///
+	/// \param value to store the ingredient in
+	///
+	/// \return true
+	inline bool toValue(IngredientValue & value) const;
+
+	/// \brief implementation of the fingerprint method
+	///
+	/// \return hash of the kind and the fields
+	inline std::uint64_t fingerprint() const;
+
+	/// \brief implementation of the content comparison method
+	///
+	/// \param rhs ingredient to compare with
+	///
+	/// \return true if rhs is an equal Extra
+	inline bool equals(Ingredient const & rhs) const;
+
+	/// \brief implementation of the interning method (the text is swapped
+	/// for a view of the interned one)
+	///
+	/// \param symbols to intern the text into
+	inline void intern(SymbolTable & symbols);
+
+	/// \brief get the id of the text
+	///
+	/// \return its id in the SymbolTable it was interned into last
+	/// (SymbolTable::NONE if it wasn't)
+	inline std::uint32_t symbol() const { return this->symbol_; }
+
 
 private:
-	string text_; ///< the extra, for example: "A cherry"
+	nostl::CowString text_; ///< the extra, for example: "A cherry"
+	std::uint32_t symbol_; ///< id of the interned text
+
+	friend struct IngredientValue;
 }; // class Extra
 
+class Recipe;
+class RecipeBook;
+
+/// \brief interface for keeping derived data (indices, stores) in sync with
+/// a RecipeBook
+///
+/// Observers are attached to a book and told about every edit of it and of
+/// the Recipes in it. Additions are reported after they happened, removals
+/// right before, so the removed object can still be looked at.
+class BookObserver {
+public:
+	/// \brief a Recipe was added to the book
+	///
+	/// \param recipe that was added (with its ingredients)
+	virtual void recipeAdded(Recipe const &) {}
+
+	/// \brief a Recipe is about to be removed from the book
+	///
+	/// \param recipe that is removed (with its ingredients)
+	virtual void recipeRemoved(Recipe const &) {}
+
+	/// \brief an Ingredient was added to a Recipe of the book
+	///
+	/// \param recipe that was changed
+	/// \param ingredient that was added
+	virtual void ingredientAdded(Recipe const &, Ingredient const &) {}
+
+	/// \brief an Ingredient is about to be removed from a Recipe of the book
+	///
+	/// \param recipe that is changed
+	/// \param ingredient that is removed
+	virtual void ingredientRemoved(Recipe const &, Ingredient const &) {}
+
+	/// \brief all Recipes are about to be removed from the book
+	virtual void bookCleared() {}
+
+	/// \brief the book is being destroyed (the observer is detached)
+	virtual void bookDestroyed() {}
+
+	/// \brief virtual destructor
+	virtual ~BookObserver() {}
+}; // class BookObserver
+
 /// \brief class that contains ingredients (well, pointers to them)
+///
+/// The Recipe keeps the sum of its Ingredients' fingerprints up to date as
+/// they come and go. A sum doesn't depend on the order and counts repeated
+/// Ingredients, so together with the name it fingerprints the contents in
+/// O(1) (plus hashing the name), which is what comparisons look at first.
+///
+/// A Recipe may live in an Arena (see RecipeBook::ARENA): then its name, its
+/// set of Ingredients and the Ingredients themselves are in there as well,
+/// and nothing is ever deleted one by one. The names of its Ingredients are
+/// interned into a SymbolTable instead of being copied one by one.
 class Recipe : public nostl::Serializable {
 public:
 	/// \brief constructor with default argument
 	///
 	/// \param name the name of the Recipe
-	Recipe(string const name = "") : name_(name) {}
+	Recipe(nostl::CowString name = "")
+		:	name_(std::move(name)), contents_(0), book_(nullptr),
+			arena_(nullptr), symbols_(nullptr) {}
 
-	/// \brief equals operator
+	/// \brief constructor of a Recipe that lives in an Arena
+	///
+	/// \param name the name of the Recipe (copied into the Arena)
+	/// \param arena to keep everything in (construct the Recipe itself in
+	/// there too and never delete it)
+	/// \param symbols to intern the names of the Ingredients into (nullptr
+	/// copies each of them into the Arena), it has to outlive the Recipe or
+	/// the Recipe has to be added to a RecipeBook, which then takes over
+	Recipe(nostl::CowString const & name, nostl::Arena & arena,
+			SymbolTable * symbols = nullptr)
+		:	name_(nostl::CowString::view(arena.copy(name.data(), name.size()),
+											name.size())),
+			ingredients_(nostl::Hash<Ingredient *>(),
+							nostl::EqualTo<Ingredient *>(),
+							nostl::ArenaStorage(&arena)),
+			contents_(0), book_(nullptr), arena_(&arena), symbols_(symbols) {}
+
+	/// \brief equals operator (compares contents, not Ingredient pointers)
 	///
 	/// \param rhs recipe to check equality with
 	///
-	/// \return true if the two recipes are equal
-	inline bool operator==(Recipe const & rhs) const;
+	/// \return true if the two recipes have the same name and equal
+	/// Ingredients (in any order)
+	bool operator==(Recipe const & rhs) const;
+
+	/// \brief not equals operator
+	///
+	/// \param rhs recipe to check inequality with
+	///
+	/// \return true if the two recipes differ in name or Ingredients
+	inline bool operator!=(Recipe const & rhs) const { return !(*this == rhs); }
+
+	/// \brief hash the contents of the Recipe
+	///
+	/// \return hash of the name and the multiset of Ingredients (equal
+	/// Recipes have equal fingerprints)
+	inline std::uint64_t fingerprint() const;
 
 	/// \brief method that adds an ingredient
 	///
-	/// \param addendum ingredient to add
+	/// \param addendum ingredient to add (taken over; a Recipe in an Arena
+	/// moves the built-in kinds into it, deleting the original, and interns
+	/// their names)
 	inline void add(Ingredient * addendum);
 
 	/// \brief method that removes an Ingredient by pointer
@@ -125,6 +484,28 @@ public:
 	/// \param n number of ingredient to remove
 	void remove(unsigned int const n);
 
+	/// \brief method that returns a reference to the n-th Ingredient
+	///
+	/// \param n number of Ingredient to return reference to
+	///
+	/// \return reference to the chosen Ingredient
+	inline Ingredient & getNth(unsigned int n) const
+	{
+		return *this->ingredients_.at(n - 1);
+	}
+
+	/// \brief get the number of an Ingredient (as getNth() counts them)
+	///
+	/// \param ingredient to look for
+	///
+	/// \return its number, or 0 if it's not in the Recipe
+	inline unsigned int numberOf(Ingredient const & ingredient) const
+	{
+		unsigned int k = this->ingredients_.indexOf(
+									const_cast<Ingredient *>(&ingredient));
+		return k == this->ingredients_.size() ? 0 : k + 1;
+	}
+
 	/// \brief method that clears the recipe
 	void clear();
 
@@ -132,7 +513,7 @@ public:
 	/// \brief getter method for name of Recipe
 	///
 	/// \return the Recipe's name
-	std::string getName() const { return this->name_; }
+	std::string getName() const { return this->name_.str(); }
 
 	/// \brief method that prints all Ingredients (optionally with numbers)
 	///
@@ -148,28 +529,100 @@ public:
 
 	/// \brief implementation of the serialization method
 	///
-	/// \param os stream to serialize into
-	void serialize(std::ostream & os) const;
+	/// \param sink to serialize into
+	void serialize(nostl::Sink & sink) const;
+
+	/// \brief serialization into streams (see Serializable)
+	using nostl::Serializable::serialize;
 
 	/// \brief implementation of the deserialization method
 	///
 	/// \param is stream to deserialize from
 	void deserialize(std::istream & is);
 
+	/// \brief method that deserializes the Recipe in place (names become
+	/// views into the scanned memory)
+	///
+	/// \param scanner to take the lines from
+	void deserialize(LineScanner & scanner);
+
+
+	/// \brief method that serializes the Recipe into the binary format
+	///
+	/// \param writer to serialize into
+	void serializeBinary(BinaryWriter & writer) const;
+
+	/// \brief method that deserializes the Recipe from the binary format
+	///
+	/// \param reader to deserialize from (check its good() afterwards)
+	void deserializeBinary(BinaryReader & reader);
+
 
 	/// \brief destructor (frees memory)
 	inline ~Recipe();
 
 
 private:
-	string name_; ///< name of the recipe
-	nostl::Set<Ingredient *> ingredients_; ///< heterogenous container
+	/// \brief put an Ingredient into the set and tell the observers
+	///
+	/// \param addendum ingredient to add (ownership is already settled)
+	inline void insert(Ingredient * addendum);
+
+	/// \brief keep some characters for as long as the Recipe
+	///
+	/// \param data address of first character
+	/// \param size number of characters
+	///
+	/// \return a view of them (of a copy in the Arena, if there is one)
+	inline nostl::CowString keep(char const * data, unsigned int size) const
+	{
+		return nostl::CowString::view(this->arena_ != nullptr ?
+										this->arena_->copy(data, size) : data,
+										size);
+	}
+
+private:
+	nostl::CowString name_; ///< name of the recipe
+	Collection<Ingredient *> ingredients_; ///< heterogenous container
 											///< of Ingredient*s
+	std::uint64_t contents_; ///< sum of the Ingredients' fingerprints
+	RecipeBook * book_; ///< book the recipe is in (to notify its observers)
+	nostl::Arena * arena_; ///< Arena the Recipe lives in (nullptr if none)
+	SymbolTable * symbols_; ///< where the Ingredients' names go in an Arena
+
+	friend class RecipeBook;
 }; // class Recipe
 
 /// \brief a collection of Recipes
+///
+/// In arena mode the Recipes the book loads or deserializes, their
+/// Ingredients, sets and names all come from monotonic Arenas of the book
+/// (the input is copied, so nothing points into a file or buffer). Clearing
+/// the book then only releases the Arenas instead of deleting every object
+/// on its own; Recipes added from the heap are still deleted one by one.
+///
+/// The same ingredient names come up in thousands of Recipes, so the book
+/// interns the names of its Ingredients into a SymbolTable, whether they
+/// were owned, views into a loaded file or about to be copied into an Arena:
+/// they become views of a single copy per name, which compare by address,
+/// and the Ingredients know the ids of their names (IngredientValue::symbol),
+/// which observers can compare instead of the names. The views are valid as
+/// long as the book holds the Ingredients (values taken from them with
+/// toValue() are views too).
 class RecipeBook : public nostl::Serializable {
 public:
+	/// \brief where the book keeps the Recipes it creates
+	enum Memory {
+		HEAP, ///< every Recipe and Ingredient is a heap object of its own
+		ARENA ///< Recipes and Ingredients come from the book's Arenas
+	};
+
+
+	/// \brief constructor
+	///
+	/// \param memory where to keep the Recipes the book creates
+	explicit RecipeBook(Memory memory = HEAP);
+
 	/// \brief add recipe to the collection
 	///
 	/// \param addendum recipe to add
@@ -186,8 +639,35 @@ public:
 	inline void remove(unsigned int n) { this->remove(&(this->getNth(n))); }
 
 	/// \brief method that clears the book
+	///
+	/// In arena mode the Recipes from the Arenas aren't destroyed one by one,
+	/// the Arenas are released as a whole.
 	void clear();
 
+	/// \brief tell whether the book is in arena mode
+	///
+	/// \return true if it keeps its Recipes in Arenas
+	inline bool inArena() const { return !this->arenas_.empty(); }
+
+	/// \brief get the interned ingredient names
+	///
+	/// \return the symbol table of the book
+	inline SymbolTable const & symbols() const { return this->symbols_; }
+
+	/// \brief find the Recipes that are equal to one before them
+	///
+	/// \return the duplicates, in book order (the first of equal Recipes
+	/// isn't among them)
+	///
+	/// Recipes are grouped by fingerprint in a hash map, so only Recipes with
+	/// the same fingerprint are compared in full.
+	nostl::Vector<Recipe *> findDuplicates() const;
+
+	/// \brief remove the Recipes that are equal to one before them
+	///
+	/// \return number of Recipes removed
+	unsigned int removeDuplicates();
+
 
 	/// \brief method that returns a reference to the n-th Recipe
 	///
@@ -196,6 +676,25 @@ public:
 	/// \return reference to the chose Recipe
 	Recipe & getNth(unsigned int);
 
+	/// \brief get the number of a Recipe (as getNth() counts them)
+	///
+	/// \param recipe to look for
+	///
+	/// \return its number, or 0 if it's not in the book
+	inline unsigned int numberOf(Recipe const & recipe) const
+	{
+		unsigned int k = this->recipes_.indexOf(const_cast<Recipe *>(&recipe));
+		return k == this->recipes_.size() ? 0 : k + 1;
+	}
+
+	/// \brief find a Recipe by its name
+	///
+	/// \param name of the Recipe
+	///
+	/// \return pointer to the Recipe or nullptr if there is none (the one
+	/// added first, if several have the same name)
+	inline Recipe * findByName(std::string const & name) const;
+
 
 	/// \brief list all Recipes in the book (optionally with numbers)
 	///
@@ -211,21 +710,138 @@ public:
 
 	/// \brief implementation of the serialization method
 	///
-	/// \param os stream to serialize into
-	void serialize(std::ostream & os) const;
+	/// \param sink to serialize into
+	void serialize(nostl::Sink & sink) const;
+
+	/// \brief serialization into streams (see Serializable)
+	using nostl::Serializable::serialize;
 
 	/// \brief implementation of the deserialization method
 	///
 	/// \param is stream to deserialize from
 	void deserialize(std::istream & is);
 
+	/// \brief method that deserializes the book in place (names become
+	/// views into the scanned memory, which has to outlive the book)
+	///
+	/// \param scanner to take the lines from
+	void deserialize(LineScanner & scanner);
+
+	/// \brief method that deserializes text in place, on several threads
+	///
+	/// \param begin address of first character
+	/// \param end address past the last character
+	/// \param threads number of threads to parse with (1 parses sequentially)
+	///
+	/// Recipes are independent blocks, so the text is cut into chunks at
+	/// recipe boundaries, a pool of workers parses the chunks into batches and
+	/// the batches are merged into the book in their original order.
+	void deserialize(char const * begin, char const * end, unsigned int threads);
+
+	/// \brief method that maps a database file (text or binary) into memory
+	/// and deserializes it in place
+	///
+	/// \param path of the file to load
+	/// \param threads number of threads to parse text files with
+	///
+	/// \return false if the file couldn't be mapped or is not a valid
+	/// database (the book is left empty then)
+	///
+	/// \note the mapping lives until the book is cleared, Recipe names are
+	/// views into it until they are modified (in arena mode they are copied
+	/// into the Arenas and the file is unmapped right away), ingredient names
+	/// are interned either way
+	bool load(char const * path, unsigned int threads = 1);
+
+	/// \brief method that saves the book into a database file
+	///
+	/// \param path of the file (replaced if it exists)
+	/// \param binary if true, the binary format is written, else the text one
+	///
+	/// \return false if the file couldn't be written (the old one is left as
+	/// it was then)
+	///
+	/// The book is written into a new file next to the old one, which is
+	/// then renamed over it: the names of a loaded book may still point into
+	/// the mapping of the old file, truncating it would pull the pages out
+	/// from under them.
+	bool save(char const * path, bool binary = false) const;
+
+
+	/// \brief method that serializes the book into the binary format
+	///
+	/// \param sink to serialize into (its target in binary mode, if a file)
+	void serializeBinary(nostl::Sink & sink) const;
+
+	/// \brief method that serializes the book into the binary format
+	///
+	/// \param os stream to serialize into (binary mode, if a file)
+	void serializeBinary(std::ostream & os) const;
+
+	/// \brief method that deserializes the book from the binary format
+	///
+	/// \param is stream to deserialize from (binary mode, if a file)
+	///
+	/// \return false if the data is not a valid binary book (the book is
+	/// left empty then)
+	bool deserializeBinary(std::istream & is);
+
+	/// \brief method that deserializes the book from binary data in memory
+	///
+	/// \param reader to deserialize from
+	///
+	/// \return false if the data is not a valid binary book (the book is
+	/// left empty then)
+	bool deserializeBinary(BinaryReader & reader);
+
+
+	/// \brief attach an observer, to be told about every edit from now on
+	///
+	/// \param observer to attach (not owned)
+	inline void attach(BookObserver * observer)
+	{
+		this->observers_.push_back(observer);
+	}
+
+	/// \brief detach an observer
+	///
+	/// \param observer to detach
+	void detach(BookObserver * observer);
+
 
 	/// \brief destructor (frees memory)
 	inline ~RecipeBook();
 
 
 private:
-	nostl::Set<Recipe *> recipes_; ///< set containing the recipes (pointers)
+	/// \brief drop a Recipe from the name index (before it's removed)
+	///
+	/// \param recipe to drop
+	void unindex(Recipe * recipe);
+
+	/// \brief get the Arena new Recipes go into
+	///
+	/// \return the first Arena (nullptr if not in arena mode)
+	inline nostl::Arena * arena() const
+	{
+		return this->arenas_.empty() ? nullptr : this->arenas_[0].get();
+	}
+
+private:
+	Collection<Recipe *> recipes_; ///< set containing the recipes (pointers)
+	nostl::HashMap<nostl::CowString, Recipe *> byName_; ///< name index (keys
+														///< are views of the
+														///< Recipes' names)
+	std::unique_ptr<MappedFile> mapping_; ///< file the names may point into
+	nostl::Vector<BookObserver *> observers_; ///< told about every edit
+	nostl::Vector<std::unique_ptr<nostl::Arena> > arenas_; ///< where Recipes
+															///< live in arena
+															///< mode (one per
+															///< parsing thread)
+	Collection<Recipe *> heapRecipes_; ///< Recipes from the heap (arena mode)
+	SymbolTable symbols_; ///< names of the Ingredients, kept once
+
+	friend class Recipe;
 }; // class RecipeBook
 
 
@@ -237,61 +853,276 @@ private:
 
 void Beverage::print(std::ostream & os) const
 {
-	os << this->quanta_ << " units of " << this->name_ << std::endl;
+	os << this->quanta_ << " units of " << this->name_ << '\n';
 }
 
-void Beverage::serialize(std::ostream & os) const
+void Beverage::serialize(nostl::Sink & sink) const
 {
-	os << "beverage" << std::endl;
-	os << this->name_ << std::endl;
-	os << this->quanta_ << std::endl;
+	sink << "beverage\n";
+	sink << this->name_ << '\n';
+	sink << this->quanta_ << '\n';
 }
 
 void Beverage::deserialize(std::istream & is)
 {
-	getline(is, this->name_);
+	this->symbol_ = SymbolTable::NONE;
+	getline(is, this->name_.mutate());
 	(is >> this->quanta_).ignore(1); // ignore is needed to flush the buffer
 }
 
+void Beverage::deserialize(LineScanner & scanner)
+{
+	char const * line;
+	unsigned int size;
+	if (scanner.next(line, size))
+	{
+		this->name_ = nostl::CowString::view(line, size);
+		this->symbol_ = SymbolTable::NONE;
+	}
+	if (scanner.next(line, size))
+	{
+		this->quanta_ = parseUnsigned(line, size);
+	}
+}
+
+void Beverage::serializeBinary(BinaryWriter & writer) const
+{
+	writer.writeByte(BINARY_TAG_BEVERAGE);
+	writer.writeString(this->name_);
+	writer.writeUint32(this->quanta_);
+}
+
+void Beverage::deserializeBinary(BinaryReader & reader)
+{
+	reader.readString(this->name_);
+	this->symbol_ = SymbolTable::NONE;
+	this->quanta_ = reader.readUint32();
+}
+
+bool Beverage::toValue(IngredientValue & value) const
+{
+	value = IngredientValue::beverage(this->name_, this->quanta_,
+										this->symbol_);
+	return true;
+}
+
+std::uint64_t Beverage::fingerprint() const
+{
+	return nostl::mix(nostl::hashBytes(this->name_.data(), this->name_.size()) ^
+						(static_cast<std::uint64_t>(this->quanta_) << 8 |
+							BINARY_TAG_BEVERAGE));
+}
+
+bool Beverage::equals(Ingredient const & rhs) const
+{
+	Beverage const * other = dynamic_cast<Beverage const *>(&rhs);
+	return other != nullptr && this->quanta_ == other->quanta_ &&
+			this->name_ == other->name_;
+}
+
+void Beverage::intern(SymbolTable & symbols)
+{
+	// a view of the name kept there is interned already
+	if (this->symbol_ < symbols.size() &&
+			symbols.name(this->symbol_).data() == this->name_.data())
+	{
+		return;
+	}
+
+	this->symbol_ = symbols.intern(this->name_);
+	nostl::CowString const & kept = symbols.name(this->symbol_);
+	this->name_.borrow(kept.data(), kept.size());
+}
+
 
 // class Garnish //
 
 void Extra::print(std::ostream & os) const
 {
-	os << this->text_ << std::endl;
+	os << this->text_ << '\n';
 }
 
-void Extra::serialize(std::ostream & os) const
+void Extra::serialize(nostl::Sink & sink) const
 {
-	os << "extra" << std::endl;
-	os << this->text_ << std::endl;
+	sink << "extra\n";
+	sink << this->text_ << '\n';
 }
 
 void Extra::deserialize(std::istream & is)
 {
-	getline(is, this->text_);
+	this->symbol_ = SymbolTable::NONE;
+	getline(is, this->text_.mutate());
+}
+
+void Extra::deserialize(LineScanner & scanner)
+{
+	char const * line;
+	unsigned int size;
+	if (scanner.next(line, size))
+	{
+		this->text_ = nostl::CowString::view(line, size);
+		this->symbol_ = SymbolTable::NONE;
+	}
+}
+
+void Extra::serializeBinary(BinaryWriter & writer) const
+{
+	writer.writeByte(BINARY_TAG_EXTRA);
+	writer.writeString(this->text_);
+}
+
+void Extra::deserializeBinary(BinaryReader & reader)
+{
+	reader.readString(this->text_);
+	this->symbol_ = SymbolTable::NONE;
+}
+
+bool Extra::toValue(IngredientValue & value) const
+{
+	value = IngredientValue::extra(this->text_, this->symbol_);
+	return true;
+}
+
+std::uint64_t Extra::fingerprint() const
+{
+	return nostl::mix(nostl::hashBytes(this->text_.data(), this->text_.size()) ^
+						BINARY_TAG_EXTRA);
+}
+
+bool Extra::equals(Ingredient const & rhs) const
+{
+	Extra const * other = dynamic_cast<Extra const *>(&rhs);
+	return other != nullptr && this->text_ == other->text_;
+}
+
+void Extra::intern(SymbolTable & symbols)
+{
+	// a view of the text kept there is interned already
+	if (this->symbol_ < symbols.size() &&
+			symbols.name(this->symbol_).data() == this->text_.data())
+	{
+		return;
+	}
+
+	this->symbol_ = symbols.intern(this->text_);
+	nostl::CowString const & kept = symbols.name(this->symbol_);
+	this->text_.borrow(kept.data(), kept.size());
+}
+
+
+// struct IngredientValue //
+
+Ingredient * IngredientValue::toIngredient() const
+{
+	if (this->kind == BEVERAGE)
+	{
+		return new Beverage(this->name, this->quanta);
+	}
+	return new Extra(this->name);
+}
+
+Ingredient * IngredientValue::toIngredient(nostl::Arena & arena,
+											SymbolTable * symbols) const
+{
+	// an interned name is kept once, however many Ingredients have it
+	std::uint32_t symbol = SymbolTable::NONE;
+	nostl::CowString name;
+	if (symbols != nullptr)
+	{
+		symbol = symbols->intern(this->name);
+		name = symbols->name(symbol);
+	}
+	else
+	{
+		name = nostl::CowString::view(
+						arena.copy(this->name.data(), this->name.size()),
+						this->name.size());
+	}
+
+	if (this->kind == BEVERAGE)
+	{
+		Beverage * beverage = arena.create<Beverage>(std::move(name),
+														this->quanta);
+		beverage->symbol_ = symbol;
+		return beverage;
+	}
+	Extra * extra = arena.create<Extra>(std::move(name));
+	extra->symbol_ = symbol;
+	return extra;
 }
 
 
 // class Recipe //
 
-inline bool Recipe::operator==(Recipe const & rhs) const
+std::uint64_t Recipe::fingerprint() const
 {
-	return (this->name_ == rhs.name_ && this->ingredients_ == rhs.ingredients_);
+	return nostl::mix(nostl::hashBytes(this->name_.data(), this->name_.size()) +
+						nostl::mix(this->contents_ + this->ingredients_.size()));
 }
 
 void Recipe::add(Ingredient * addendum)
 {
+	// only ingredients that weren't there yet count (and are told about)
+	if (this->ingredients_.contains(addendum))
+	{
+		return;
+	}
+
+	// in an Arena the built-in kinds are copied in (their names interned),
+	// the others are deleted along with the Arena
+	IngredientValue value;
+	if (this->arena_ != nullptr && addendum->toValue(value))
+	{
+		delete addendum;
+		addendum = value.toIngredient(*this->arena_, this->symbols_);
+	}
+	else if (this->arena_ != nullptr)
+	{
+		this->arena_->adopt(addendum);
+	}
+
+	this->insert(addendum);
+}
+
+void Recipe::insert(Ingredient * addendum)
+{
+	if (this->book_ != nullptr)
+	{
+		addendum->intern(this->book_->symbols_);
+	}
 	this->ingredients_.insert(addendum);
+	this->contents_ += addendum->fingerprint();
+	for (unsigned int k = 0;
+			this->book_ != nullptr && k < this->book_->observers_.size();
+			++k)
+	{
+		this->book_->observers_[k]->ingredientAdded(*this, *addendum);
+	}
 }
 
 void Recipe::remove(Ingredient * delendum)
 {
+	// tell the observers while the ingredient is still there
+	bool contained = this->ingredients_.contains(delendum);
+	if (contained)
+	{
+		this->contents_ -= delendum->fingerprint();
+		for (unsigned int k = 0;
+				this->book_ != nullptr && k < this->book_->observers_.size();
+				++k)
+		{
+			this->book_->observers_[k]->ingredientRemoved(*this, *delendum);
+		}
+	}
+
 	// get rid of pointer
 	this->ingredients_.remove(delendum);
 
-	// free memory
-	delete delendum;
+	// free memory (what's in an Arena goes along with it)
+	if (this->arena_ == nullptr || !contained)
+	{
+		delete delendum;
+	}
 }
 
 unsigned int Recipe::number_of_ingredients() const
@@ -309,16 +1140,73 @@ Recipe::~Recipe()
 
 void RecipeBook::add(Recipe * addendum)
 {
+	if (this->recipes_.contains(addendum))
+	{
+		return;
+	}
+
 	this->recipes_.insert(addendum);
+	addendum->book_ = this;
+	if (this->inArena() && addendum->arena_ == nullptr)
+	{
+		this->heapRecipes_.insert(addendum);
+	}
+	if (addendum->arena_ != nullptr)
+	{
+		addendum->symbols_ = &this->symbols_;
+	}
+
+	// equal names of the Ingredients are kept once per book (names interned
+	// into another table while parsing are interned again)
+	for (Collection<Ingredient *>::Iterator i = addendum->ingredients_.begin();
+			i != addendum->ingredients_.end();
+			++i)
+	{
+		(*i)->intern(this->symbols_);
+	}
+
+	// the key borrows the name, which doesn't move while the Recipe lives
+	this->byName_.insert(nostl::CowString::view(addendum->name_.data(),
+												addendum->name_.size()),
+							addendum);
+
+	for (unsigned int k = 0; k < this->observers_.size(); ++k)
+	{
+		this->observers_[k]->recipeAdded(*addendum);
+	}
 }
 
 void RecipeBook::remove(Recipe * delendum)
 {
-	// get rid of Recipe pointer
-	this->recipes_.remove(delendum);
+	// tell the observers while the Recipe is still there (only about one
+	// the book really holds)
+	bool contained = this->recipes_.contains(delendum);
+	if (contained)
+	{
+		for (unsigned int k = 0; k < this->observers_.size(); ++k)
+		{
+			this->observers_[k]->recipeRemoved(*delendum);
+		}
+
+		// get rid of Recipe pointer
+		this->unindex(delendum);
+		this->recipes_.remove(delendum);
+		this->heapRecipes_.remove(delendum);
+		delendum->book_ = nullptr;
+	}
+
+	// free memory (a Recipe in an Arena goes along with it)
+	if (delendum->arena_ == nullptr)
+	{
+		delete delendum;
+	}
+}
 
-	// free memory
-	delete delendum;
+Recipe * RecipeBook::findByName(std::string const & name) const
+{
+	Recipe * const * recipe =
+			this->byName_.find(nostl::CowString::view(name.data(), name.size()));
+	return recipe == nullptr ? nullptr : *recipe;
 }
 
 unsigned int RecipeBook::number_of_entries() const
@@ -329,6 +1217,10 @@ unsigned int RecipeBook::number_of_entries() const
 RecipeBook::~RecipeBook()
 {
 	this->clear();
+	for (unsigned int k = 0; k < this->observers_.size(); ++k)
+	{
+		this->observers_[k]->bookDestroyed();
+	}
 }
 
 } // namespace banch
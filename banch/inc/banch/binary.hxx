@@ -0,0 +1,229 @@
+#ifndef BANCH_BANCH_BINARY_HXX
+#define BANCH_BANCH_BINARY_HXX
+
+/// \file binary.hxx
+///
+/// \brief helpers for the binary on-disk format of RecipeBooks
+///
+/// The binary format is a header ("BNCH" and a version byte), the number of
+/// Recipes as a varint, then the Recipes one after the other. A Recipe is its
+/// name and the number of its Ingredients, followed by the Ingredients, each
+/// starting with a type tag byte. Strings are a varint length and the bytes,
+/// quantities are 32 bit little-endian integers. Varints are LEB128 (7 bits a
+/// byte, lowest group first, high bit set on all but the last byte).
+
+#include "nostl/cow_string.hxx"
+#include "nostl/sink.hxx"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief magic bytes every binary RecipeBook starts with
+static char const BINARY_MAGIC[4] = { 'B', 'N', 'C', 'H' };
+
+/// \brief version of the binary format written by this code
+static std::uint8_t const BINARY_VERSION = 1;
+
+/// \brief type tags of Ingredients in the binary format
+enum BinaryTag : std::uint8_t {
+	BINARY_TAG_BEVERAGE = 1, ///< a Beverage follows
+	BINARY_TAG_EXTRA = 2 ///< an Extra follows
+};
+
+
+/// \brief writer of the primitives of the binary format into a Sink
+class BinaryWriter {
+public:
+	/// \brief constructor
+	///
+	/// \param sink to write into (its target opened in binary mode, if a file)
+	explicit BinaryWriter(nostl::Sink & sink) : sink_(sink) {}
+
+	/// \brief write a single byte
+	///
+	/// \param byte to write
+	inline void writeByte(std::uint8_t);
+
+	/// \brief write an unsigned integer as a varint
+	///
+	/// \param value to write
+	void writeVarint(std::uint64_t);
+
+	/// \brief write a 32 bit little-endian integer
+	///
+	/// \param value to write
+	void writeUint32(std::uint32_t);
+
+	/// \brief write a length-prefixed string
+	///
+	/// \param data address of first character
+	/// \param size number of characters
+	void writeString(char const *, std::uint64_t);
+
+	/// \brief write a length-prefixed string
+	///
+	/// \param str null terminated string to write
+	inline void writeString(char const * str)
+	{
+		this->writeString(str, std::strlen(str));
+	}
+
+	/// \brief write a length-prefixed string
+	///
+	/// \param str string to write
+	inline void writeString(std::string const & str)
+	{
+		this->writeString(str.data(), str.size());
+	}
+
+	/// \brief write a length-prefixed string
+	///
+	/// \param str string to write
+	inline void writeString(nostl::CowString const & str)
+	{
+		this->writeString(str.data(), str.size());
+	}
+
+	/// \brief write raw bytes
+	///
+	/// \param data address of first byte
+	/// \param size number of bytes
+	inline void writeBytes(char const * data, std::uint64_t size)
+	{
+		this->sink_.write(data, size);
+	}
+
+
+private:
+	nostl::Sink & sink_; ///< sink to write into
+}; // class BinaryWriter
+
+
+/// \brief reader of the primitives of the binary format from memory
+///
+/// Reading past the end or decoding garbage doesn't throw, it puts the
+/// reader into a failed state (like a stream) and returns zeros/empty strings
+/// from then on; check good() once done.
+class BinaryReader {
+public:
+	/// \brief constructor
+	///
+	/// \param begin address of first byte
+	/// \param end address past the last byte
+	/// \param borrow if true, strings read into CowStrings are views into
+	/// the data (which then has to outlive them)
+	BinaryReader(char const * begin, char const * end, bool borrow = false)
+		: current_(begin), end_(end), good_(true), borrow_(borrow) {}
+
+	/// \brief read a single byte
+	///
+	/// \return the byte
+	inline std::uint8_t readByte();
+
+	/// \brief read a varint
+	///
+	/// \return the value
+	std::uint64_t readVarint();
+
+	/// \brief read a 32 bit little-endian integer
+	///
+	/// \return the value
+	std::uint32_t readUint32();
+
+	/// \brief read a length-prefixed string
+	///
+	/// \param str string to read into
+	void readString(std::string &);
+
+	/// \brief read a length-prefixed string (a view, if borrowing)
+	///
+	/// \param str string to read into
+	void readString(nostl::CowString &);
+
+	/// \brief read raw bytes
+	///
+	/// \param number of bytes to read
+	///
+	/// \return address of the bytes (nullptr if there aren't enough)
+	char const * readBytes(std::uint64_t);
+
+
+	/// \brief put the reader into the failed state (e.g. on an unknown tag)
+	void fail() { this->good_ = false; }
+
+	/// \brief tell whether everything went fine so far
+	///
+	/// \return false if the data was truncated or malformed
+	bool good() const { return this->good_; }
+
+	/// \brief tell whether all the bytes have been read
+	///
+	/// \return true if there is nothing left
+	bool atEnd() const { return this->current_ == this->end_; }
+
+	/// \brief get the address of the next byte to read
+	///
+	/// \return address of next byte
+	char const * position() const { return this->current_; }
+
+
+private:
+	char const * current_; ///< next byte to read
+	char const * end_; ///< past the last byte
+	bool good_; ///< false once something went wrong
+	bool borrow_; ///< true if strings may point into the data
+}; // class BinaryReader
+
+
+///////////////
+// FUNCTIONS //
+///////////////
+
+/// \brief tell whether a stream holds a binary RecipeBook
+///
+/// \param stream to check (its position is restored)
+///
+/// \return true if the stream starts with the binary magic
+bool isBinaryFormat(std::istream &);
+
+/// \brief convert a RecipeBook file between the text and binary formats
+///
+/// \param stream to read from (in either format)
+/// \param stream to write the other format into
+///
+/// \return true if the input was read successfully
+bool convertFormat(std::istream &, std::ostream &);
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+void BinaryWriter::writeByte(std::uint8_t byte)
+{
+	this->sink_ << static_cast<char>(byte);
+}
+
+std::uint8_t BinaryReader::readByte()
+{
+	if (this->current_ == this->end_)
+	{
+		this->good_ = false;
+		return 0;
+	}
+	return static_cast<std::uint8_t>(*this->current_++);
+}
+
+} // namespace banch
+
+#endif // BANCH_BANCH_BINARY_HXX
@@ -0,0 +1,234 @@
+#ifndef BANCH_BANCH_COLUMNS_HXX
+#define BANCH_BANCH_COLUMNS_HXX
+
+/// \file columns.hxx
+///
+/// \brief columnar (struct of arrays) copy of a RecipeBook for scans
+
+#include "banch/banch.hxx"
+#include "banch/symbols.hxx"
+#include "nostl/cow_string.hxx"
+#include "nostl/hash_map.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief the ingredients of a RecipeBook as parallel arrays
+///
+/// Every ingredient is a row: its kind, the id of its name (Beverage name or
+/// Extra text, the id the book's SymbolTable gave it), its quanta and the
+/// slot of its Recipe. Recipes have a column of their own (the number of ingredients).
+/// Aggregates are then plain loops over a few arrays that the compiler can
+/// vectorize, instead of chasing pointers through two levels of sets.
+///
+/// The store observes the book, so it is kept in sync with every edit in
+/// O(1): added ingredients are appended as rows, removed ones become dead
+/// rows (kind DEAD, which no scan matches). Once dead rows outnumber the
+/// live ones, the store is rebuilt from the book, which also puts the rows
+/// back in book order.
+class ColumnarBook : public BookObserver {
+public:
+	/// \brief kind of dead rows
+	static std::uint8_t const DEAD = 0;
+
+	/// \brief kind of rows of Ingredients without a value representation
+	static std::uint8_t const OTHER = 0xff;
+
+	/// \brief name id of rows without a name
+	static std::uint32_t const NO_NAME = SymbolTable::NONE;
+
+
+	/// \brief constructor that builds the store and attaches it to the book
+	///
+	/// \param book to mirror
+	explicit ColumnarBook(RecipeBook & book);
+
+	/// \brief rebuild the store from the book (dropping dead rows)
+	void rebuild();
+
+
+	/// \brief get the number of rows (dead ones included)
+	///
+	/// \return length of the ingredient columns
+	inline unsigned int rows() const { return this->kind_.size(); }
+
+	/// \brief get the number of dead rows
+	///
+	/// \return number of rows no ingredient belongs to anymore
+	inline unsigned int deadRows() const { return this->dead_; }
+
+	/// \brief get the kind column
+	///
+	/// \return array of IngredientValue::Kind, DEAD or OTHER per row
+	inline std::uint8_t const * kinds() const { return this->kind_.begin(); }
+
+	/// \brief get the name id column
+	///
+	/// \return array of name ids (NO_NAME for dead and OTHER rows) per row
+	inline std::uint32_t const * nameIds() const { return this->name_.begin(); }
+
+	/// \brief get the quanta column
+	///
+	/// \return array of quanta (0 for anything but Beverages) per row
+	inline std::uint32_t const * quanta() const { return this->quanta_.begin(); }
+
+	/// \brief get the recipe column
+	///
+	/// \return array of recipe slots per row
+	inline std::uint32_t const * recipes() const
+	{
+		return this->recipe_.begin();
+	}
+
+	/// \brief get the number of recipe slots
+	///
+	/// \return length of the recipe columns
+	inline unsigned int recipeSlots() const { return this->count_.size(); }
+
+	/// \brief get the ingredient count column
+	///
+	/// \return array of the number of ingredients per recipe slot (0 for the
+	/// slots of removed Recipes)
+	inline std::uint32_t const * ingredientCounts() const
+	{
+		return this->count_.begin();
+	}
+
+
+	/// \brief look up the id of a name
+	///
+	/// \param name to look up
+	///
+	/// \return the id or NO_NAME if no ingredient of the book ever had that
+	/// name
+	inline std::uint32_t nameId(std::string const & name) const;
+
+	/// \brief look up the name of an id
+	///
+	/// \param id of a name
+	///
+	/// \return the name (a view of the book's copy)
+	inline nostl::CowString const & name(std::uint32_t id) const
+	{
+		return this->book_->symbols().name(id);
+	}
+
+
+	/// \brief sum the quanta of every Beverage with a given name
+	///
+	/// \param name of the Beverages
+	///
+	/// \return total units
+	unsigned long long totalQuanta(std::string const & name) const;
+
+	/// \brief count the Recipes with more than a given number of ingredients
+	///
+	/// \param n number of ingredients to exceed
+	///
+	/// \return number of Recipes
+	unsigned int countRecipesWithMoreThan(unsigned int n) const;
+
+	/// \brief count the ingredients of a kind
+	///
+	/// \param kind to count
+	///
+	/// \return number of ingredients
+	unsigned int countKind(std::uint8_t kind) const;
+
+
+	/// \brief add the rows of a new Recipe
+	///
+	/// \param recipe that was added
+	void recipeAdded(Recipe const & recipe);
+
+	/// \brief kill the rows of a Recipe
+	///
+	/// \param recipe that is removed
+	void recipeRemoved(Recipe const & recipe);
+
+	/// \brief add a row
+	///
+	/// \param recipe that was changed
+	/// \param ingredient that was added
+	void ingredientAdded(Recipe const & recipe, Ingredient const & ingredient);
+
+	/// \brief kill a row
+	///
+	/// \param recipe that is changed
+	/// \param ingredient that is removed
+	void ingredientRemoved(Recipe const & recipe,
+							Ingredient const & ingredient);
+
+	/// \brief drop everything
+	void bookCleared();
+
+	/// \brief drop everything and forget the book
+	void bookDestroyed();
+
+
+	/// \brief destructor (detaches from the book)
+	~ColumnarBook();
+
+
+private:
+	/// \brief drop all rows and recipe slots
+	void reset();
+
+	/// \brief append the rows of a Recipe in a new slot
+	///
+	/// \param recipe to append
+	void append(Recipe const & recipe);
+
+	/// \brief append a row
+	///
+	/// \param slot of the ingredient's Recipe
+	/// \param ingredient to append
+	void append(std::uint32_t slot, Ingredient const & ingredient);
+
+	/// \brief kill a row
+	///
+	/// \param ingredient of the row
+	void kill(Ingredient const & ingredient);
+
+	/// \brief rebuild if the dead rows outnumber the live ones
+	///
+	/// \return true if rebuilt
+	bool compactIfSparse();
+
+private:
+	RecipeBook * book_; ///< the mirrored book (nullptr once it's gone)
+
+	nostl::Vector<std::uint8_t> kind_; ///< kind column
+	nostl::Vector<std::uint32_t> name_; ///< name id column
+	nostl::Vector<std::uint32_t> quanta_; ///< quanta column
+	nostl::Vector<std::uint32_t> recipe_; ///< recipe slot column
+	nostl::Vector<std::uint32_t> count_; ///< ingredients per recipe slot
+	unsigned int dead_; ///< number of dead rows
+
+	nostl::HashMap<Ingredient const *, std::uint32_t> rowOf_; ///< live rows
+	nostl::HashMap<Recipe const *, std::uint32_t> slotOf_; ///< live slots
+}; // class ColumnarBook
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+std::uint32_t ColumnarBook::nameId(std::string const & name) const
+{
+	return this->book_ == nullptr ? NO_NAME :
+			this->book_->symbols().find(name.data(), name.size());
+}
+
+} // namespace banch
+
+#endif // BANCH_BANCH_COLUMNS_HXX
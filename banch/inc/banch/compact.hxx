@@ -0,0 +1,161 @@
+#ifndef BANCH_BANCH_COMPACT_HXX
+#define BANCH_BANCH_COMPACT_HXX
+
+/// \file compact.hxx
+///
+/// \brief Recipe that keeps its ingredients inline, as plain values
+
+#include "banch/banch.hxx"
+#include "nostl/vector.hxx"
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief a Recipe whose ingredients are IngredientValues in one array
+///
+/// No allocation per ingredient and no virtual call to print or serialize
+/// one: everything goes through visit(). Prints and serializes exactly like
+/// a Recipe does, the formats are interchangeable.
+///
+/// \note only the built-in kinds have values; converting a Recipe with other
+/// kinds of ingredients skips those
+class CompactRecipe : public nostl::Serializable {
+public:
+	/// \brief constructor with default argument
+	///
+	/// \param name the name of the Recipe
+	CompactRecipe(nostl::CowString name = "") : name_(std::move(name)) {}
+
+	/// \brief constructor converting a Recipe
+	///
+	/// \param recipe to convert
+	explicit CompactRecipe(Recipe const & recipe);
+
+	/// \brief convert into a Recipe (adapter for the Ingredient hierarchy)
+	///
+	/// \return a new Recipe with the same ingredients
+	Recipe * toRecipe() const;
+
+	/// \brief equals operator
+	///
+	/// \param rhs recipe to check equality with
+	///
+	/// \return true if the two recipes are equal
+	inline bool operator==(CompactRecipe const & rhs) const
+	{
+		return this->name_ == rhs.name_ && this->ingredients_ == rhs.ingredients_;
+	}
+
+
+	/// \brief method that adds an ingredient
+	///
+	/// \param value ingredient to add
+	inline void add(IngredientValue value)
+	{
+		this->ingredients_.push_back(std::move(value));
+	}
+
+	/// \brief method that removes the n-th ingredient
+	///
+	/// \param n number of ingredient to remove
+	void remove(unsigned int n);
+
+	/// \brief method that clears the recipe
+	inline void clear() { this->ingredients_.clear(); }
+
+
+	/// \brief getter method for name of Recipe
+	///
+	/// \return the Recipe's name
+	inline std::string getName() const { return this->name_.str(); }
+
+	/// \brief method that returns a reference to the n-th ingredient
+	///
+	/// \param n number of ingredient to return reference to
+	///
+	/// \return reference to the chosen ingredient
+	inline IngredientValue const & getNth(unsigned int n) const
+	{
+		return this->ingredients_[n - 1];
+	}
+
+	/// \brief method that tells the number of ingredients in recipe
+	///
+	/// \return the number of ingredients
+	inline unsigned int number_of_ingredients() const
+	{
+		return this->ingredients_.size();
+	}
+
+	/// \brief visit all ingredients in order
+	///
+	/// \param visitor with beverage(name, quanta) and extra(text) methods
+	template <typename Visitor>
+	inline void visit(Visitor & visitor) const;
+
+
+	/// \brief method that prints all ingredients (optionally with numbers)
+	///
+	/// \param os stream to print into
+	/// \param numbering if true, all ingredients will be numbered
+	void show(std::ostream & os, bool numbering = false) const;
+
+
+	/// \brief implementation of the serialization method
+	///
+	/// \param sink to serialize into
+	void serialize(nostl::Sink & sink) const;
+
+	/// \brief serialization into streams (see Serializable)
+	using nostl::Serializable::serialize;
+
+	/// \brief implementation of the deserialization method
+	///
+	/// \param is stream to deserialize from
+	void deserialize(std::istream & is);
+
+	/// \brief method that deserializes the recipe in place (names become
+	/// views into the scanned memory)
+	///
+	/// \param scanner to take the lines from
+	void deserialize(LineScanner & scanner);
+
+
+	/// \brief method that serializes the recipe into the binary format
+	///
+	/// \param writer to serialize into
+	void serializeBinary(BinaryWriter & writer) const;
+
+	/// \brief method that deserializes the recipe from the binary format
+	///
+	/// \param reader to deserialize from (check its good() afterwards)
+	void deserializeBinary(BinaryReader & reader);
+
+
+private:
+	nostl::CowString name_; ///< name of the recipe
+	nostl::Vector<IngredientValue> ingredients_; ///< the ingredients inline
+}; // class CompactRecipe
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+template <typename Visitor>
+void CompactRecipe::visit(Visitor & visitor) const
+{
+	for (unsigned int k = 0; k < this->ingredients_.size(); ++k)
+	{
+		banch::visit(this->ingredients_[k], visitor);
+	}
+}
+
+} // namespace banch
+
+#endif // BANCH_BANCH_COMPACT_HXX
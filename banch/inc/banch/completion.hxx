@@ -0,0 +1,89 @@
+#ifndef BANCH_BANCH_COMPLETION_HXX
+#define BANCH_BANCH_COMPLETION_HXX
+
+/// \file completion.hxx
+///
+/// \brief completion of Recipe names from a prefix
+
+#include "banch/banch.hxx"
+#include "nostl/radix_trie.hxx"
+#include "nostl/vector.hxx"
+
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief lists the Recipes whose names start with a prefix
+///
+/// Names are kept lower case in a radix trie, each with the Recipes of that
+/// name (in book order), so completion ignores case and takes time
+/// proportional to the prefix and the number of completions. The trie
+/// observes the book and follows its Recipes coming and going.
+class NameCompleter : public BookObserver {
+public:
+	/// \brief constructor that builds the trie and attaches it to the book
+	///
+	/// \param book whose Recipe names to complete
+	explicit NameCompleter(RecipeBook & book);
+
+	/// \brief rebuild the trie from the book
+	void rebuild();
+
+
+	/// \brief find the Recipes whose names start with a prefix
+	///
+	/// \param prefix of the names (case doesn't matter)
+	/// \param k most Recipes to return
+	///
+	/// \return the Recipes, ordered by name
+	nostl::Vector<Recipe *> complete(std::string const & prefix,
+										unsigned int k = 10) const;
+
+	/// \brief get the number of distinct (lower case) names
+	///
+	/// \return number of names in the trie
+	inline unsigned int names() const { return this->trie_.size(); }
+
+
+	/// \brief add the name of a new Recipe
+	///
+	/// \param recipe that was added
+	void recipeAdded(Recipe const & recipe);
+
+	/// \brief drop the name of a Recipe
+	///
+	/// \param recipe that is removed
+	void recipeRemoved(Recipe const & recipe);
+
+	/// \brief drop everything
+	void bookCleared();
+
+	/// \brief drop everything and forget the book
+	void bookDestroyed();
+
+
+	/// \brief destructor (detaches from the book)
+	~NameCompleter();
+
+
+private:
+	/// \brief lower case a name
+	///
+	/// \param name to lower case
+	///
+	/// \return the key of the name in the trie
+	static std::string fold(std::string const & name);
+
+private:
+	RecipeBook * book_; ///< the book (nullptr once it's gone)
+	nostl::RadixTrie<nostl::Vector<Recipe *> > trie_; ///< name -> Recipes
+}; // class NameCompleter
+
+} // namespace banch
+
+#endif // BANCH_BANCH_COMPLETION_HXX
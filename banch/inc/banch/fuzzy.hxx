@@ -0,0 +1,185 @@
+#ifndef BANCH_BANCH_FUZZY_HXX
+#define BANCH_BANCH_FUZZY_HXX
+
+/// \file fuzzy.hxx
+///
+/// \brief typo tolerant search over Recipe and ingredient names
+
+#include "banch/banch.hxx"
+#include "nostl/cow_string.hxx"
+#include "nostl/hash_map.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief a Recipe found by a fuzzy search
+struct FuzzyMatch {
+	Recipe * recipe; ///< the Recipe
+	std::string text; ///< the (normalized) name that matched
+	bool ingredient; ///< true if text is an ingredient's name
+	unsigned int distance; ///< edit distance of text from the query
+}; // struct FuzzyMatch
+
+
+/// \brief finds Recipes by their names or their ingredients' names, even if
+/// misspelled
+///
+/// The distinct names (normalized like IngredientIndex does) are the terms
+/// of the index, and every term is posted under its trigrams (the three
+/// character substrings of the term padded with two spaces in front and one
+/// at the back). As an edit changes at most three trigrams, a term within
+/// edit distance k of the query shares all but 3k of the query's trigrams;
+/// only the terms that do are candidates, and only those have their edit
+/// distance computed (in a band of width 2k + 1, giving up beyond k).
+///
+/// The index observes the book. Terms no Recipe uses anymore stay in the
+/// postings (and are skipped) until they outnumber the live ones, then the
+/// index is rebuilt from the book.
+class FuzzyIndex : public BookObserver {
+public:
+	/// \brief constructor that builds the index and attaches it to the book
+	///
+	/// \param book to index
+	explicit FuzzyIndex(RecipeBook & book);
+
+	/// \brief rebuild the index from the book
+	void rebuild();
+
+
+	/// \brief find the Recipes with a name (or an ingredient name) close to
+	/// the query
+	///
+	/// \param query name to look for (normalized first)
+	/// \param maxDistance most edits allowed
+	/// \param limit most matches to return
+	///
+	/// \return matches, closest first (on ties Recipe names before ingredient
+	/// names, then in book order); a Recipe is there once, with its closest
+	/// name
+	nostl::Vector<FuzzyMatch> search(std::string const & query,
+										unsigned int maxDistance = 2,
+										unsigned int limit = 10) const;
+
+	/// \brief get the number of terms used by some Recipe
+	///
+	/// \return number of live terms
+	inline unsigned int terms() const
+	{
+		return this->text_.size() - this->deadTerms_;
+	}
+
+
+	/// \brief index a new Recipe
+	///
+	/// \param recipe that was added
+	void recipeAdded(Recipe const & recipe);
+
+	/// \brief drop a Recipe from the index
+	///
+	/// \param recipe that is removed
+	void recipeRemoved(Recipe const & recipe);
+
+	/// \brief index a new ingredient name of a Recipe
+	///
+	/// \param recipe that was changed
+	/// \param ingredient that was added
+	void ingredientAdded(Recipe const & recipe, Ingredient const & ingredient);
+
+	/// \brief drop an ingredient name of a Recipe
+	///
+	/// \param recipe that is changed
+	/// \param ingredient that is removed
+	void ingredientRemoved(Recipe const & recipe,
+							Ingredient const & ingredient);
+
+	/// \brief drop everything
+	void bookCleared();
+
+	/// \brief drop everything and forget the book
+	void bookDestroyed();
+
+
+	/// \brief destructor (detaches from the book)
+	~FuzzyIndex();
+
+
+private:
+	/// \brief a Recipe using a term
+	struct Use {
+		std::uint32_t recipe; ///< id of the Recipe
+		bool ingredient; ///< true if an ingredient's name, false if the
+						///< Recipe's name
+	}; // struct Use
+
+	/// \brief drop all terms, postings and Recipe ids
+	void reset();
+
+	/// \brief record that a Recipe uses a term
+	///
+	/// \param recipe id of the Recipe
+	/// \param term normalized name
+	/// \param ingredient true if the name is an ingredient's
+	void use(std::uint32_t recipe, std::string const & term, bool ingredient);
+
+	/// \brief record that a Recipe doesn't use a term anymore
+	///
+	/// \param recipe id of the Recipe
+	/// \param term normalized name
+	/// \param ingredient true if the name is an ingredient's
+	void unuse(std::uint32_t recipe, std::string const & term,
+				bool ingredient);
+
+	/// \brief get the id of a term, adding it and its trigrams if needed
+	///
+	/// \param term normalized name
+	///
+	/// \return the id
+	std::uint32_t intern(std::string const & term);
+
+	/// \brief rebuild if dead terms or Recipe ids outnumber the live ones
+	///
+	/// \return true if rebuilt
+	bool compactIfSparse();
+
+private:
+	RecipeBook * book_; ///< the indexed book (nullptr once it's gone)
+
+	nostl::Vector<Recipe *> recipes_; ///< Recipe of each id (or nullptr)
+	unsigned int removed_; ///< number of ids of removed Recipes
+	nostl::HashMap<Recipe const *, std::uint32_t> ids_; ///< id of each Recipe
+
+	nostl::Vector<std::string> text_; ///< text of each term
+	nostl::Vector<nostl::Vector<Use> > uses_; ///< Recipes using each term
+	unsigned int deadTerms_; ///< number of terms no Recipe uses
+	nostl::HashMap<nostl::CowString, std::uint32_t> terms_; ///< text -> term
+	nostl::HashMap<std::uint32_t, nostl::Vector<std::uint32_t> >
+		postings_; ///< trigram -> terms
+}; // class FuzzyIndex
+
+
+///////////////
+// FUNCTIONS //
+///////////////
+
+/// \brief compute the edit (Levenshtein) distance of two strings, up to a
+/// bound
+///
+/// \param lhs first string
+/// \param rhs second string
+/// \param bound largest distance of interest
+///
+/// \return the distance, or bound + 1 if it is larger than bound
+unsigned int editDistance(std::string const & lhs, std::string const & rhs,
+							unsigned int bound);
+
+} // namespace banch
+
+#endif // BANCH_BANCH_FUZZY_HXX
@@ -0,0 +1,185 @@
+#ifndef BANCH_BANCH_INGREDIENT_INDEX_HXX
+#define BANCH_BANCH_INGREDIENT_INDEX_HXX
+
+/// \file ingredient_index.hxx
+///
+/// \brief inverted index from ingredient names to the Recipes using them
+
+#include "banch/banch.hxx"
+#include "banch/symbols.hxx"
+#include "nostl/hash_map.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief answers "which Recipes use X" without looking at every Recipe
+///
+/// Every Recipe of the book gets an id (in the order they were added) and
+/// every normalized ingredient name (Beverage name or Extra text) a posting
+/// list: the sorted ids of the Recipes using it. Queries combine posting
+/// lists with linear merges.
+///
+/// Names are told apart by the ids the book's SymbolTable gave their
+/// normalized forms, so keeping the postings up to date compares integers
+/// only; just the names of a query are normalized and looked up.
+///
+/// The index observes the book, so edits update the affected posting lists
+/// only. Ids of removed Recipes aren't reused; once they outnumber the live
+/// ones, the index is rebuilt from the book.
+class IngredientIndex : public BookObserver {
+public:
+	/// \brief constructor that builds the index and attaches it to the book
+	///
+	/// \param book to index
+	explicit IngredientIndex(RecipeBook & book);
+
+	/// \brief rebuild the index from the book
+	void rebuild();
+
+
+	/// \brief normalize an ingredient name (lower case, single spaces)
+	///
+	/// \param data address of first character
+	/// \param size number of characters
+	///
+	/// \return the normalized name
+	static inline std::string normalize(char const * data, unsigned int size)
+	{
+		return SymbolTable::normalize(data, size);
+	}
+
+	/// \brief normalize an ingredient name (lower case, single spaces)
+	///
+	/// \param name to normalize
+	///
+	/// \return the normalized name
+	static inline std::string normalize(std::string const & name)
+	{
+		return normalize(name.data(), name.size());
+	}
+
+	/// \brief get the term of an ingredient: the id of its normalized name
+	///
+	/// \param ingredient to get the term of
+	/// \param symbols of the book the ingredient is in
+	///
+	/// \return the id or SymbolTable::NONE if the ingredient has no name (no
+	/// value representation) or the name isn't interned
+	static std::uint32_t termOf(Ingredient const & ingredient,
+								SymbolTable const & symbols);
+
+
+	/// \brief get the Recipes using an ingredient
+	///
+	/// \param ingredient name (normalized before the lookup)
+	///
+	/// \return the Recipes, in the order they were added to the book
+	nostl::Vector<Recipe *> recipesWith(std::string const & ingredient) const;
+
+	/// \brief get the Recipes matching a query
+	///
+	/// A query is ingredient names combined with the (upper case) operators
+	/// AND, OR and NOT, where AND binds stronger than OR and NOT negates the
+	/// name right after it, for example: "gin AND lime juice OR rum NOT mint".
+	///
+	/// \param query to answer
+	///
+	/// \return the Recipes, in the order they were added to the book
+	nostl::Vector<Recipe *> query(std::string const & query) const;
+
+	/// \brief get the number of distinct ingredient names
+	///
+	/// \return number of posting lists
+	inline unsigned int terms() const { return this->postings_.size(); }
+
+
+	/// \brief index a new Recipe
+	///
+	/// \param recipe that was added
+	void recipeAdded(Recipe const & recipe);
+
+	/// \brief drop a Recipe from the index
+	///
+	/// \param recipe that is removed
+	void recipeRemoved(Recipe const & recipe);
+
+	/// \brief post a Recipe under a new ingredient
+	///
+	/// \param recipe that was changed
+	/// \param ingredient that was added
+	void ingredientAdded(Recipe const & recipe, Ingredient const & ingredient);
+
+	/// \brief drop a Recipe from an ingredient's postings (if it was the last
+	/// ingredient of that name in the Recipe)
+	///
+	/// \param recipe that is changed
+	/// \param ingredient that is removed
+	void ingredientRemoved(Recipe const & recipe,
+							Ingredient const & ingredient);
+
+	/// \brief drop everything
+	void bookCleared();
+
+	/// \brief drop everything and forget the book
+	void bookDestroyed();
+
+
+	/// \brief destructor (detaches from the book)
+	~IngredientIndex();
+
+
+private:
+	/// \brief a posting list (sorted Recipe ids)
+	typedef nostl::Vector<std::uint32_t> Postings;
+
+	/// \brief drop all ids and postings
+	void reset();
+
+	/// \brief give a Recipe an id and post it under all its ingredients
+	///
+	/// \param recipe to index
+	void index(Recipe const & recipe);
+
+	/// \brief post a Recipe id under the name of an ingredient
+	///
+	/// \param id of the Recipe
+	/// \param ingredient to post under
+	void post(std::uint32_t id, Ingredient const & ingredient);
+
+	/// \brief drop a Recipe id from the postings of a term
+	///
+	/// \param id of the Recipe
+	/// \param term id of the normalized ingredient name
+	void unpost(std::uint32_t id, std::uint32_t term);
+
+	/// \brief get the postings of a name
+	///
+	/// \param name ingredient name (normalized before the lookup)
+	///
+	/// \return the postings or nullptr if no Recipe uses the name
+	Postings const * postings(std::string const & name) const;
+
+	/// \brief get the ids of all live Recipes
+	///
+	/// \return sorted ids
+	Postings everything() const;
+
+private:
+	RecipeBook * book_; ///< the indexed book (nullptr once it's gone)
+	nostl::Vector<Recipe *> recipes_; ///< Recipe of each id (or nullptr)
+	unsigned int removed_; ///< number of ids of removed Recipes
+	nostl::HashMap<Recipe const *, std::uint32_t> ids_; ///< id of each Recipe
+	nostl::HashMap<std::uint32_t, Postings> postings_; ///< term -> ids
+}; // class IngredientIndex
+
+} // namespace banch
+
+#endif // BANCH_BANCH_INGREDIENT_INDEX_HXX
@@ -6,6 +6,13 @@
 /// \brief function objects for a simple interface
 
 #include "banch/banch.hxx"
+#include "banch/completion.hxx"
+#include "banch/fuzzy.hxx"
+#include "banch/ingredient_index.hxx"
+#include "banch/inventory.hxx"
+#include "banch/journal.hxx"
+#include "banch/lazy_book.hxx"
+#include "banch/similarity.hxx"
 #include "menu/menu.hxx"
 
 /// \brief namespace for the banch project
@@ -202,23 +209,194 @@ private:
 }; // class Fremove_recipe
 
 
-/// \brief function object that prompts the user with saving database to file
-class Fsave_recipebook : public	Finteractive_function {
+/// \brief function object to prompt user with removing the duplicate Recipes
+class Fremove_duplicates : public Finteractive_function {
 public:
 	/// \brief constructor with 3 parameters
 	///
 	/// \param os stream to write into
 	/// \param is stream to read from
 	/// \param book RecipeBook object reference to tamper with
-	Fsave_recipebook(std::ostream & os, std::istream & is, RecipeBook & book)
+	Fremove_duplicates(std::ostream & os, std::istream & is, RecipeBook & book)
 		: Finteractive_function(os, is), book_(book) {}
 
+	/// \brief function that finds the duplicates and removes them once the
+	/// user confirms
+	void operator()();
+
+
+private:
+	RecipeBook & book_; ///< reference to RecipeBook to tamper with
+}; // class Fremove_duplicates
+
+
+/// \brief function object that lists the groups of Recipes with nearly the
+/// same ingredients
+class Fnear_duplicates : public Finteractive_function {
+public:
+	/// \brief constructor with 4 parameters
+	///
+	/// \param os stream to write into
+	/// \param is stream to read from
+	/// \param book RecipeBook object reference to look through
+	/// \param threads number of threads to look with
+	Fnear_duplicates(std::ostream & os, std::istream & is, RecipeBook & book,
+						unsigned int threads = 1)
+		: Finteractive_function(os, is), book_(book), threads_(threads) {}
+
+	/// \brief method that prompts the user for the least similarity and
+	/// lists the groups
+	void operator()();
+
+
+private:
+	RecipeBook & book_; ///< reference to RecipeBook to look through
+	unsigned int threads_; ///< number of threads to look with
+}; // class Fnear_duplicates
+
+
+/// \brief function object to prompt user with modifying a Recipe chosen by
+/// its name
+class Fmodify_recipe_by_name : public Finteractive_function {
+public:
+	/// \brief contructor with 4 parameters
+	///
+	/// \param os stream to write into
+	/// \param is stream to read from
+	/// \param book RecipeBook object reference to tamper with
+	/// \param completer NameCompleter of the book (to complete prefixes)
+	Fmodify_recipe_by_name(std::ostream & os, std::istream & is,
+							RecipeBook & book, NameCompleter const & completer)
+		: Finteractive_function(os, is), book_(book), completer_(completer) {}
+
+	/// \brief function that prompts the user for a name (or a prefix of it)
+	/// and to modify the Recipe with that name
+	void operator()();
+
+
+private:
+	RecipeBook & book_; ///< reference to RecipeBook to tamper with
+	NameCompleter const & completer_; ///< completes names of book_
+}; // class Fmodify_recipe_by_name
+
+
+/// \brief function object to prompt user with deleting a Recipe chosen by its
+/// name
+class Fremove_recipe_by_name : public Finteractive_function {
+public:
+	/// \brief constructor with 4 parameters
+	///
+	/// \param os stream to write into
+	/// \param is stream to read from
+	/// \param book RecipeBook object reference to tamper with
+	/// \param completer NameCompleter of the book (to complete prefixes)
+	Fremove_recipe_by_name(std::ostream & os, std::istream & is,
+							RecipeBook & book, NameCompleter const & completer)
+		: Finteractive_function(os, is), book_(book), completer_(completer) {}
+
+	/// \brief function that prompts the user for a name (or a prefix of it)
+	/// and to remove the Recipe with that name
+	void operator()();
+
+
+private:
+	RecipeBook & book_; ///< reference to RecipeBook to tamper with
+	NameCompleter const & completer_; ///< completes names of book_
+}; // class Fremove_recipe_by_name
+
+
+/// \brief function object that prompts the user for an ingredient query and
+/// shows the matching Recipes
+class Ffind_recipes : public Finteractive_function {
+public:
+	/// \brief constructor with 3 parameters
+	///
+	/// \param os stream to write into
+	/// \param is stream to read from
+	/// \param index IngredientIndex of the book to search
+	Ffind_recipes(std::ostream & os, std::istream & is,
+					IngredientIndex const & index)
+		: Finteractive_function(os, is), index_(index) {}
+
+	/// \brief method that prompts the user for a query and shows the results
+	void operator()();
+
+
+private:
+	IngredientIndex const & index_; ///< index of the book to search
+}; // class Ffind_recipes
+
+
+/// \brief function object that prompts the user for the bar inventory and
+/// shows what can be made of it
+class Fwhat_can_i_make : public Finteractive_function {
+public:
+	/// \brief constructor with 3 parameters
+	///
+	/// \param os stream to write into
+	/// \param is stream to read from
+	/// \param matcher InventoryMatcher of the book to search
+	Fwhat_can_i_make(std::ostream & os, std::istream & is,
+						InventoryMatcher const & matcher)
+		: Finteractive_function(os, is), matcher_(matcher) {}
+
+	/// \brief method that prompts the user for the inventory and lists the
+	/// Recipes that can be made
+	void operator()();
+
+
+private:
+	InventoryMatcher const & matcher_; ///< matcher of the book to search
+}; // class Fwhat_can_i_make
+
+
+/// \brief function object that prompts the user for a (possibly misspelled)
+/// name and shows the Recipes it's close to
+class Ffuzzy_search : public Finteractive_function {
+public:
+	/// \brief constructor with 3 parameters
+	///
+	/// \param os stream to write into
+	/// \param is stream to read from
+	/// \param index FuzzyIndex of the book to search
+	Ffuzzy_search(std::ostream & os, std::istream & is, FuzzyIndex const & index)
+		: Finteractive_function(os, is), index_(index) {}
+
+	/// \brief method that prompts the user for a name and lists the matches
+	void operator()();
+
+
+private:
+	FuzzyIndex const & index_; ///< index of the book to search
+}; // class Ffuzzy_search
+
+
+/// \brief function object that prompts the user with saving database to file
+///
+/// Saving to the snapshot of an open Journal only commits the edits made
+/// since the last save to the journal (compacting it now and then).
+class Fsave_recipebook : public	Finteractive_function {
+public:
+	/// \brief constructor with 5 parameters
+	///
+	/// \param os stream to write into
+	/// \param is stream to read from
+	/// \param book RecipeBook object reference to tamper with
+	/// \param binary whether to save in the binary format
+	/// \param journal of the book (nullptr if there is none)
+	Fsave_recipebook(std::ostream & os, std::istream & is, RecipeBook & book,
+						bool binary = false, Journal * journal = nullptr)
+		:	Finteractive_function(os, is), book_(book), binary_(binary),
+			journal_(journal) {}
+
 	/// \brief method that prompts the user for a filename and serializes book_
 	void operator()();
 
 
 private:
 	RecipeBook & book_; ///< reference to RecipeBook to tamper with
+	bool binary_; ///< true if saving in the binary format
+	Journal * journal_; ///< journal of the book (nullptr if none)
 }; // class Fsave_recipebook
 
 
@@ -230,18 +408,56 @@ public:
 	/// \param os stream to write into
 	/// \param is stream to read from
 	/// \param book RecipeBook object reference to tamper with
-	Fload_recipebook(std::ostream & os, std::istream & is, RecipeBook & book)
-		: Finteractive_function(os, is), book_(book) {}
+	/// \param threads number of threads to parse text files with
+	Fload_recipebook(std::ostream & os, std::istream & is, RecipeBook & book,
+						unsigned int threads = 1)
+		: Finteractive_function(os, is), book_(book), threads_(threads) {}
 
 	/// \brief method that prompts the user for a filename and deserializes book_
+	///
+	/// \note the format of the file (text or binary) is detected
 	void operator()();
 
 
 private:
 	RecipeBook & book_; ///< reference to RecipeBook to tamper with
+	unsigned int threads_; ///< number of threads to parse text files with
 }; // class Fload_recipebook
 
 
+/// \brief function object that prompts the user with browsing a database
+/// file without loading it (only the Recipes looked at are built)
+class Fbrowse_recipebook : public	Finteractive_function {
+public:
+	/// \brief constructor with 2 parameters
+	///
+	/// \param os stream to write into
+	/// \param is stream to read from
+	Fbrowse_recipebook(std::ostream & os, std::istream & is)
+		: Finteractive_function(os, is) {}
+
+	/// \brief method that prompts the user for a filename, then for Recipes
+	/// to show until an empty line
+	void operator()();
+}; // class Fbrowse_recipebook
+
+
+/// \brief function object that prompts the user with converting a database
+/// file between the text and binary formats
+class Fconvert_recipebook : public	Finteractive_function {
+public:
+	/// \brief constructor with 2 parameters
+	///
+	/// \param os stream to write into
+	/// \param is stream to read from
+	Fconvert_recipebook(std::ostream & os, std::istream & is)
+		: Finteractive_function(os, is) {}
+
+	/// \brief method that prompts the user for two filenames and converts
+	void operator()();
+}; // class Fconvert_recipebook
+
+
 /// \brief helper function object that acts like an std::bind
 ///
 /// TODO actually use std::bind?
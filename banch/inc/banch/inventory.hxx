@@ -0,0 +1,166 @@
+#ifndef BANCH_BANCH_INVENTORY_HXX
+#define BANCH_BANCH_INVENTORY_HXX
+
+/// \file inventory.hxx
+///
+/// \brief matching a bar inventory against the Recipes of a book
+
+#include "banch/banch.hxx"
+#include "nostl/hash_map.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief an ingredient in stock
+struct Stock {
+	std::string name; ///< name of the ingredient (normalized when matched)
+	unsigned long long units; ///< available units
+}; // struct Stock
+
+/// \brief a Recipe that can be made
+struct Makeable {
+	Recipe * recipe; ///< the Recipe
+	unsigned long long servings; ///< how many times it can be made
+}; // struct Makeable
+
+
+/// \brief answers "what can I make" for a bar inventory
+///
+/// A serving of a Recipe takes the quanta of each of its Beverages (summed up
+/// by name). Extras (and Beverages of zero quanta) only have to be in stock,
+/// they don't limit the servings. Recipes with ingredients of kinds that
+/// have no value representation can't be checked and are never makeable.
+///
+/// Ingredient names (normalized like IngredientIndex does) are numbered by
+/// the ids of their normalized forms in the book's SymbolTable, each of them
+/// getting the next bit the first time a Recipe uses it, and each Recipe's
+/// set of names is a bitset over those. As a Recipe uses a handful of names
+/// only, the bitset is stored sparsely: the nonzero 64 bit words and their
+/// indices. A query turns the inventory into a dense bitset and rejects
+/// every Recipe with a word not covered by it (one AND a word), before
+/// looking at any quantity.
+///
+/// The matcher observes the book; an edited Recipe gets its entry rewritten
+/// at the end of the pools, a removed one leaves a dead slot. Once the stale
+/// parts outgrow the live ones, everything is rebuilt from the book.
+class InventoryMatcher : public BookObserver {
+public:
+	/// \brief servings of Recipes no Beverage quantity limits
+	static unsigned long long const UNLIMITED = ~0ULL;
+
+
+	/// \brief constructor that builds the matcher and attaches it to the book
+	///
+	/// \param book to match against
+	explicit InventoryMatcher(RecipeBook & book);
+
+	/// \brief rebuild the matcher from the book
+	void rebuild();
+
+
+	/// \brief find the Recipes an inventory is enough for
+	///
+	/// \param inventory ingredients in stock (the units of repeated names add
+	/// up, names no Recipe uses are ignored)
+	///
+	/// \return the Recipes that can be made at least once, most servings
+	/// first (ties in book order)
+	nostl::Vector<Makeable> makeable(nostl::Vector<Stock> const & inventory) const;
+
+	/// \brief get the number of distinct ingredient names
+	///
+	/// \return number of bits handed out
+	inline unsigned int names() const { return this->names_; }
+
+
+	/// \brief add the entry of a new Recipe
+	///
+	/// \param recipe that was added
+	void recipeAdded(Recipe const & recipe);
+
+	/// \brief drop the entry of a Recipe
+	///
+	/// \param recipe that is removed
+	void recipeRemoved(Recipe const & recipe);
+
+	/// \brief rewrite the entry of a Recipe
+	///
+	/// \param recipe that was changed
+	/// \param ingredient that was added
+	void ingredientAdded(Recipe const & recipe, Ingredient const & ingredient);
+
+	/// \brief rewrite the entry of a Recipe (without the ingredient)
+	///
+	/// \param recipe that is changed
+	/// \param ingredient that is removed
+	void ingredientRemoved(Recipe const & recipe,
+							Ingredient const & ingredient);
+
+	/// \brief drop everything
+	void bookCleared();
+
+	/// \brief drop everything and forget the book
+	void bookDestroyed();
+
+
+	/// \brief destructor (detaches from the book)
+	~InventoryMatcher();
+
+
+private:
+	/// \brief drop all entries and bits
+	void reset();
+
+	/// \brief write the entry of a Recipe at the end of the pools
+	///
+	/// \param slot of the Recipe
+	/// \param recipe to write the entry of
+	/// \param skip ingredient to leave out (nullptr for none)
+	void write(std::uint32_t slot, Recipe const & recipe,
+				Ingredient const * skip);
+
+	/// \brief get the bit of a name, handing out the next one if needed
+	///
+	/// \param term id of the normalized name in the book's SymbolTable
+	///
+	/// \return the bit
+	std::uint32_t bitOf(std::uint32_t term);
+
+	/// \brief rebuild if the stale parts of the pools outgrow the live ones
+	///
+	/// \return true if rebuilt
+	bool compactIfSparse();
+
+private:
+	RecipeBook * book_; ///< the book (nullptr once it's gone)
+
+	nostl::Vector<Recipe *> recipe_; ///< Recipe of each slot (or nullptr)
+	nostl::Vector<std::uint32_t> bitsAt_; ///< first word of each slot
+	nostl::Vector<std::uint32_t> bitsCount_; ///< number of words of each slot
+	nostl::Vector<std::uint32_t> needsAt_; ///< first need of each slot
+	nostl::Vector<std::uint32_t> needsCount_; ///< number of needs of each slot
+	nostl::Vector<std::uint8_t> checkable_; ///< 0 if a slot can't be checked
+	nostl::HashMap<Recipe const *, std::uint32_t> slotOf_; ///< slot of Recipes
+
+	nostl::Vector<std::uint32_t> word_; ///< pool: index of nonzero words
+	nostl::Vector<std::uint64_t> mask_; ///< pool: nonzero words
+	nostl::Vector<std::uint32_t> needName_; ///< pool: name bit of needs
+	nostl::Vector<std::uint64_t> needUnits_; ///< pool: units of needs
+	unsigned int stale_; ///< number of dead slots and of pool entries no
+						///< slot refers to
+
+	nostl::Vector<std::uint32_t> bits_; ///< term -> bit (NONE if it has none)
+	unsigned int names_; ///< number of bits handed out
+}; // class InventoryMatcher
+
+} // namespace banch
+
+#endif // BANCH_BANCH_INVENTORY_HXX
@@ -0,0 +1,201 @@
+#ifndef BANCH_BANCH_JOURNAL_HXX
+#define BANCH_BANCH_JOURNAL_HXX
+
+/// \file journal.hxx
+///
+/// \brief incremental saving: a snapshot of a RecipeBook and an append-only
+/// journal of the edits made since
+
+#include "banch/banch.hxx"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief magic bytes every journal file starts with
+static char const JOURNAL_MAGIC[4] = { 'B', 'N', 'C', 'J' };
+
+/// \brief version of the journal format written by this code
+static std::uint8_t const JOURNAL_VERSION = 1;
+
+
+/// \brief keeps a book saved as a snapshot plus a journal of edits
+///
+/// The snapshot at path is a book in the binary format, the journal at
+/// path + ".journal" starts with the size and a hash of the snapshot it
+/// follows, then the edits made since as records: a varint length, the
+/// payload and a 32 bit checksum of it. A payload is an operation byte and
+/// its arguments in the binary format (Recipes and Ingredients are counted
+/// from 1, like getNth() does):
+///
+/// - recipe added: the Recipe (it went to the end of the book)
+/// - recipe removed: number of the Recipe
+/// - ingredient added: number of the Recipe, the Ingredient (type tag first)
+/// - ingredient removed: number of the Recipe, number of the Ingredient
+///
+/// The journal observes the book and encodes every edit as it happens;
+/// commit() appends the records to the file in one write, so a save takes
+/// time proportional to the edits, not to the book. Once the journal grows
+/// bigger than the snapshot (and COMPACTION bytes), commit() compacts: the
+/// book is written into a new snapshot that replaces the old one, then the
+/// journal starts over. A cleared (or reloaded) book isn't journaled at all,
+/// its next commit() writes a snapshot right away.
+///
+/// open() recovers a book: it loads the snapshot and replays the journal if
+/// it follows that snapshot (a journal left behind by a compaction that was
+/// cut short is ignored, its edits are in the snapshot already). Replay stops
+/// at the first torn or damaged record, which is cut off the file.
+class Journal : public BookObserver {
+public:
+	/// \brief least journal size that triggers a compaction, in bytes
+	static std::uint64_t const COMPACTION = 1 << 20;
+
+
+	/// \brief constructor that attaches the journal to a book
+	///
+	/// \param book whose edits to journal (nothing is recorded until open())
+	explicit Journal(RecipeBook & book);
+
+	/// \brief recover the book from a snapshot and its journal, then start
+	/// journaling into them
+	///
+	/// \param path of the snapshot (a missing one is an empty book, a text
+	/// database is fine too, the first compaction turns it binary)
+	/// \param threads number of threads to parse a text snapshot with
+	///
+	/// \return false if the snapshot isn't a valid database or the journal
+	/// can't be written (nothing is journaled then)
+	bool open(std::string const & path, unsigned int threads = 1);
+
+	/// \brief append the edits made since the last commit to the journal
+	///
+	/// \return false if the journal or the snapshot couldn't be written (the
+	/// edits are kept for the next try)
+	bool commit();
+
+	/// \brief write the book into a new snapshot and empty the journal
+	///
+	/// \return false if the snapshot couldn't be written
+	bool compact();
+
+
+	/// \brief tell whether a journal is open
+	///
+	/// \return true if open() succeeded
+	inline bool isOpen() const { return this->fd_ != -1; }
+
+	/// \brief get the path of the snapshot
+	///
+	/// \return the path given to open()
+	inline std::string const & path() const { return this->path_; }
+
+	/// \brief get the number of edits not committed yet
+	///
+	/// \return number of records waiting
+	inline unsigned int pending() const { return this->pending_; }
+
+	/// \brief get the size of the journal file
+	///
+	/// \return bytes committed to the journal (header included)
+	inline std::uint64_t journalBytes() const { return this->journalBytes_; }
+
+
+	/// \brief record a new Recipe
+	///
+	/// \param recipe that was added
+	void recipeAdded(Recipe const & recipe);
+
+	/// \brief record the removal of a Recipe
+	///
+	/// \param recipe that is removed
+	void recipeRemoved(Recipe const & recipe);
+
+	/// \brief record a new Ingredient
+	///
+	/// \param recipe that was changed
+	/// \param ingredient that was added
+	void ingredientAdded(Recipe const & recipe, Ingredient const & ingredient);
+
+	/// \brief record the removal of an Ingredient
+	///
+	/// \param recipe that is changed
+	/// \param ingredient that is removed
+	void ingredientRemoved(Recipe const & recipe, Ingredient const & ingredient);
+
+	/// \brief drop the records, the next commit() writes a snapshot
+	void bookCleared();
+
+	/// \brief forget the book
+	void bookDestroyed();
+
+
+	/// \brief destructor (closes the journal and detaches from the book,
+	/// edits not committed are lost)
+	~Journal();
+
+
+private:
+	/// \brief the operations of the records
+	enum Operation : std::uint8_t {
+		RECIPE_ADDED = 1, ///< a Recipe follows
+		RECIPE_REMOVED = 2, ///< number of the Recipe follows
+		INGREDIENT_ADDED = 3, ///< number of the Recipe and an Ingredient
+		INGREDIENT_REMOVED = 4 ///< number of the Recipe and the Ingredient
+	};
+
+	/// \brief frame the payload written into record_ and queue it
+	void queue();
+
+	/// \brief apply the records of a journal file to the book
+	///
+	/// \param data address of first byte of the file
+	/// \param size number of bytes
+	/// \param snapshot size of the snapshot
+	/// \param hash of the snapshot
+	///
+	/// \return number of bytes of intact records (header included), 0 if
+	/// the journal doesn't follow the snapshot
+	std::uint64_t replay(char const * data, std::uint64_t size,
+							std::uint64_t snapshot, std::uint64_t hash);
+
+	/// \brief apply one record to the book
+	///
+	/// \param data address of first byte of the payload
+	/// \param size number of bytes
+	///
+	/// \return false if the payload doesn't make sense for the book (it is
+	/// left alone then)
+	bool apply(char const * data, std::uint64_t size);
+
+	/// \brief start a journal file that follows the snapshot afresh
+	///
+	/// \return false if it couldn't be written
+	bool restart();
+
+	/// \brief close the journal file
+	void close();
+
+private:
+	RecipeBook * book_; ///< the book (nullptr once it's gone)
+	std::string path_; ///< path of the snapshot
+	int fd_; ///< journal file, open for appending (-1 if none)
+	std::uint64_t snapshotBytes_; ///< size of the snapshot
+	std::uint64_t snapshotHash_; ///< hash of the snapshot
+	std::uint64_t journalBytes_; ///< size of the journal file
+	std::ostringstream record_; ///< payload of the record being encoded
+	std::ostringstream records_; ///< framed records not committed yet
+	unsigned int pending_; ///< number of records not committed yet
+	bool recording_; ///< false while the book isn't journaled
+	bool cleared_; ///< true if the book was cleared since the last commit
+}; // class Journal
+
+} // namespace banch
+
+#endif // BANCH_BANCH_JOURNAL_HXX
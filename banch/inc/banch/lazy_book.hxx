@@ -0,0 +1,177 @@
+#ifndef BANCH_BANCH_LAZY_BOOK_HXX
+#define BANCH_BANCH_LAZY_BOOK_HXX
+
+/// \file lazy_book.hxx
+///
+/// \brief a database file opened without loading it: Recipes are built when
+/// they are asked for
+
+#include "banch/banch.hxx"
+#include "banch/mapped_file.hxx"
+#include "nostl/hash_map.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief read-only view of a database file (text or binary) that builds
+/// Recipes on demand
+///
+/// open() maps the file and only indexes it: the name and the byte range of
+/// every Recipe record (a text record starts at a "startrecipe" line and ends
+/// with an "endrecipe" one). Listing and counting need nothing else. A
+/// Recipe is built from its record when getNth() or findByName() asks for it
+/// and stays in a cache of a bounded number of Recipes. When the cache is
+/// full, a Recipe that hasn't been asked for since the last sweep is evicted
+/// (the clock approximation of least recently used).
+///
+/// \note a Recipe handed out stays valid until capacity() other Recipes have
+/// been built since
+class LazyBook {
+public:
+	/// \brief default number of Recipes kept built
+	static unsigned int const DEFAULT_CAPACITY = 64;
+
+
+	/// \brief constructor
+	///
+	/// \param capacity most Recipes to keep built at the same time
+	explicit LazyBook(unsigned int capacity = DEFAULT_CAPACITY)
+		: capacity_(capacity == 0 ? 1 : capacity), hand_(0), binary_(false) {}
+
+	/// \brief map a database file and index its Recipes
+	///
+	/// \param path of the file (the format is detected)
+	///
+	/// \return false if the file couldn't be mapped or is not a valid
+	/// database (the book is left empty then)
+	bool open(char const * path);
+
+	/// \brief drop the Recipes and unmap the file
+	void close();
+
+
+	/// \brief tell how many Recipes there are in the file
+	///
+	/// \return number of records
+	inline unsigned int number_of_entries() const
+	{
+		return this->entries_.size();
+	}
+
+	/// \brief get the name of the n-th Recipe (without building it)
+	///
+	/// \param n number of the Recipe (1 is the first)
+	///
+	/// \return the name
+	inline std::string getName(unsigned int n) const
+	{
+		return std::string(this->entries_[n - 1].name,
+							this->entries_[n - 1].nameSize);
+	}
+
+	/// \brief get the n-th Recipe, building it if it's not in the cache
+	///
+	/// \param n number of the Recipe (1 is the first)
+	///
+	/// \return reference to the Recipe
+	Recipe & getNth(unsigned int n);
+
+	/// \brief find a Recipe by its name, building it if needed
+	///
+	/// \param name of the Recipe
+	///
+	/// \return pointer to the Recipe or nullptr if there is none (the first
+	/// one, if several have the same name)
+	Recipe * findByName(std::string const & name);
+
+	/// \brief find the number of a Recipe by its name (without building it)
+	///
+	/// \param name of the Recipe
+	///
+	/// \return number of the first Recipe of that name, 0 if there is none
+	unsigned int numberOf(std::string const & name) const;
+
+
+	/// \brief list the names of all Recipes (without building any)
+	///
+	/// \param os stream to print into
+	/// \param numbered if true, each name will be numbered
+	void list(std::ostream & os, bool numbered = false) const;
+
+	/// \brief get the number of Recipes built and cached
+	///
+	/// \return size of the cache
+	inline unsigned int cached() const { return this->cache_.size(); }
+
+	/// \brief get the most Recipes kept built
+	///
+	/// \return capacity of the cache
+	inline unsigned int capacity() const { return this->capacity_; }
+
+
+private:
+	/// \brief the index entry of a Recipe record (plain old data, there are
+	/// a lot of them)
+	struct Entry {
+		char const * name; ///< first character of the name (in the file)
+		unsigned int nameSize; ///< number of characters of the name
+		unsigned int sameHash; ///< next entry with the same name hash plus
+								///< one (0 ends)
+		char const * begin; ///< first byte of the record
+		char const * end; ///< past the last byte of the record
+		unsigned int slot; ///< slot in the cache plus one (0 if not built)
+	}; // struct Entry
+
+	/// \brief a built Recipe in the cache
+	struct Slot {
+		std::unique_ptr<Recipe> recipe; ///< the Recipe
+		unsigned int entry; ///< index of its Entry
+		bool referenced; ///< asked for since the hand last passed
+	}; // struct Slot
+
+	/// \brief index the records of a text file
+	///
+	/// \param begin address of first character
+	/// \param end address past the last character
+	void indexText(char const * begin, char const * end);
+
+	/// \brief index the records of a binary file
+	///
+	/// \param begin address of first byte
+	/// \param end address past the last byte
+	///
+	/// \return false if the file is not a valid binary book
+	bool indexBinary(char const * begin, char const * end);
+
+	/// \brief build the Recipe of a record
+	///
+	/// \param entry of the record
+	///
+	/// \return the Recipe (names are views into the file)
+	Recipe * build(Entry const & entry) const;
+
+private:
+	unsigned int capacity_; ///< most Recipes kept built
+	unsigned int hand_; ///< next cache slot the clock looks at
+	bool binary_; ///< true if the file is in the binary format
+	MappedFile file_; ///< the mapped file
+	nostl::Vector<Entry> entries_; ///< records in file order
+	nostl::HashMap<std::uint64_t, unsigned int> byHash_; ///< name hash -> 1st
+															///< entry with it
+															///< plus one
+	nostl::Vector<Slot> cache_; ///< built Recipes
+}; // class LazyBook
+
+} // namespace banch
+
+#endif // BANCH_BANCH_LAZY_BOOK_HXX
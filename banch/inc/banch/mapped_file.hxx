@@ -0,0 +1,255 @@
+#ifndef BANCH_BANCH_MAPPED_FILE_HXX
+#define BANCH_BANCH_MAPPED_FILE_HXX
+
+/// \file mapped_file.hxx
+///
+/// \brief read-only memory mapping of database files and a line scanner to
+/// parse them in place
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief a file mapped into memory, read-only
+///
+/// The pages are shared with the page cache, so loading a big database
+/// doesn't copy it into the heap. Strings parsed from the mapping can point
+/// right into it, as long as the MappedFile lives.
+class MappedFile {
+public:
+	/// \brief constructor w/o parameters (nothing mapped)
+	MappedFile() : data_(nullptr), size_(0), open_(false) {}
+
+	/// \brief map a file
+	///
+	/// \param path of the file to map
+	///
+	/// \return false if the file couldn't be opened or mapped
+	bool open(char const * path);
+
+	/// \brief unmap the file (if any)
+	void close();
+
+
+	/// \brief tell whether a file is mapped
+	///
+	/// \return true if open() succeeded
+	bool isOpen() const { return this->open_; }
+
+	/// \brief get address of the mapped bytes
+	///
+	/// \return address of the first byte (nullptr for an empty file)
+	char const * data() const { return this->data_; }
+
+	/// \brief get number of mapped bytes
+	///
+	/// \return size of the file
+	std::size_t size() const { return this->size_; }
+
+
+	/// \brief copy constructor (deleted, the mapping has a single owner)
+	MappedFile(MappedFile const &) = delete;
+
+	/// \brief copy assignment (deleted, the mapping has a single owner)
+	MappedFile & operator=(MappedFile const &) = delete;
+
+	/// \brief destructor (unmaps the file)
+	~MappedFile() { this->close(); }
+
+
+private:
+	char const * data_; ///< first mapped byte
+	std::size_t size_; ///< number of mapped bytes
+	bool open_; ///< true if a file is mapped
+}; // class MappedFile
+
+
+/// \brief splits a range of memory into lines, without copying
+///
+/// Lines are separated by '\n' (which isn't part of the line), just like
+/// std::getline does it; a missing newline at the end is fine.
+///
+/// Lines of the text format are short, so looking for every newline with a
+/// call of its own costs more than the looking. With SSE2 (or AVX2, if the
+/// compiler may use it) the scanner compares a block of BLOCK bytes at once
+/// and keeps the newlines found as a bit mask, which the following lines are
+/// cut from. The tail shorter than a block, and everything on other targets,
+/// goes through memchr.
+class LineScanner {
+public:
+	/// \brief number of bytes looked at at once (0 if memchr does it all)
+#if defined(__AVX2__)
+	static unsigned int const BLOCK = 32;
+#elif defined(__SSE2__)
+	static unsigned int const BLOCK = 16;
+#else
+	static unsigned int const BLOCK = 0;
+#endif
+
+
+	/// \brief constructor
+	///
+	/// \param begin address of first character
+	/// \param end address past the last character
+	LineScanner(char const * begin, char const * end)
+		: current_(begin), end_(end), block_(begin), base_(begin), mask_(0) {}
+
+	/// \brief get the next line
+	///
+	/// \param line set to the address of the first character of the line
+	/// \param size set to the number of characters in the line
+	///
+	/// \return false if there are no more lines
+	inline bool next(char const * & line, unsigned int & size);
+
+
+private:
+	/// \brief find the newline ending the current line
+	///
+	/// \return its address or nullptr if the last line has none
+	inline char const * findNewline();
+
+	/// \brief find the newlines in a block
+	///
+	/// \param block address of first of BLOCK bytes
+	///
+	/// \return mask with bit k set if block[k] is a newline
+	static inline std::uint32_t newlines(char const * block);
+
+private:
+	char const * current_; ///< start of the next line
+	char const * end_; ///< past the last character
+	char const * block_; ///< next block to look at
+	char const * base_; ///< block mask_ is about
+	std::uint32_t mask_; ///< newlines of that block not handed out yet
+}; // class LineScanner
+
+
+/// \brief parse a line as an unsigned number (like operator>> does)
+///
+/// Leading white space is skipped and a sign is taken (a negative number
+/// wraps around), values past UINT_MAX saturate to it and whatever follows
+/// the digits is ignored. Where operator>> would fail (no digits, too big a
+/// number), the value is the same as it stores, but parsing goes on.
+///
+/// \param line address of first character
+/// \param size number of characters
+///
+/// \return the number (0 if there are no digits)
+inline unsigned int parseUnsigned(char const * line, unsigned int size)
+{
+	unsigned int k = 0;
+	while (k < size && (line[k] == ' ' || line[k] == '\t' || line[k] == '\r' ||
+						line[k] == '\v' || line[k] == '\f'))
+	{
+		++k;
+	}
+	bool negative = k < size && line[k] == '-';
+	if (k < size && (line[k] == '-' || line[k] == '+'))
+	{
+		++k;
+	}
+
+	// one past the largest value stays put once it's reached
+	std::uint64_t const TOO_BIG = std::uint64_t(UINT_MAX) + 1;
+	std::uint64_t value = 0;
+	for (; k < size && line[k] >= '0' && line[k] <= '9'; ++k)
+	{
+		value = value * 10 + (line[k] - '0');
+		value = value > TOO_BIG ? TOO_BIG : value;
+	}
+
+	if (value == TOO_BIG)
+	{
+		return UINT_MAX;
+	}
+	return negative ? 0u - static_cast<unsigned int>(value) :
+						static_cast<unsigned int>(value);
+}
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+bool LineScanner::next(char const * & line, unsigned int & size)
+{
+	if (this->current_ == this->end_)
+	{
+		return false;
+	}
+
+	line = this->current_;
+	char const * newline = this->findNewline();
+	if (newline == nullptr)
+	{
+		size = this->end_ - this->current_;
+		this->current_ = this->end_;
+	}
+	else
+	{
+		size = newline - this->current_;
+		this->current_ = newline + 1;
+	}
+
+	return true;
+}
+
+char const * LineScanner::findNewline()
+{
+	// blocks, as long as there are whole ones
+	while (BLOCK != 0 && this->mask_ == 0 &&
+			static_cast<std::size_t>(this->end_ - this->block_) >= BLOCK)
+	{
+		this->base_ = this->block_;
+		this->mask_ = newlines(this->block_);
+		this->block_ += BLOCK;
+	}
+	if (this->mask_ != 0)
+	{
+		char const * newline = this->base_ + __builtin_ctz(this->mask_);
+		this->mask_ &= this->mask_ - 1;
+		return newline;
+	}
+
+	// the tail (the blocks before it had no newlines left)
+	char const * from = this->current_ < this->block_ ? this->block_
+														: this->current_;
+	return static_cast<char const *>(
+						std::memchr(from, '\n', this->end_ - from));
+}
+
+std::uint32_t LineScanner::newlines(char const * block)
+{
+#if defined(__AVX2__)
+	__m256i bytes = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(block));
+	return static_cast<std::uint32_t>(_mm256_movemask_epi8(
+							_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n'))));
+#elif defined(__SSE2__)
+	__m128i bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(block));
+	return static_cast<std::uint32_t>(_mm_movemask_epi8(
+							_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'))));
+#else
+	static_cast<void>(block);
+	return 0;
+#endif
+}
+
+} // namespace banch
+
+#endif // BANCH_BANCH_MAPPED_FILE_HXX
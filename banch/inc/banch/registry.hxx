@@ -0,0 +1,153 @@
+#ifndef BANCH_BANCH_REGISTRY_HXX
+#define BANCH_BANCH_REGISTRY_HXX
+
+/// \file registry.hxx
+///
+/// \brief registry of Ingredient kinds, used to dispatch deserialization
+
+#include "nostl/hash.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <cstring>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+class Ingredient;
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief factory of a registered Ingredient kind
+///
+/// \return a default constructed Ingredient (to be deserialized into)
+typedef Ingredient * (*IngredientFactory)();
+
+/// \brief the factory of a default constructible Ingredient kind
+///
+/// \tparam T the Ingredient kind
+///
+/// \return a new T
+template <typename T>
+Ingredient * makeIngredient() { return new T; }
+
+
+/// \brief maps the type tags of Ingredient kinds to factories
+///
+/// Every kind has a keyword (the line before its fields in the text format)
+/// and a tag byte (in the binary format). Binary tags index a 256 entry
+/// table. Keywords go into a hash table that is rebuilt on every add() with a
+/// seed that makes it collision free, so a lookup is one hash and one compare.
+///
+/// This is the extension point for new kinds: derive from Ingredient, write
+/// the keyword/tag in serialize()/serializeBinary() and register the kind
+/// (before loading anything, lookups aren't synchronized with add()).
+class IngredientRegistry {
+public:
+	/// \brief a registered Ingredient kind
+	struct Kind {
+		char const * keyword; ///< keyword in the text format
+		unsigned int keywordSize; ///< number of characters in keyword
+		std::uint8_t tag; ///< tag in the binary format
+		IngredientFactory factory; ///< creates an empty Ingredient
+	}; // struct Kind
+
+
+	/// \brief get the registry (the built-in kinds are registered already)
+	///
+	/// \return reference to the registry
+	static IngredientRegistry & instance();
+
+
+	/// \brief register an Ingredient kind
+	///
+	/// \param keyword in the text format (not copied, keep it alive)
+	/// \param tag in the binary format
+	/// \param factory that creates an empty Ingredient of the kind
+	///
+	/// \return false if the keyword or the tag is taken already
+	bool add(char const * keyword, std::uint8_t tag, IngredientFactory factory);
+
+	/// \brief find a kind by its text keyword
+	///
+	/// \param keyword address of first character
+	/// \param size number of characters
+	///
+	/// \return the kind or nullptr if there is none
+	inline Kind const * find(char const * keyword, unsigned int size) const;
+
+	/// \brief find a kind by its binary tag
+	///
+	/// \param tag to look up
+	///
+	/// \return the kind or nullptr if there is none
+	inline Kind const * find(std::uint8_t tag) const
+	{
+		return this->byTag_[tag] == NONE ? nullptr
+										: &this->kinds_[this->byTag_[tag]];
+	}
+
+	/// \brief get the number of registered kinds
+	///
+	/// \return number of kinds
+	inline unsigned int size() const { return this->kinds_.size(); }
+
+
+private:
+	/// \brief constructor w/o parameters (registers the built-in kinds)
+	IngredientRegistry();
+
+	/// \brief hash a keyword into the keyword table
+	///
+	/// \param keyword address of first character
+	/// \param size number of characters
+	/// \param seed of the hash
+	///
+	/// \return the hash
+	static inline std::uint64_t hash(char const *, unsigned int, std::uint64_t);
+
+	/// \brief rebuild the keyword table with a collision free seed
+	void rebuild();
+
+private:
+	/// \brief marks empty entries of the tables
+	static unsigned char const NONE = 0xff;
+
+	nostl::Vector<Kind> kinds_; ///< the registered kinds
+	nostl::Vector<unsigned char> byKeyword_; ///< keyword table (kind or NONE)
+	unsigned char byTag_[256]; ///< tag table (kind or NONE)
+	std::uint64_t seed_; ///< seed that makes byKeyword_ collision free
+}; // class IngredientRegistry
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+std::uint64_t IngredientRegistry::hash(char const * keyword, unsigned int size,
+										std::uint64_t seed)
+{
+	return nostl::mix(nostl::hashBytes(keyword, size) ^ seed);
+}
+
+IngredientRegistry::Kind const *
+IngredientRegistry::find(char const * keyword, unsigned int size) const
+{
+	unsigned char index = this->byKeyword_[
+		hash(keyword, size, this->seed_) & (this->byKeyword_.size() - 1)];
+	if (index == NONE)
+	{
+		return nullptr;
+	}
+
+	Kind const & kind = this->kinds_[index];
+	return size == kind.keywordSize &&
+			std::memcmp(keyword, kind.keyword, size) == 0 ? &kind : nullptr;
+}
+
+} // namespace banch
+
+#endif // BANCH_BANCH_REGISTRY_HXX
@@ -0,0 +1,120 @@
+#ifndef BANCH_BANCH_SIMILARITY_HXX
+#define BANCH_BANCH_SIMILARITY_HXX
+
+/// \file similarity.hxx
+///
+/// \brief near-duplicate Recipes by MinHash signatures and LSH banding
+
+#include "banch/banch.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <iostream>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief MinHash signature of the set of ingredient names of a Recipe
+///
+/// Every entry is the least hash of the names under a different hash
+/// function. Two sets agree on an entry with a probability equal to their
+/// Jaccard similarity (size of the intersection over size of the union), so
+/// the fraction of agreeing entries estimates it. Quantities don't count:
+/// "4 units of rum" and "5 units of rum" are the same element.
+struct MinHash {
+	/// \brief number of hash functions (entries of a signature)
+	static unsigned int const SIZE = 32;
+
+	/// \brief compute the signature of a Recipe
+	///
+	/// \param recipe whose ingredient names to hash (normalized like
+	/// IngredientIndex does, kinds without a name by their fingerprint)
+	///
+	/// \return the signature (all entries ~0 for a Recipe w/o ingredients)
+	static MinHash of(Recipe const & recipe);
+
+	/// \brief estimate the Jaccard similarity to another signature
+	///
+	/// \param rhs signature to compare with
+	///
+	/// \return fraction of the entries that are the same
+	inline double similarity(MinHash const & rhs) const;
+
+	std::uint64_t values[SIZE]; ///< least hash under every hash function
+}; // struct MinHash
+
+
+/// \brief clusters the Recipes of a book whose ingredients are nearly the same
+///
+/// Signatures are cut into BANDS bands of ROWS entries. Recipes whose
+/// signatures are the same in a band land in the same bucket of that band,
+/// so only they are compared; with a similarity of s that happens in at least
+/// one band with probability 1 - (1 - s^ROWS)^BANDS, which is about 0.2 at
+/// s = 0.4, 0.7 at s = 0.6 and 0.99 at s = 0.8. Candidates estimated to be
+/// at least as similar as the threshold are joined into clusters (union-find,
+/// so a cluster may be a chain of Recipes, each similar to the next). This
+/// takes time linear in the number of Recipes, unless a lot of them land in
+/// the same buckets without being similar.
+///
+/// Signatures are computed and bands bucketed on several threads.
+class NearDuplicateFinder {
+public:
+	/// \brief number of bands the signatures are cut into
+	static unsigned int const BANDS = 8;
+
+	/// \brief number of signature entries in a band
+	static unsigned int const ROWS = MinHash::SIZE / BANDS;
+
+
+	/// \brief constructor
+	///
+	/// \param threshold least estimated similarity of Recipes in a cluster
+	/// \param threads number of threads to work on
+	explicit NearDuplicateFinder(double threshold = 0.5, unsigned int threads = 1)
+		: threshold_(threshold), threads_(threads == 0 ? 1 : threads) {}
+
+	/// \brief find the clusters of near-duplicates in a book
+	///
+	/// \param book to look through (Recipes w/o ingredients are left out)
+	///
+	/// \return clusters of at least two Recipes each, Recipes in book order,
+	/// clusters in the order of their first Recipe
+	nostl::Vector<nostl::Vector<Recipe *> > clusters(RecipeBook & book) const;
+
+	/// \brief print the clusters of near-duplicates in a book
+	///
+	/// \param os stream to print into
+	/// \param book to look through
+	///
+	/// \return number of clusters
+	unsigned int report(std::ostream & os, RecipeBook & book) const;
+
+
+private:
+	double threshold_; ///< least similarity of Recipes in a cluster
+	unsigned int threads_; ///< number of threads to work on
+}; // class NearDuplicateFinder
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+double MinHash::similarity(MinHash const & rhs) const
+{
+	unsigned int same = 0;
+	for (unsigned int k = 0; k < SIZE; ++k)
+	{
+		same += this->values[k] == rhs.values[k];
+	}
+	return static_cast<double>(same) / SIZE;
+}
+
+} // namespace banch
+
+#endif // BANCH_BANCH_SIMILARITY_HXX
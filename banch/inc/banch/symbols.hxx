@@ -0,0 +1,137 @@
+#ifndef BANCH_BANCH_SYMBOLS_HXX
+#define BANCH_BANCH_SYMBOLS_HXX
+
+/// \file symbols.hxx
+///
+/// \brief interning of names: every distinct name is kept once
+
+#include "nostl/allocator.hxx"
+#include "nostl/cow_string.hxx"
+#include "nostl/hash_map.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief keeps every distinct name once and numbers them
+///
+/// A name interned gets an id (0, 1, ... in order of first appearance) and a
+/// view of the kept copy. The copies live in an Arena, so views stay valid
+/// until clear(): two views of the same name have the same address, which
+/// makes comparing them an integer compare.
+///
+/// Every name is also linked to its normalized form (lower case, single
+/// spaces), which is interned as well: names that only differ in case and
+/// spacing share the id of their normalized form. Normalizing takes a pass
+/// over the characters, so it's done once per name, when it's first seen.
+class SymbolTable {
+public:
+	/// \brief id of no name
+	static std::uint32_t const NONE = ~0u;
+
+
+	/// \brief constructor w/o parameters (no names yet)
+	SymbolTable() {}
+
+	/// \brief a SymbolTable can't be copied (views point into it)
+	SymbolTable(SymbolTable const &) = delete;
+
+	/// \brief a SymbolTable can't be copied (views point into it)
+	SymbolTable & operator=(SymbolTable const &) = delete;
+
+
+	/// \brief intern a name
+	///
+	/// \param data address of first character
+	/// \param size number of characters
+	///
+	/// \return id of the name (the one it had, if it was interned already)
+	std::uint32_t intern(char const * data, unsigned int size);
+
+	/// \brief intern a name
+	///
+	/// \param name to intern
+	///
+	/// \return id of the name
+	inline std::uint32_t intern(nostl::CowString const & name)
+	{
+		return this->intern(name.data(), name.size());
+	}
+
+	/// \brief look up the id of a name without interning it
+	///
+	/// \param data address of first character
+	/// \param size number of characters
+	///
+	/// \return the id or NONE if the name isn't interned
+	inline std::uint32_t find(char const * data, unsigned int size) const
+	{
+		std::uint32_t const * id =
+						this->ids_.find(nostl::CowString::view(data, size));
+		return id == nullptr ? NONE : *id;
+	}
+
+	/// \brief get the id of the normalized form of a name
+	///
+	/// \param id of the name
+	///
+	/// \return id of the normalized name (id itself if it's normalized)
+	inline std::uint32_t normalized(std::uint32_t id) const
+	{
+		return this->normalized_[id];
+	}
+
+	/// \brief get the kept copy of a name
+	///
+	/// \param id of the name
+	///
+	/// \return a view of it (valid until clear())
+	inline nostl::CowString const & name(std::uint32_t id) const
+	{
+		return this->names_[id];
+	}
+
+	/// \brief get the number of names interned
+	///
+	/// \return number of distinct names
+	inline unsigned int size() const { return this->names_.size(); }
+
+	/// \brief get the number of bytes the kept names take
+	///
+	/// \return bytes of characters
+	inline std::size_t bytes() const { return this->characters_.bytes(); }
+
+	/// \brief forget every name (views of them dangle afterwards)
+	void clear();
+
+
+	/// \brief normalize a name (lower case, single spaces)
+	///
+	/// \param data address of first character
+	/// \param size number of characters
+	///
+	/// \return the normalized name
+	static std::string normalize(char const * data, unsigned int size);
+
+
+private:
+	nostl::Arena characters_; ///< kept copies of the names
+	nostl::HashMap<nostl::CowString, std::uint32_t> ids_; ///< name -> id (keys
+															///< are views of
+															///< the copies)
+	nostl::Vector<nostl::CowString> names_; ///< id -> view of the copy
+	nostl::Vector<std::uint32_t> normalized_; ///< id -> id of the normalized
+												///< name
+}; // class SymbolTable
+
+} // namespace banch
+
+#endif // BANCH_BANCH_SYMBOLS_HXX
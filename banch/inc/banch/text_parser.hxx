@@ -0,0 +1,225 @@
+#ifndef BANCH_BANCH_TEXT_PARSER_HXX
+#define BANCH_BANCH_TEXT_PARSER_HXX
+
+/// \file text_parser.hxx
+///
+/// \brief push parser of the text format: Recipes stream past as events,
+/// nothing is built
+
+#include "banch/banch.hxx"
+#include "banch/mapped_file.hxx"
+#include "nostl/cow_string.hxx"
+#include "nostl/sink.hxx"
+#include "nostl/vector.hxx"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief receives the events of a text database, in file order
+///
+/// For every Recipe record: recipeStart(), then an event per Ingredient, then
+/// recipeEnd(). Names passed in are views that are valid during the call
+/// only (copy what has to outlive it). Every event does nothing by default.
+class TextHandler {
+public:
+	/// \brief a Recipe record starts
+	///
+	/// \param name of the Recipe
+	///
+	/// \return false to skip the record (no more events about it, not even
+	/// recipeEnd())
+	virtual bool recipeStart(nostl::CowString const &) { return true; }
+
+	/// \brief a Beverage of the current Recipe
+	///
+	/// \param name of the beverage
+	/// \param quanta the quantity expressed in units
+	virtual void beverage(nostl::CowString const &, unsigned int) {}
+
+	/// \brief an Extra of the current Recipe
+	///
+	/// \param text of the extra
+	virtual void extra(nostl::CowString const &) {}
+
+	/// \brief an Ingredient of a kind that isn't built in (see
+	/// IngredientRegistry), these are built to be read
+	///
+	/// \param ingredient the Ingredient (the handler may keep it)
+	virtual void ingredient(std::unique_ptr<Ingredient>) {}
+
+	/// \brief the current Recipe record ends
+	virtual void recipeEnd() {}
+
+	/// \brief virtual destructor
+	virtual ~TextHandler() {}
+}; // class TextHandler
+
+
+/// \brief push every record of text in memory to a handler
+///
+/// \param scanner to take the lines from
+/// \param handler to call
+void parseText(LineScanner & scanner, TextHandler & handler);
+
+/// \brief push every record of a text stream to a handler (one line is held
+/// in memory at a time)
+///
+/// \param is stream to read
+/// \param handler to call
+void parseText(std::istream & is, TextHandler & handler);
+
+
+/// \brief handler that writes the events back in the text format
+class TextWriter : public TextHandler {
+public:
+	/// \brief constructor
+	///
+	/// \param sink to write into (flush it when parsing is done)
+	explicit TextWriter(nostl::Sink & sink) : sink_(&sink), recipes_(0) {}
+
+	/// \brief write the start of a record
+	///
+	/// \param name of the Recipe
+	///
+	/// \return true
+	bool recipeStart(nostl::CowString const & name);
+
+	/// \brief write a Beverage
+	///
+	/// \param name of the beverage
+	/// \param quanta the quantity expressed in units
+	void beverage(nostl::CowString const & name, unsigned int quanta);
+
+	/// \brief write an Extra
+	///
+	/// \param text of the extra
+	void extra(nostl::CowString const & text);
+
+	/// \brief write an Ingredient of another kind
+	///
+	/// \param ingredient the Ingredient
+	void ingredient(std::unique_ptr<Ingredient> ingredient);
+
+	/// \brief write the end of a record
+	void recipeEnd();
+
+
+	/// \brief get the number of records written
+	///
+	/// \return number of recipeEnd() calls
+	inline unsigned int recipes() const { return this->recipes_; }
+
+
+private:
+	nostl::Sink * sink_; ///< where the text goes
+	unsigned int recipes_; ///< number of records written
+}; // class TextWriter
+
+
+/// \brief handler that passes the Recipes matching some criteria on to
+/// another handler
+///
+/// A Recipe matches if its name contains the name filter (if there is one),
+/// it has every required ingredient and none of the excluded ones.
+/// Ingredients are compared by their normalized names (see
+/// IngredientIndex::normalize()), Ingredients of other kinds than the built
+/// in ones don't match anything. Only the events of the current Recipe are
+/// held back until it's decided, so memory doesn't grow with the book.
+class RecipeFilter : public TextHandler {
+public:
+	/// \brief constructor
+	///
+	/// \param next handler to pass the matching Recipes to
+	explicit RecipeFilter(TextHandler & next)
+		: next_(&next), skipping_(false), passed_(0), dropped_(0) {}
+
+	/// \brief only pass Recipes whose name contains some text
+	///
+	/// \param text the name has to contain (empty to pass any name)
+	inline void nameContains(std::string const & text) { this->name_ = text; }
+
+	/// \brief only pass Recipes having an ingredient
+	///
+	/// \param name of the ingredient
+	void require(std::string const & name);
+
+	/// \brief only pass Recipes not having an ingredient
+	///
+	/// \param name of the ingredient
+	void exclude(std::string const & name);
+
+
+	/// \brief start holding back a Recipe, unless its name rules it out
+	///
+	/// \param name of the Recipe
+	///
+	/// \return false if the Recipe is skipped
+	bool recipeStart(nostl::CowString const & name);
+
+	/// \brief hold back a Beverage
+	///
+	/// \param name of the beverage
+	/// \param quanta the quantity expressed in units
+	void beverage(nostl::CowString const & name, unsigned int quanta);
+
+	/// \brief hold back an Extra
+	///
+	/// \param text of the extra
+	void extra(nostl::CowString const & text);
+
+	/// \brief hold back an Ingredient of another kind
+	///
+	/// \param ingredient the Ingredient
+	void ingredient(std::unique_ptr<Ingredient> ingredient);
+
+	/// \brief pass the Recipe on if it matches
+	void recipeEnd();
+
+
+	/// \brief get the number of Recipes passed on
+	///
+	/// \return number of matching Recipes
+	inline unsigned int passed() const { return this->passed_; }
+
+	/// \brief get the number of Recipes dropped
+	///
+	/// \return number of Recipes that didn't match
+	inline unsigned int dropped() const { return this->dropped_; }
+
+
+private:
+	/// \brief an Ingredient held back
+	struct Held {
+		IngredientValue value; ///< a built-in one (its name owned)
+		std::unique_ptr<Ingredient> other; ///< one of another kind (if set)
+	}; // struct Held
+
+	/// \brief note an ingredient name of the current Recipe
+	///
+	/// \param name of the ingredient
+	void see(nostl::CowString const & name);
+
+private:
+	TextHandler * next_; ///< where matching Recipes go
+	std::string name_; ///< text the names have to contain
+	nostl::Vector<std::string> required_; ///< normalized required names
+	nostl::Vector<std::string> excluded_; ///< normalized excluded names
+	nostl::Vector<bool> found_; ///< required names seen in the current one
+	bool skipping_; ///< an excluded name was seen in the current Recipe
+	std::string current_; ///< name of the current Recipe
+	nostl::Vector<Held> held_; ///< Ingredients of the current Recipe
+	unsigned int passed_; ///< number of Recipes passed on
+	unsigned int dropped_; ///< number of Recipes dropped
+}; // class RecipeFilter
+
+} // namespace banch
+
+#endif // BANCH_BANCH_TEXT_PARSER_HXX
@@ -5,41 +5,181 @@
 #include "banch/banch.hxx"
 #include "banch/interactiveFunctions.hxx"
 
+#include <atomic>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 /// \brief namespace for the banch project
 namespace banch {
 
+namespace {
+
+/// \brief check whether a scanned line is a given keyword
+///
+/// \param line address of first character
+/// \param size number of characters
+/// \param keyword null terminated keyword
+///
+/// \return true if the line is the keyword
+bool isKeyword(char const * line, unsigned int size, char const * keyword)
+{
+	return size == std::strlen(keyword) && std::memcmp(line, keyword, size) == 0;
+}
+
+/// \brief parse all the recipes a scanner finds into a batch
+///
+/// \param scanner to take the lines from
+/// \param batch to append the parsed recipes to
+/// \param arena to create the recipes in (nullptr for the heap)
+/// \param symbols to intern ingredient names into (in an arena)
+void parseRecipes(LineScanner & scanner, nostl::Vector<Recipe *> & batch,
+					nostl::Arena * arena, SymbolTable * symbols)
+{
+	char const * line;
+	unsigned int size;
+	while (scanner.next(line, size))
+	{
+		if (isKeyword(line, size, "startrecipe"))
+		{
+			Recipe * recipe = arena != nullptr ?
+						arena->create<Recipe>("", *arena, symbols) : new Recipe;
+			recipe->deserialize(scanner);
+			batch.push_back(recipe);
+		}
+	}
+}
+
+/// \brief find the first recipe record starting at or after some position
+///
+/// \param from position to start looking at (may be mid-line)
+/// \param end address past the last character
+///
+/// \return address of the "startrecipe" line or end if there is none
+///
+/// A record boundary is an "endrecipe" line followed by a "startrecipe" line,
+/// a lonely "startrecipe" could just as well be the name of a recipe.
+char const * findRecipeStart(char const * from, char const * end)
+{
+	// skip the (possibly cut) line we landed in
+	char const * newline = static_cast<char const *>(
+									std::memchr(from, '\n', end - from));
+	if (newline == nullptr)
+	{
+		return end;
+	}
+
+	LineScanner scanner(newline + 1, end);
+	char const * line;
+	unsigned int size;
+	bool ended = false; // previous line was "endrecipe"
+	while (scanner.next(line, size))
+	{
+		if (ended && isKeyword(line, size, "startrecipe"))
+		{
+			return line;
+		}
+		ended = isKeyword(line, size, "endrecipe");
+	}
+
+	return end;
+}
+
+} // namespace
+
+// class Ingredient //
+
+std::uint64_t Ingredient::fingerprint() const
+{
+	std::stringstream text;
+	this->serialize(text);
+	std::string const str = text.str();
+	return nostl::mix(nostl::hashBytes(str.data(), str.size()));
+}
+
+bool Ingredient::equals(Ingredient const & rhs) const
+{
+	std::stringstream lhsText;
+	std::stringstream rhsText;
+	this->serialize(lhsText);
+	rhs.serialize(rhsText);
+	return lhsText.str() == rhsText.str();
+}
+
 // class Recipe //
 
-void Recipe::remove(unsigned int const n)
+bool Recipe::operator==(Recipe const & rhs) const
 {
-	// assert that call is correct
-	assert(((n > 0) && (n <= this->number_of_ingredients())));
+	// different fingerprints settle almost every comparison
+	if (this->fingerprint() != rhs.fingerprint() ||
+			this->ingredients_.size() != rhs.ingredients_.size() ||
+			this->name_ != rhs.name_)
+	{
+		return false;
+	}
 
-	// get iterator to asked Ingredient
-	nostl::Set<Ingredient *>::Iterator i = this->ingredients_.begin();
-	for (unsigned int counter = 1; counter < n; counter++)
+	// pair every Ingredient up with an equal one not taken yet
+	nostl::Vector<Ingredient *> others;
+	for (Collection<Ingredient *>::Iterator i = rhs.ingredients_.begin();
+			i != rhs.ingredients_.end();
+			++i)
+	{
+		others.push_back(*i);
+	}
+	for (Collection<Ingredient *>::Iterator i = this->ingredients_.begin();
+			i != this->ingredients_.end();
+			++i)
 	{
-		++i;
+		unsigned int k = 0;
+		while (k < others.size() &&
+				(others[k] == nullptr || !(*i)->equals(*others[k])))
+		{
+			++k;
+		}
+		if (k == others.size())
+		{
+			return false;
+		}
+		others[k] = nullptr;
 	}
+	return true;
+}
+
+void Recipe::remove(unsigned int const n)
+{
+	// assert that call is correct
+	assert(((n > 0) && (n <= this->number_of_ingredients())));
 
-	// remove that Ingredient
-	this->remove(*i);
+	// remove the asked Ingredient (the Collection counts from 0)
+	this->remove(this->ingredients_.at(n - 1));
 }
 
 void Recipe::clear()
 {
-	// iterate though container and free memory
-	nostl::Set<Ingredient *>::Iterator i = this->ingredients_.begin();
-	while (i != this->ingredients_.end())
+	// observers have to see every removal on its own (from the back, so
+	// nothing has to shift)
+	while (this->book_ != nullptr && !this->book_->observers_.empty() &&
+			this->ingredients_.size() != 0)
+	{
+		this->remove(this->ingredients_.at(this->ingredients_.size() - 1));
+	}
+
+	// free memory, then forget all pointers at once (what's in an Arena goes
+	// along with it)
+	for (Collection<Ingredient *>::Iterator i = this->ingredients_.begin();
+			this->arena_ == nullptr && i != this->ingredients_.end();
+			++i)
 	{
-		// we need to set this, otherwise we would have the i iterator point to
-		// already freed locations
-		Ingredient * tmp = *(i++);
-		this->remove(tmp);
+		delete *i;
 	}
+	this->ingredients_.clear();
+	this->contents_ = 0;
 }
 
 
@@ -48,16 +188,16 @@ void Recipe::show(std::ostream & os, bool numbered) const
 	// if Recipe is empty, there's nothing to show
 	if (this->number_of_ingredients() == 0)
 	{
-		os << std::endl;
-		os << "Recipe: " << this->name_ << " is empty" << std::endl;
+		os << '\n';
+		os << "Recipe: " << this->name_ << " is empty" << '\n';
 		return;
 	}
 
 	unsigned int counter = 0; // only needed if numbered
-	os << std::endl;
-	os << "Recipe: " << this->name_ << std::endl;
+	os << '\n';
+	os << "Recipe: " << this->name_ << '\n';
 	printSep(os);
-	for (nostl::Set<Ingredient *>::Iterator i = this->ingredients_.begin();
+	for (Collection<Ingredient *>::Iterator i = this->ingredients_.begin();
 			i != this->ingredients_.end();
 			++i)
 	{
@@ -70,104 +210,284 @@ void Recipe::show(std::ostream & os, bool numbered) const
 	}
 }
 
-void Recipe::serialize(std::ostream & os) const
+void Recipe::serialize(nostl::Sink & sink) const
 {
 	// start of recipe record
-	os << "startrecipe" << std::endl;
+	sink << "startrecipe\n";
 
 	// name of recipe
-	os << this->name_ << std::endl;
+	sink << this->name_ << '\n';
 
 	// recipe ingredients
-	for (nostl::Set<Ingredient *>::Iterator i = this->ingredients_.begin();
+	for (Collection<Ingredient *>::Iterator i = this->ingredients_.begin();
 			i != this->ingredients_.end();
 			++i)
 	{
-		(*i)->serialize(os);
+		(*i)->serialize(sink);
 	}
 
 	// end of recipe record
-	os << "endrecipe" << std::endl;
+	sink << "endrecipe\n";
 }
 
 void Recipe::deserialize(std::istream & is)
 {
-	getline(is, this->name_);
+	if (this->arena_ != nullptr)
+	{
+		string name;
+		getline(is, name);
+		this->name_ = this->keep(name.data(), name.size());
+	}
+	else
+	{
+		getline(is, this->name_.mutate());
+	}
 
+	IngredientRegistry const & registry = IngredientRegistry::instance();
 	string currentLine;
-	while (getline(is, currentLine) && currentLine != string("endrecipe"))
+	while (getline(is, currentLine) && currentLine != "endrecipe")
+	{
+		IngredientRegistry::Kind const * kind =
+						registry.find(currentLine.data(), currentLine.size());
+		if (kind != nullptr)
+		{
+			Ingredient * ingredient = kind->factory();
+			ingredient->deserialize(is);
+			this->add(ingredient);
+		}
+	}
+}
+
+void Recipe::deserialize(LineScanner & scanner)
+{
+	char const * line;
+	unsigned int size;
+	if (!scanner.next(line, size))
 	{
-		if (currentLine == string("beverage"))
+		return;
+	}
+	this->name_ = this->keep(line, size);
+
+	IngredientRegistry const & registry = IngredientRegistry::instance();
+	while (scanner.next(line, size) && !isKeyword(line, size, "endrecipe"))
+	{
+		IngredientRegistry::Kind const * kind = registry.find(line, size);
+		if (kind != nullptr)
 		{
-			Beverage * beverage = new Beverage;
-			beverage->deserialize(is);
-			this->add(beverage);
+			Ingredient * ingredient = kind->factory();
+			ingredient->deserialize(scanner);
+			this->add(ingredient);
 		}
-		if (currentLine == string("extra"))
+	}
+}
+
+
+void Recipe::serializeBinary(BinaryWriter & writer) const
+{
+	writer.writeString(this->name_);
+	writer.writeVarint(this->number_of_ingredients());
+
+	for (Collection<Ingredient *>::Iterator i = this->ingredients_.begin();
+			i != this->ingredients_.end();
+			++i)
+	{
+		(*i)->serializeBinary(writer);
+	}
+}
+
+void Recipe::deserializeBinary(BinaryReader & reader)
+{
+	if (this->arena_ != nullptr)
+	{
+		nostl::CowString name;
+		reader.readString(name);
+		this->name_ = this->keep(name.data(), name.size());
+	}
+	else
+	{
+		reader.readString(this->name_);
+	}
+
+	IngredientRegistry const & registry = IngredientRegistry::instance();
+	std::uint64_t count = reader.readVarint();
+	for (std::uint64_t k = 0; k < count && reader.good(); ++k)
+	{
+		IngredientRegistry::Kind const * kind =
+										registry.find(reader.readByte());
+		if (kind == nullptr)
 		{
-			Extra * extra = new Extra;
-			extra->deserialize(is);
-			this->add(extra);
+			// unknown type tag, there's no way to skip it
+			reader.fail();
+			return;
 		}
+
+		Ingredient * ingredient = kind->factory();
+		ingredient->deserializeBinary(reader);
+		this->add(ingredient);
 	}
 }
 
 
 // class RecipeBook //
 
+RecipeBook::RecipeBook(Memory memory)
+{
+	if (memory == ARENA)
+	{
+		this->arenas_.push_back(std::unique_ptr<nostl::Arena>(new nostl::Arena));
+	}
+}
+
 void RecipeBook::clear()
 {
-	// iterate though container and free memory
-	nostl::Set<Recipe *>::Iterator i = this->recipes_.begin();
-	while (i != this->recipes_.end())
+	// observers drop everything at once
+	for (unsigned int k = 0; k < this->observers_.size(); ++k)
+	{
+		this->observers_[k]->bookCleared();
+	}
+
+	// free memory, then forget all pointers at once; in arena mode only the
+	// Recipes from the heap are deleted, the rest goes with the Arenas
+	Collection<Recipe *> const & deleted = this->inArena() ? this->heapRecipes_
+															: this->recipes_;
+	for (Collection<Recipe *>::Iterator i = deleted.begin();
+			i != deleted.end();
+			++i)
+	{
+		(*i)->book_ = nullptr;
+		delete *i;
+	}
+	this->heapRecipes_.clear();
+	this->recipes_.clear();
+	this->byName_.clear();
+	for (unsigned int k = 0; k < this->arenas_.size(); ++k)
 	{
-		// we need to set this, otherwise we would have the i iterator point to
-		// already freed locations
-		Recipe * tmp = *(i++);
-		this->remove(tmp);
+		this->arenas_[k]->release();
 	}
+	this->symbols_.clear();
+
+	// nothing points into the file anymore
+	this->mapping_.reset();
 }
 
-Recipe & RecipeBook::getNth(unsigned int n)
+nostl::Vector<Recipe *> RecipeBook::findDuplicates() const
 {
-	// assert correct call
-	assert((n > 0) && (n <= this->number_of_entries()));
+	// the Recipes kept so far, the ones sharing a fingerprint (without being
+	// equal) are chained through next; links are indices plus one, 0 ends
+	nostl::HashMap<std::uint64_t, unsigned int> latest;
+	nostl::Vector<Recipe *> kept;
+	nostl::Vector<unsigned int> next;
+
+	nostl::Vector<Recipe *> duplicates;
+	for (Collection<Recipe *>::Iterator i = this->recipes_.begin();
+			i != this->recipes_.end();
+			++i)
+	{
+		unsigned int & head = latest[(*i)->fingerprint()];
+		bool duplicate = false;
+		for (unsigned int k = head; k != 0 && !duplicate; k = next[k - 1])
+		{
+			duplicate = *kept[k - 1] == **i;
+		}
+
+		if (duplicate)
+		{
+			duplicates.push_back(*i);
+		}
+		else
+		{
+			next.push_back(head);
+			kept.push_back(*i);
+			head = kept.size();
+		}
+	}
+	return duplicates;
+}
+
+unsigned int RecipeBook::removeDuplicates()
+{
+	nostl::Vector<Recipe *> duplicates = this->findDuplicates();
+	for (unsigned int k = 0; k < duplicates.size(); ++k)
+	{
+		this->remove(duplicates[k]);
+	}
+	return duplicates.size();
+}
+
+void RecipeBook::detach(BookObserver * observer)
+{
+	for (unsigned int k = 0; k < this->observers_.size(); ++k)
+	{
+		if (this->observers_[k] == observer)
+		{
+			// order of notification doesn't matter
+			this->observers_[k] = this->observers_.back();
+			this->observers_.pop_back();
+			return;
+		}
+	}
+}
 
-	// find Recipe asked for
-	nostl::Set<Recipe *>::Iterator i = this->recipes_.begin();
-	for (unsigned int k = 1; k < n; ++k)
+void RecipeBook::unindex(Recipe * recipe)
+{
+	nostl::CowString key = nostl::CowString::view(recipe->name_.data(),
+													recipe->name_.size());
+	Recipe * const * indexed = this->byName_.find(key);
+	if (indexed == nullptr || *indexed != recipe)
+	{
+		return;
+	}
+
+	// the next Recipe of the same name (if any) takes over, its own name
+	// becomes the key as this one's is about to go away
+	this->byName_.remove(key);
+	for (Collection<Recipe *>::Iterator i = this->recipes_.begin();
+			i != this->recipes_.end();
+			++i)
 	{
-		++i;
+		if (*i != recipe && (*i)->name_ == recipe->name_)
+		{
+			this->byName_.insert(nostl::CowString::view((*i)->name_.data(),
+														(*i)->name_.size()),
+									*i);
+			return;
+		}
 	}
-	// i now points to chose Recipe
+}
+
+Recipe & RecipeBook::getNth(unsigned int n)
+{
+	// assert correct call
+	assert((n > 0) && (n <= this->number_of_entries()));
 
-	return **i;
+	// find Recipe asked for (the Collection counts from 0)
+	return *this->recipes_.at(n - 1);
 }
 
 void RecipeBook::list(std::ostream & os, bool numbered) const
 {
 	unsigned int counter = 0; // only needed if numbered
-	for (nostl::Set<Recipe *>::Iterator i = this->recipes_.begin();
+	for (Collection<Recipe *>::Iterator i = this->recipes_.begin();
 			i != this->recipes_.end();
 			++i)
 	{
-		os << std::endl;
+		os << '\n';
 		if (numbered)
 		{
 			os << "### " << ++counter << " ###";
 		}
 		(*i)->show(os);
-		os << std::endl;
+		os << '\n';
 	}
 }
 
-void RecipeBook::serialize(std::ostream & os) const
+void RecipeBook::serialize(nostl::Sink & sink) const
 {
-	for (nostl::Set<Recipe *>::Iterator i = this->recipes_.begin();
+	for (Collection<Recipe *>::Iterator i = this->recipes_.begin();
 			i != this->recipes_.end();
 			++i)
 	{
-		(*i)->serialize(os); 
+		(*i)->serialize(sink);
 	}
 }
 
@@ -182,11 +502,247 @@ void RecipeBook::deserialize(std::istream & is)
 	{
 		if (currentLine == "startrecipe")
 		{
-			Recipe * recipe = new Recipe;
+			Recipe * recipe = this->inArena() ?
+						this->arena()->create<Recipe>("", *this->arena(),
+														&this->symbols_) :
+						new Recipe;
 			recipe->deserialize(is);
 			this->add(recipe);
 		}
 	}
 }
 
+void RecipeBook::deserialize(LineScanner & scanner)
+{
+	// tabula rasa
+	this->clear();
+
+	// deserialize
+	nostl::Vector<Recipe *> batch;
+	parseRecipes(scanner, batch, this->arena(), &this->symbols_);
+	for (unsigned int k = 0; k < batch.size(); ++k)
+	{
+		this->add(batch[k]);
+	}
+}
+
+void RecipeBook::deserialize(char const * begin, char const * end,
+								unsigned int threads)
+{
+	if (threads <= 1 || begin == end)
+	{
+		LineScanner scanner(begin, end);
+		this->deserialize(scanner);
+		return;
+	}
+
+	// tabula rasa
+	this->clear();
+
+	// a few chunks per thread, so that one slow chunk doesn't stall the rest
+	unsigned int chunks = threads * 4;
+	nostl::Vector<char const *> bounds;
+	bounds.push_back(begin);
+	for (unsigned int k = 1; k < chunks; ++k)
+	{
+		char const * bound = findRecipeStart(
+								begin + (end - begin) / chunks * k, end);
+		bounds.push_back(bound < bounds.back() ? bounds.back() : bound);
+	}
+	bounds.push_back(end);
+
+	// an Arena per chunk in arena mode, as Arenas aren't thread-safe; the
+	// same goes for SymbolTables, so names are interned per chunk first and
+	// into the book's table when the batches are merged
+	nostl::Vector<std::unique_ptr<SymbolTable> > symbols;
+	while (this->inArena() && this->arenas_.size() < chunks)
+	{
+		this->arenas_.push_back(std::unique_ptr<nostl::Arena>(new nostl::Arena));
+	}
+	while (this->inArena() && symbols.size() < chunks)
+	{
+		symbols.push_back(std::unique_ptr<SymbolTable>(new SymbolTable));
+	}
+
+	// workers take the next unparsed chunk until there are none left
+	nostl::Vector<nostl::Vector<Recipe *> > batches(chunks);
+	std::atomic<unsigned int> next(0);
+	auto work = [&]()
+	{
+		for (unsigned int k = next++; k < chunks; k = next++)
+		{
+			LineScanner scanner(bounds[k], bounds[k + 1]);
+			parseRecipes(scanner, batches[k],
+							this->inArena() ? this->arenas_[k].get() : nullptr,
+							this->inArena() ? symbols[k].get() : nullptr);
+		}
+	};
+
+	nostl::Vector<std::thread> workers;
+	for (unsigned int k = 1; k < threads; ++k)
+	{
+		workers.emplace_back(work);
+	}
+	work();
+	for (unsigned int k = 0; k < workers.size(); ++k)
+	{
+		workers[k].join();
+	}
+
+	// merge in original order (the chunks' tables aren't needed afterwards)
+	for (unsigned int k = 0; k < chunks; ++k)
+	{
+		for (unsigned int i = 0; i < batches[k].size(); ++i)
+		{
+			this->add(batches[k][i]);
+		}
+	}
+}
+
+bool RecipeBook::load(char const * path, unsigned int threads)
+{
+	std::unique_ptr<MappedFile> mapping(new MappedFile);
+	if (!mapping->open(path))
+	{
+		this->clear();
+		return false;
+	}
+
+	char const * begin = mapping->data();
+	char const * end = begin + mapping->size();
+
+	// both deserializers start with a clear(), dropping the old mapping
+	if (mapping->size() >= sizeof(BINARY_MAGIC) &&
+			std::memcmp(begin, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0)
+	{
+		BinaryReader reader(begin, end, true);
+		if (!this->deserializeBinary(reader))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		this->deserialize(begin, end, threads);
+	}
+
+	// keep the file mapped for as long as the Recipe names point into it (in
+	// arena mode they were copied, ingredient names are interned anyway)
+	if (!this->inArena())
+	{
+		this->mapping_ = std::move(mapping);
+	}
+
+	return true;
+}
+
+bool RecipeBook::save(char const * path, bool binary) const
+{
+	// write the new file next to the old one, then swap them
+	std::string temporary = std::string(path) + ".tmp";
+	int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd == -1)
+	{
+		return false;
+	}
+
+	// serialize into the file, flushing once at the end
+	bool written;
+	{
+		nostl::Sink sink(fd);
+		if (binary)
+		{
+			this->serializeBinary(sink);
+		}
+		else
+		{
+			this->serialize(sink);
+		}
+		sink.flush();
+		written = sink.good();
+	}
+	if (::fsync(fd) == -1 || ::close(fd) == -1 || !written ||
+			std::rename(temporary.c_str(), path) != 0)
+	{
+		std::remove(temporary.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+void RecipeBook::serializeBinary(std::ostream & os) const
+{
+	nostl::Sink sink(os);
+	this->serializeBinary(sink);
+}
+
+void RecipeBook::serializeBinary(nostl::Sink & sink) const
+{
+	BinaryWriter writer(sink);
+
+	// header
+	writer.writeBytes(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+	writer.writeByte(BINARY_VERSION);
+	writer.writeVarint(this->number_of_entries());
+
+	// recipes
+	for (Collection<Recipe *>::Iterator i = this->recipes_.begin();
+			i != this->recipes_.end();
+			++i)
+	{
+		(*i)->serializeBinary(writer);
+	}
+}
+
+bool RecipeBook::deserializeBinary(std::istream & is)
+{
+	// slurp the whole stream, parsing from memory is way faster
+	string data;
+	char buffer[1 << 16];
+	while (is.read(buffer, sizeof(buffer)) || is.gcount() != 0)
+	{
+		data.append(buffer, is.gcount());
+	}
+
+	BinaryReader reader(data.data(), data.data() + data.size());
+	return this->deserializeBinary(reader);
+}
+
+bool RecipeBook::deserializeBinary(BinaryReader & reader)
+{
+	// tabula rasa
+	this->clear();
+
+	// header
+	char const * magic = reader.readBytes(sizeof(BINARY_MAGIC));
+	if (magic == nullptr ||
+			string(magic, sizeof(BINARY_MAGIC)) !=
+				string(BINARY_MAGIC, sizeof(BINARY_MAGIC)) ||
+			reader.readByte() != BINARY_VERSION)
+	{
+		return false;
+	}
+
+	// recipes
+	std::uint64_t count = reader.readVarint();
+	for (std::uint64_t k = 0; k < count && reader.good(); ++k)
+	{
+		Recipe * recipe = this->inArena() ?
+					this->arena()->create<Recipe>("", *this->arena(),
+													&this->symbols_) :
+					new Recipe;
+		recipe->deserializeBinary(reader);
+		this->add(recipe);
+	}
+
+	if (!reader.good())
+	{
+		this->clear();
+		return false;
+	}
+
+	return true;
+}
+
 } // namespace banch
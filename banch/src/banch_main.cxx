@@ -1,12 +1,164 @@
 #include "banch/banch.hxx"
+#include "banch/completion.hxx"
+#include "banch/fuzzy.hxx"
+#include "banch/ingredient_index.hxx"
+#include "banch/inventory.hxx"
+#include "banch/similarity.hxx"
+#include "banch/text_parser.hxx"
 #include "menu/menu.hxx"
 #include "banch/interactiveFunctions.hxx"
 
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <functional>
+#include <thread>
 
 int main(int argc, char ** argv)
 {
-	banch::RecipeBook myBook;
+	// number of threads to load text databases with (-j N or --threads N)
+	unsigned int threads = std::thread::hardware_concurrency();
+	// database to report the near-duplicates of, instead of the menu
+	char const * report = nullptr;
+	// snapshot to recover the book from and journal the edits into
+	char const * journalPath = nullptr;
+	// text database to stream through a filter ("-" is stdin) and where to
+	// write what passes ("-" is stdout), instead of the menu
+	char const * filterIn = nullptr;
+	char const * filterOut = nullptr;
+	std::string filterName;
+	nostl::Vector<std::string> filterWith;
+	nostl::Vector<std::string> filterWithout;
+	for (int k = 1; k < argc; ++k)
+	{
+		if ((std::strcmp(argv[k], "-j") == 0 ||
+				std::strcmp(argv[k], "--threads") == 0) && k + 1 < argc)
+		{
+			threads = std::strtoul(argv[++k], nullptr, 10);
+		}
+		else if (std::strcmp(argv[k], "--near-duplicates") == 0 && k + 1 < argc)
+		{
+			report = argv[++k];
+		}
+		else if (std::strcmp(argv[k], "--journal") == 0 && k + 1 < argc)
+		{
+			journalPath = argv[++k];
+		}
+		else if (std::strcmp(argv[k], "--filter") == 0 && k + 2 < argc)
+		{
+			filterIn = argv[++k];
+			filterOut = argv[++k];
+		}
+		else if (std::strcmp(argv[k], "--name") == 0 && k + 1 < argc)
+		{
+			filterName = argv[++k];
+		}
+		else if (std::strcmp(argv[k], "--with") == 0 && k + 1 < argc)
+		{
+			filterWith.push_back(argv[++k]);
+		}
+		else if (std::strcmp(argv[k], "--without") == 0 && k + 1 < argc)
+		{
+			filterWithout.push_back(argv[++k]);
+		}
+		else
+		{
+			std::cerr << "usage: " << argv[0] << " [-j|--threads N]" \
+						" [--near-duplicates FILE] [--journal FILE]" \
+						" [--filter IN OUT [--name TEXT] [--with INGREDIENT]..." \
+						" [--without INGREDIENT]...]" << std::endl;
+			return 1;
+		}
+	}
+	if (threads == 0)
+	{
+		threads = 1;
+	}
+
+	// batch mode: load, report and quit
+	if (report != nullptr)
+	{
+		banch::RecipeBook book;
+		if (!book.load(report, threads))
+		{
+			std::cerr << "Could not load database from " << report << std::endl;
+			return 1;
+		}
+		banch::NearDuplicateFinder(0.5, threads).report(std::cout, book);
+		return 0;
+	}
+
+	// batch mode: stream the recipes through the filter, nothing is loaded
+	if (filterIn != nullptr)
+	{
+		std::ofstream ofs;
+		if (std::strcmp(filterOut, "-") != 0)
+		{
+			ofs.open(filterOut);
+			if (!ofs)
+			{
+				std::cerr << "Could not write " << filterOut << std::endl;
+				return 1;
+			}
+		}
+		nostl::Sink sink(ofs.is_open() ? ofs : std::cout);
+		banch::TextWriter writer(sink);
+		banch::RecipeFilter filter(writer);
+		filter.nameContains(filterName);
+		for (unsigned int k = 0; k < filterWith.size(); ++k)
+		{
+			filter.require(filterWith[k]);
+		}
+		for (unsigned int k = 0; k < filterWithout.size(); ++k)
+		{
+			filter.exclude(filterWithout[k]);
+		}
+
+		if (std::strcmp(filterIn, "-") == 0)
+		{
+			banch::parseText(std::cin, filter);
+		}
+		else
+		{
+			banch::MappedFile file;
+			if (!file.open(filterIn) ||
+					(file.size() >= sizeof(banch::BINARY_MAGIC) &&
+						std::memcmp(file.data(), banch::BINARY_MAGIC,
+									sizeof(banch::BINARY_MAGIC)) == 0))
+			{
+				std::cerr << "Could not read text database from " << filterIn
+							<< std::endl;
+				return 1;
+			}
+			banch::LineScanner scanner(file.data(), file.data() + file.size());
+			banch::parseText(scanner, filter);
+		}
+		sink.flush();
+		if (!sink.good())
+		{
+			std::cerr << "Could not write " << filterOut << std::endl;
+			return 1;
+		}
+		std::cerr << filter.passed() << " recipes kept, " << filter.dropped()
+					<< " dropped" << std::endl;
+		return 0;
+	}
+
+	// reloads and quitting release the book's arenas instead of deleting
+	// every recipe on its own
+	banch::RecipeBook myBook(banch::RecipeBook::ARENA);
+	banch::NameCompleter nameCompleter(myBook);
+	banch::IngredientIndex ingredientIndex(myBook);
+	banch::InventoryMatcher inventoryMatcher(myBook);
+	banch::FuzzyIndex fuzzyIndex(myBook);
+
+	// saving to the journaled file only appends the edits
+	banch::Journal journal(myBook);
+	if (journalPath != nullptr && !journal.open(journalPath, threads))
+	{
+		std::cerr << "Could not open journal of " << journalPath << std::endl;
+		return 1;
+	}
 
 	menu::Menu mainMenu(std::cout, std::cin);
 	mainMenu.add(menu::Option("list recipes",
@@ -28,16 +180,72 @@ int main(int argc, char ** argv)
 																	std::cout,
 																	std::cin,
 																	myBook))));
+	mainMenu.add(menu::Option("modify recipe by name",
+								std::function<void()>(
+										banch::Fmodify_recipe_by_name(std::cout,
+																		std::cin,
+																		myBook,
+																		nameCompleter))));
+	mainMenu.add(menu::Option("remove recipe by name",
+								std::function<void()>(
+										banch::Fremove_recipe_by_name(std::cout,
+																		std::cin,
+																		myBook,
+																		nameCompleter))));
+	mainMenu.add(menu::Option("remove duplicate recipes",
+								std::function<void()>(
+										banch::Fremove_duplicates(std::cout,
+																	std::cin,
+																	myBook))));
+	mainMenu.add(menu::Option("list near-duplicate recipes",
+								std::function<void()>(
+										banch::Fnear_duplicates(std::cout,
+																std::cin,
+																myBook,
+																threads))));
+	mainMenu.add(menu::Option("find recipes by ingredients",
+								std::function<void()>(banch::Ffind_recipes(
+															std::cout,
+															std::cin,
+															ingredientIndex))));
+	mainMenu.add(menu::Option("search recipes by name (typos are fine)",
+								std::function<void()>(banch::Ffuzzy_search(
+																std::cout,
+																std::cin,
+																fuzzyIndex))));
+	mainMenu.add(menu::Option("what can I make?",
+								std::function<void()>(banch::Fwhat_can_i_make(
+															std::cout,
+															std::cin,
+															inventoryMatcher))));
 	mainMenu.add(menu::Option("save database to file",
 								std::function<void()>(banch::Fsave_recipebook(
 																	std::cout,
 																	std::cin,
-																	myBook))));
+																	myBook,
+																	false,
+																	&journal))));
+	mainMenu.add(menu::Option("save database to binary file",
+								std::function<void()>(banch::Fsave_recipebook(
+																	std::cout,
+																	std::cin,
+																	myBook,
+																	true,
+																	&journal))));
 	mainMenu.add(menu::Option("load database from file",
 								std::function<void()>(banch::Fload_recipebook(
 																	std::cout,
 																	std::cin,
-																	myBook))));
+																	myBook,
+																	threads))));
+	mainMenu.add(menu::Option("browse database file without loading it",
+								std::function<void()>(banch::Fbrowse_recipebook(
+																	std::cout,
+																	std::cin))));
+	mainMenu.add(menu::Option("convert database file (text <-> binary)",
+								std::function<void()>(banch::Fconvert_recipebook(
+																	std::cout,
+																	std::cin))));
 
 	std::cout << "Welcome to banch ʘ‿ʘ" << std::endl;
 	std::cout << " Please select one from the options below" << std::endl;
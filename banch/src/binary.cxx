@@ -0,0 +1,162 @@
+/// \file binary.cxx
+///
+/// \brief function definitions of binary.hxx
+
+#include "banch/binary.hxx"
+#include "banch/banch.hxx"
+
+#include <cstring>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+// class BinaryWriter //
+
+void BinaryWriter::writeVarint(std::uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		this->writeByte(static_cast<std::uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	this->writeByte(static_cast<std::uint8_t>(value));
+}
+
+void BinaryWriter::writeUint32(std::uint32_t value)
+{
+	this->writeByte(static_cast<std::uint8_t>(value));
+	this->writeByte(static_cast<std::uint8_t>(value >> 8));
+	this->writeByte(static_cast<std::uint8_t>(value >> 16));
+	this->writeByte(static_cast<std::uint8_t>(value >> 24));
+}
+
+void BinaryWriter::writeString(char const * data, std::uint64_t size)
+{
+	this->writeVarint(size);
+	this->writeBytes(data, size);
+}
+
+
+// class BinaryReader //
+
+std::uint64_t BinaryReader::readVarint()
+{
+	std::uint64_t value = 0;
+	for (unsigned int shift = 0; shift < 64; shift += 7)
+	{
+		std::uint8_t byte = this->readByte();
+		value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return value;
+		}
+	}
+
+	// more than 10 bytes can't be a valid varint
+	this->good_ = false;
+	return 0;
+}
+
+std::uint32_t BinaryReader::readUint32()
+{
+	char const * bytes = this->readBytes(4);
+	if (bytes == nullptr)
+	{
+		return 0;
+	}
+
+	return static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[0]))
+		| static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[1])) << 8
+		| static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[2])) << 16
+		| static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[3])) << 24;
+}
+
+void BinaryReader::readString(std::string & str)
+{
+	std::uint64_t size = this->readVarint();
+	char const * bytes = this->readBytes(size);
+	if (bytes == nullptr)
+	{
+		str.clear();
+		return;
+	}
+
+	str.assign(bytes, size);
+}
+
+void BinaryReader::readString(nostl::CowString & str)
+{
+	if (!this->borrow_)
+	{
+		this->readString(str.mutate());
+		return;
+	}
+
+	std::uint64_t size = this->readVarint();
+	char const * bytes = this->readBytes(size);
+	if (bytes == nullptr)
+	{
+		str = std::string();
+		return;
+	}
+
+	str = nostl::CowString::view(bytes, size);
+}
+
+char const * BinaryReader::readBytes(std::uint64_t size)
+{
+	if (!this->good_ ||
+			size > static_cast<std::uint64_t>(this->end_ - this->current_))
+	{
+		this->good_ = false;
+		return nullptr;
+	}
+
+	char const * bytes = this->current_;
+	this->current_ += size;
+	return bytes;
+}
+
+
+///////////////
+// FUNCTIONS //
+///////////////
+
+bool isBinaryFormat(std::istream & is)
+{
+	std::istream::pos_type start = is.tellg();
+
+	char magic[sizeof(BINARY_MAGIC)];
+	is.read(magic, sizeof(magic));
+	bool binary = is.gcount() == sizeof(magic) &&
+					std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+
+	// rewind, even if we hit the end of a short file
+	is.clear();
+	is.seekg(start);
+
+	return binary;
+}
+
+bool convertFormat(std::istream & is, std::ostream & os)
+{
+	RecipeBook book;
+
+	if (isBinaryFormat(is))
+	{
+		if (!book.deserializeBinary(is))
+		{
+			return false;
+		}
+		book.serialize(os);
+	}
+	else
+	{
+		book.deserialize(is);
+		book.serializeBinary(os);
+	}
+
+	return true;
+}
+
+} // namespace banch
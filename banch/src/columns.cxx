@@ -0,0 +1,226 @@
+/// \file columns.cxx
+///
+/// \brief function definitions of columns.hxx
+
+#include "banch/columns.hxx"
+
+#include <cassert>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+// class ColumnarBook //
+
+std::uint8_t const ColumnarBook::DEAD;
+std::uint8_t const ColumnarBook::OTHER;
+std::uint32_t const ColumnarBook::NO_NAME;
+
+ColumnarBook::ColumnarBook(RecipeBook & book)
+	: book_(&book), dead_(0)
+{
+	this->rebuild();
+	book.attach(this);
+}
+
+void ColumnarBook::rebuild()
+{
+	this->reset();
+	if (this->book_ == nullptr)
+	{
+		return;
+	}
+
+	for (unsigned int k = 1; k <= this->book_->number_of_entries(); ++k)
+	{
+		this->append(this->book_->getNth(k));
+	}
+}
+
+unsigned long long ColumnarBook::totalQuanta(std::string const & name) const
+{
+	std::uint32_t id = this->nameId(name);
+	if (id == NO_NAME)
+	{
+		return 0;
+	}
+
+	// Extras and dead rows have zero quanta, so the name alone decides
+	std::uint32_t const * names = this->name_.begin();
+	std::uint32_t const * quanta = this->quanta_.begin();
+	unsigned long long total = 0;
+	for (unsigned int k = 0; k < this->rows(); ++k)
+	{
+		total += names[k] == id ? quanta[k] : 0;
+	}
+	return total;
+}
+
+unsigned int ColumnarBook::countRecipesWithMoreThan(unsigned int n) const
+{
+	std::uint32_t const * counts = this->count_.begin();
+	unsigned int count = 0;
+	for (unsigned int k = 0; k < this->recipeSlots(); ++k)
+	{
+		count += counts[k] > n;
+	}
+	return count;
+}
+
+unsigned int ColumnarBook::countKind(std::uint8_t kind) const
+{
+	std::uint8_t const * kinds = this->kind_.begin();
+	unsigned int count = 0;
+	for (unsigned int k = 0; k < this->rows(); ++k)
+	{
+		count += kinds[k] == kind;
+	}
+	return count;
+}
+
+void ColumnarBook::recipeAdded(Recipe const & recipe)
+{
+	// a rebuild picks the new Recipe up from the book already
+	if (!this->compactIfSparse())
+	{
+		this->append(recipe);
+	}
+}
+
+void ColumnarBook::recipeRemoved(Recipe const & recipe)
+{
+	std::uint32_t const * slot = this->slotOf_.find(&recipe);
+	if (slot == nullptr)
+	{
+		return;
+	}
+
+	for (unsigned int k = 1; k <= recipe.number_of_ingredients(); ++k)
+	{
+		this->kill(recipe.getNth(k));
+	}
+	this->count_[*slot] = 0;
+	this->slotOf_.remove(&recipe);
+}
+
+void ColumnarBook::ingredientAdded(Recipe const & recipe,
+									Ingredient const & ingredient)
+{
+	// a rebuild picks the new Ingredient up from the book already
+	if (this->compactIfSparse())
+	{
+		return;
+	}
+
+	std::uint32_t const * slot = this->slotOf_.find(&recipe);
+	if (slot != nullptr)
+	{
+		++this->count_[*slot];
+		this->append(*slot, ingredient);
+	}
+}
+
+void ColumnarBook::ingredientRemoved(Recipe const & recipe,
+									Ingredient const & ingredient)
+{
+	std::uint32_t const * slot = this->slotOf_.find(&recipe);
+	if (slot != nullptr)
+	{
+		--this->count_[*slot];
+		this->kill(ingredient);
+	}
+}
+
+void ColumnarBook::bookCleared()
+{
+	this->reset();
+}
+
+void ColumnarBook::bookDestroyed()
+{
+	this->reset();
+	this->book_ = nullptr;
+}
+
+ColumnarBook::~ColumnarBook()
+{
+	if (this->book_ != nullptr)
+	{
+		this->book_->detach(this);
+	}
+}
+
+void ColumnarBook::reset()
+{
+	this->kind_.clear();
+	this->name_.clear();
+	this->quanta_.clear();
+	this->recipe_.clear();
+	this->count_.clear();
+	this->dead_ = 0;
+	this->rowOf_.clear();
+	this->slotOf_.clear();
+}
+
+void ColumnarBook::append(Recipe const & recipe)
+{
+	std::uint32_t slot = this->count_.size();
+	this->count_.push_back(recipe.number_of_ingredients());
+	this->slotOf_.insert(&recipe, slot);
+
+	for (unsigned int k = 1; k <= recipe.number_of_ingredients(); ++k)
+	{
+		this->append(slot, recipe.getNth(k));
+	}
+}
+
+void ColumnarBook::append(std::uint32_t slot, Ingredient const & ingredient)
+{
+	IngredientValue value;
+	if (ingredient.toValue(value))
+	{
+		// the book interns the names of the built-in kinds, others are looked
+		// up (NO_NAME if they aren't there)
+		std::uint32_t name = value.symbol;
+		if (name == SymbolTable::NONE)
+		{
+			name = this->book_->symbols().find(value.name.data(),
+												value.name.size());
+		}
+		this->kind_.push_back(value.kind);
+		this->name_.push_back(name);
+		this->quanta_.push_back(value.quanta);
+	}
+	else
+	{
+		this->kind_.push_back(OTHER);
+		this->name_.push_back(NO_NAME);
+		this->quanta_.push_back(0);
+	}
+	this->recipe_.push_back(slot);
+	this->rowOf_.insert(&ingredient, this->kind_.size() - 1);
+}
+
+void ColumnarBook::kill(Ingredient const & ingredient)
+{
+	std::uint32_t const * row = this->rowOf_.find(&ingredient);
+	assert(row != nullptr);
+
+	this->kind_[*row] = DEAD;
+	this->name_[*row] = NO_NAME;
+	this->quanta_[*row] = 0;
+	++this->dead_;
+	this->rowOf_.remove(&ingredient);
+}
+
+bool ColumnarBook::compactIfSparse()
+{
+	if (this->dead_ <= 64 || this->dead_ <= this->rows() - this->dead_)
+	{
+		return false;
+	}
+
+	this->rebuild();
+	return true;
+}
+
+} // namespace banch
@@ -0,0 +1,289 @@
+/// \file compact.cxx
+///
+/// \brief function definitions of compact.hxx
+
+#include "banch/compact.hxx"
+#include "banch/interactiveFunctions.hxx"
+
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+namespace {
+
+/// \brief visitor that prints ingredients like Ingredient::print does
+struct PrintVisitor {
+	std::ostream & os; ///< stream to print into
+	bool numbered; ///< true if every ingredient gets a number
+	unsigned int counter; ///< number of ingredients printed so far
+
+	/// \brief print the bullet in front of an ingredient
+	void bullet()
+	{
+		if (this->numbered)
+		{
+			this->os << ++this->counter << ')' << ' ';
+		}
+		this->os << '-' << ' ';
+	}
+
+	/// \brief print a beverage
+	///
+	/// \param name of the beverage
+	/// \param quanta the quantity expressed in units
+	void beverage(nostl::CowString const & name, unsigned int quanta)
+	{
+		this->bullet();
+		this->os << quanta << " units of " << name << '\n';
+	}
+
+	/// \brief print an extra
+	///
+	/// \param text of the extra
+	void extra(nostl::CowString const & text)
+	{
+		this->bullet();
+		this->os << text << '\n';
+	}
+}; // struct PrintVisitor
+
+/// \brief visitor that serializes ingredients like Ingredient::serialize does
+struct TextVisitor {
+	nostl::Sink & sink; ///< sink to serialize into
+
+	/// \brief serialize a beverage
+	///
+	/// \param name of the beverage
+	/// \param quanta the quantity expressed in units
+	void beverage(nostl::CowString const & name, unsigned int quanta)
+	{
+		this->sink << "beverage\n" << name << '\n' << quanta << '\n';
+	}
+
+	/// \brief serialize an extra
+	///
+	/// \param text of the extra
+	void extra(nostl::CowString const & text)
+	{
+		this->sink << "extra\n" << text << '\n';
+	}
+}; // struct TextVisitor
+
+/// \brief visitor that serializes ingredients like
+/// Ingredient::serializeBinary does
+struct BinaryVisitor {
+	BinaryWriter & writer; ///< writer to serialize into
+
+	/// \brief serialize a beverage
+	///
+	/// \param name of the beverage
+	/// \param quanta the quantity expressed in units
+	void beverage(nostl::CowString const & name, unsigned int quanta)
+	{
+		this->writer.writeByte(BINARY_TAG_BEVERAGE);
+		this->writer.writeString(name);
+		this->writer.writeUint32(quanta);
+	}
+
+	/// \brief serialize an extra
+	///
+	/// \param text of the extra
+	void extra(nostl::CowString const & text)
+	{
+		this->writer.writeByte(BINARY_TAG_EXTRA);
+		this->writer.writeString(text);
+	}
+}; // struct BinaryVisitor
+
+} // namespace
+
+// class CompactRecipe //
+
+CompactRecipe::CompactRecipe(Recipe const & recipe) : name_(recipe.getName())
+{
+	this->ingredients_.reserve(recipe.number_of_ingredients());
+
+	IngredientValue value;
+	for (unsigned int n = 1; n <= recipe.number_of_ingredients(); ++n)
+	{
+		if (recipe.getNth(n).toValue(value))
+		{
+			this->ingredients_.push_back(std::move(value));
+		}
+	}
+}
+
+Recipe * CompactRecipe::toRecipe() const
+{
+	Recipe * recipe = new Recipe(this->name_);
+	for (unsigned int k = 0; k < this->ingredients_.size(); ++k)
+	{
+		recipe->add(this->ingredients_[k].toIngredient());
+	}
+	return recipe;
+}
+
+void CompactRecipe::remove(unsigned int n)
+{
+	// assert that call is correct
+	assert(((n > 0) && (n <= this->number_of_ingredients())));
+
+	// close the gap
+	for (unsigned int k = n; k < this->ingredients_.size(); ++k)
+	{
+		this->ingredients_[k - 1] = std::move(this->ingredients_[k]);
+	}
+	this->ingredients_.pop_back();
+}
+
+
+void CompactRecipe::show(std::ostream & os, bool numbered) const
+{
+	// if Recipe is empty, there's nothing to show
+	if (this->number_of_ingredients() == 0)
+	{
+		os << '\n';
+		os << "Recipe: " << this->name_ << " is empty" << '\n';
+		return;
+	}
+
+	os << '\n';
+	os << "Recipe: " << this->name_ << '\n';
+	printSep(os);
+	PrintVisitor visitor = { os, numbered, 0 };
+	this->visit(visitor);
+}
+
+void CompactRecipe::serialize(nostl::Sink & sink) const
+{
+	// start of recipe record
+	sink << "startrecipe\n";
+
+	// name of recipe
+	sink << this->name_ << '\n';
+
+	// recipe ingredients
+	TextVisitor visitor = { sink };
+	this->visit(visitor);
+
+	// end of recipe record
+	sink << "endrecipe\n";
+}
+
+void CompactRecipe::deserialize(std::istream & is)
+{
+	getline(is, this->name_.mutate());
+
+	IngredientRegistry const & registry = IngredientRegistry::instance();
+	string currentLine;
+	while (getline(is, currentLine) && currentLine != "endrecipe")
+	{
+		IngredientRegistry::Kind const * kind =
+						registry.find(currentLine.data(), currentLine.size());
+		if (kind == nullptr)
+		{
+			continue;
+		}
+
+		if (kind->tag == BINARY_TAG_BEVERAGE)
+		{
+			IngredientValue value = IngredientValue::beverage("", 0);
+			getline(is, value.name.mutate());
+			(is >> value.quanta).ignore(1); // flush the rest of the line
+			this->ingredients_.push_back(std::move(value));
+		}
+		else if (kind->tag == BINARY_TAG_EXTRA)
+		{
+			IngredientValue value = IngredientValue::extra("");
+			getline(is, value.name.mutate());
+			this->ingredients_.push_back(std::move(value));
+		}
+	}
+}
+
+void CompactRecipe::deserialize(LineScanner & scanner)
+{
+	char const * line;
+	unsigned int size;
+	if (!scanner.next(line, size))
+	{
+		return;
+	}
+	this->name_ = nostl::CowString::view(line, size);
+
+	IngredientRegistry const & registry = IngredientRegistry::instance();
+	while (scanner.next(line, size) &&
+			!(size == 9 && std::memcmp(line, "endrecipe", 9) == 0))
+	{
+		IngredientRegistry::Kind const * kind = registry.find(line, size);
+		if (kind == nullptr)
+		{
+			continue;
+		}
+
+		if (kind->tag == BINARY_TAG_BEVERAGE)
+		{
+			IngredientValue value = IngredientValue::beverage("", 0);
+			if (scanner.next(line, size))
+			{
+				value.name = nostl::CowString::view(line, size);
+			}
+			if (scanner.next(line, size))
+			{
+				value.quanta = parseUnsigned(line, size);
+			}
+			this->ingredients_.push_back(std::move(value));
+		}
+		else if (kind->tag == BINARY_TAG_EXTRA)
+		{
+			IngredientValue value = IngredientValue::extra("");
+			if (scanner.next(line, size))
+			{
+				value.name = nostl::CowString::view(line, size);
+			}
+			this->ingredients_.push_back(std::move(value));
+		}
+	}
+}
+
+
+void CompactRecipe::serializeBinary(BinaryWriter & writer) const
+{
+	writer.writeString(this->name_);
+	writer.writeVarint(this->number_of_ingredients());
+
+	BinaryVisitor visitor = { writer };
+	this->visit(visitor);
+}
+
+void CompactRecipe::deserializeBinary(BinaryReader & reader)
+{
+	reader.readString(this->name_);
+
+	std::uint64_t count = reader.readVarint();
+	for (std::uint64_t k = 0; k < count && reader.good(); ++k)
+	{
+		IngredientValue value = IngredientValue::extra("");
+		switch (reader.readByte())
+		{
+			case BINARY_TAG_BEVERAGE:
+				value.kind = IngredientValue::BEVERAGE;
+				reader.readString(value.name);
+				value.quanta = reader.readUint32();
+				break;
+			case BINARY_TAG_EXTRA:
+				reader.readString(value.name);
+				break;
+			default:
+				// no value representation, and no way to skip it
+				reader.fail();
+				return;
+		}
+		this->ingredients_.push_back(std::move(value));
+	}
+}
+
+} // namespace banch
@@ -0,0 +1,106 @@
+/// \file completion.cxx
+///
+/// \brief function definitions of completion.hxx
+
+#include "banch/completion.hxx"
+
+#include <cctype>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+// class NameCompleter //
+
+NameCompleter::NameCompleter(RecipeBook & book) : book_(&book)
+{
+	this->rebuild();
+	book.attach(this);
+}
+
+void NameCompleter::rebuild()
+{
+	this->trie_.clear();
+	if (this->book_ == nullptr)
+	{
+		return;
+	}
+
+	for (unsigned int k = 1; k <= this->book_->number_of_entries(); ++k)
+	{
+		this->recipeAdded(this->book_->getNth(k));
+	}
+}
+
+nostl::Vector<Recipe *> NameCompleter::complete(std::string const & prefix,
+												unsigned int k) const
+{
+	// no more names than Recipes are needed
+	nostl::Vector<nostl::RadixTrie<nostl::Vector<Recipe *> >::Entry> names =
+									this->trie_.complete(fold(prefix), k);
+
+	nostl::Vector<Recipe *> recipes;
+	for (unsigned int j = 0; j < names.size() && recipes.size() < k; ++j)
+	{
+		nostl::Vector<Recipe *> const & same = *names[j].value;
+		for (unsigned int i = 0; i < same.size() && recipes.size() < k; ++i)
+		{
+			recipes.push_back(same[i]);
+		}
+	}
+	return recipes;
+}
+
+void NameCompleter::recipeAdded(Recipe const & recipe)
+{
+	// the book hands out its Recipes as const, but they're its own to edit
+	this->trie_[fold(recipe.getName())].push_back(const_cast<Recipe *>(&recipe));
+}
+
+void NameCompleter::recipeRemoved(Recipe const & recipe)
+{
+	std::string key = fold(recipe.getName());
+	nostl::Vector<Recipe *> * same = this->trie_.find(key);
+	for (unsigned int k = 0; same != nullptr && k < same->size(); ++k)
+	{
+		if ((*same)[k] == &recipe)
+		{
+			same->erase(k);
+			break;
+		}
+	}
+	if (same != nullptr && same->empty())
+	{
+		this->trie_.remove(key);
+	}
+}
+
+void NameCompleter::bookCleared()
+{
+	this->trie_.clear();
+}
+
+void NameCompleter::bookDestroyed()
+{
+	this->trie_.clear();
+	this->book_ = nullptr;
+}
+
+NameCompleter::~NameCompleter()
+{
+	if (this->book_ != nullptr)
+	{
+		this->book_->detach(this);
+	}
+}
+
+std::string NameCompleter::fold(std::string const & name)
+{
+	std::string folded(name);
+	for (unsigned int k = 0; k < folded.size(); ++k)
+	{
+		folded[k] = std::tolower(static_cast<unsigned char>(folded[k]));
+	}
+	return folded;
+}
+
+} // namespace banch
@@ -0,0 +1,442 @@
+/// \file fuzzy.cxx
+///
+/// \brief function definitions of fuzzy.hxx
+
+#include "banch/fuzzy.hxx"
+#include "banch/ingredient_index.hxx"
+#include "nostl/sort.hxx"
+
+/// \brief namespace for the banch project
+namespace banch {
+
+namespace {
+
+/// \brief a term close enough to the query, for one Recipe
+struct Candidate {
+	std::uint32_t recipe; ///< id of the Recipe
+	std::uint32_t term; ///< id of the term
+	bool ingredient; ///< true if the term is an ingredient's name
+	unsigned int distance; ///< edit distance of the term from the query
+}; // struct Candidate
+
+/// \brief orders Candidates: closest first, Recipe names before ingredient
+/// names, then by Recipe id
+struct Closer {
+	/// \brief compare two Candidates
+	///
+	/// \param lhs left hand side
+	/// \param rhs right hand side
+	///
+	/// \return true if lhs goes first
+	bool operator()(Candidate const & lhs, Candidate const & rhs) const
+	{
+		if (lhs.distance != rhs.distance)
+		{
+			return lhs.distance < rhs.distance;
+		}
+		if (lhs.ingredient != rhs.ingredient)
+		{
+			return rhs.ingredient;
+		}
+		return lhs.recipe < rhs.recipe;
+	}
+}; // struct Closer
+
+/// \brief collect the distinct trigrams of a term
+///
+/// \param term normalized name
+/// \param trigrams to write the trigrams into (cleared first)
+void trigramsOf(std::string const & term,
+				nostl::Vector<std::uint32_t> & trigrams)
+{
+	trigrams.clear();
+	std::string padded = "  " + term + " ";
+	for (unsigned int k = 0; k + 3 <= padded.size(); ++k)
+	{
+		std::uint32_t trigram =
+				static_cast<unsigned char>(padded[k]) << 16 |
+				static_cast<unsigned char>(padded[k + 1]) << 8 |
+				static_cast<unsigned char>(padded[k + 2]);
+
+		unsigned int j = 0;
+		while (j < trigrams.size() && trigrams[j] != trigram)
+		{
+			++j;
+		}
+		if (j == trigrams.size())
+		{
+			trigrams.push_back(trigram);
+		}
+	}
+}
+
+/// \brief get the normalized name of an ingredient
+///
+/// \param ingredient to get the name of
+/// \param name to write the normalized name into
+///
+/// \return false if the ingredient has no name (no value representation)
+bool nameOf(Ingredient const & ingredient, std::string & name)
+{
+	IngredientValue value;
+	if (!ingredient.toValue(value))
+	{
+		return false;
+	}
+	name = IngredientIndex::normalize(value.name.data(), value.name.size());
+	return true;
+}
+
+} // namespace
+
+///////////////
+// FUNCTIONS //
+///////////////
+
+unsigned int editDistance(std::string const & lhs, std::string const & rhs,
+							unsigned int bound)
+{
+	unsigned int const FAR = bound + 1; // anything beyond the bound
+	unsigned int n = lhs.size(), m = rhs.size();
+	if ((n > m ? n - m : m - n) > bound)
+	{
+		return FAR;
+	}
+
+	// two rows of the table, only the band |i - j| <= bound is computed
+	nostl::Vector<unsigned int> previous(m + 2, FAR);
+	nostl::Vector<unsigned int> current(m + 2, FAR);
+	for (unsigned int j = 0; j <= m && j <= bound; ++j)
+	{
+		previous[j] = j;
+	}
+
+	for (unsigned int i = 1; i <= n; ++i)
+	{
+		unsigned int low = i > bound ? i - bound : 1;
+		unsigned int high = i + bound < m ? i + bound : m;
+		current[low - 1] = low == 1 ? i : FAR;
+
+		unsigned int best = current[low - 1];
+		for (unsigned int j = low; j <= high; ++j)
+		{
+			unsigned int cell = previous[j - 1] + (lhs[i - 1] != rhs[j - 1]);
+			cell = previous[j] + 1 < cell ? previous[j] + 1 : cell;
+			cell = current[j - 1] + 1 < cell ? current[j - 1] + 1 : cell;
+			current[j] = cell < FAR ? cell : FAR;
+			best = current[j] < best ? current[j] : best;
+		}
+		current[high + 1] = FAR; // the next row reads one past the band
+
+		// the distance can't get back under the bound
+		if (best > bound)
+		{
+			return FAR;
+		}
+		std::swap(previous, current);
+	}
+
+	return previous[m] < FAR ? previous[m] : FAR;
+}
+
+// class FuzzyIndex //
+
+FuzzyIndex::FuzzyIndex(RecipeBook & book)
+	: book_(&book), removed_(0), deadTerms_(0)
+{
+	this->rebuild();
+	book.attach(this);
+}
+
+void FuzzyIndex::rebuild()
+{
+	this->reset();
+	if (this->book_ == nullptr)
+	{
+		return;
+	}
+
+	for (unsigned int k = 1; k <= this->book_->number_of_entries(); ++k)
+	{
+		this->recipeAdded(this->book_->getNth(k));
+	}
+}
+
+nostl::Vector<FuzzyMatch> FuzzyIndex::search(std::string const & query,
+												unsigned int maxDistance,
+												unsigned int limit) const
+{
+	nostl::Vector<FuzzyMatch> matches;
+	std::string term = IngredientIndex::normalize(query);
+	if (term.empty())
+	{
+		return matches;
+	}
+
+	// count the trigrams every term shares with the query
+	nostl::Vector<std::uint32_t> trigrams;
+	trigramsOf(term, trigrams);
+	nostl::HashMap<std::uint32_t, unsigned int> shared;
+	for (unsigned int k = 0; k < trigrams.size(); ++k)
+	{
+		nostl::Vector<std::uint32_t> const * terms =
+											this->postings_.find(trigrams[k]);
+		for (unsigned int j = 0; terms != nullptr && j < terms->size(); ++j)
+		{
+			++shared[(*terms)[j]];
+		}
+	}
+
+	// with too short a query every term is a candidate
+	nostl::Vector<std::uint32_t> candidates;
+	if (trigrams.size() > 3 * maxDistance)
+	{
+		unsigned int needed = trigrams.size() - 3 * maxDistance;
+		for (nostl::HashMap<std::uint32_t, unsigned int>::Iterator i =
+															shared.begin();
+				i != shared.end();
+				++i)
+		{
+			if (i.value() >= needed)
+			{
+				candidates.push_back(i.key());
+			}
+		}
+	}
+	else
+	{
+		for (unsigned int k = 0; k < this->text_.size(); ++k)
+		{
+			candidates.push_back(k);
+		}
+	}
+
+	// verify the candidates, keeping the closest term of each Recipe
+	nostl::Vector<Candidate> found;
+	nostl::HashMap<std::uint32_t, unsigned int> foundOf; // Recipe -> found
+	for (unsigned int k = 0; k < candidates.size(); ++k)
+	{
+		std::uint32_t id = candidates[k];
+		nostl::Vector<Use> const & uses = this->uses_[id];
+		if (uses.empty())
+		{
+			continue;
+		}
+
+		unsigned int distance = editDistance(term, this->text_[id], maxDistance);
+		if (distance > maxDistance)
+		{
+			continue;
+		}
+
+		for (unsigned int j = 0; j < uses.size(); ++j)
+		{
+			Candidate candidate = { uses[j].recipe, id, uses[j].ingredient,
+									distance };
+			unsigned int const * at = foundOf.find(candidate.recipe);
+			if (at == nullptr)
+			{
+				foundOf.insert(candidate.recipe, found.size());
+				found.push_back(candidate);
+			}
+			else if (Closer()(candidate, found[*at]))
+			{
+				found[*at] = candidate;
+			}
+		}
+	}
+
+	nostl::sort(found.begin(), found.end(), Closer());
+	for (unsigned int k = 0; k < found.size() && k < limit; ++k)
+	{
+		FuzzyMatch match = { this->recipes_[found[k].recipe],
+								this->text_[found[k].term],
+								found[k].ingredient,
+								found[k].distance };
+		matches.push_back(match);
+	}
+	return matches;
+}
+
+void FuzzyIndex::recipeAdded(Recipe const & recipe)
+{
+	// a rebuild picks the new Recipe up from the book already
+	if (this->compactIfSparse())
+	{
+		return;
+	}
+
+	// the book hands out its Recipes as const, but they're its own to edit
+	std::uint32_t id = this->recipes_.size();
+	this->recipes_.push_back(const_cast<Recipe *>(&recipe));
+	this->ids_.insert(&recipe, id);
+
+	this->use(id, IngredientIndex::normalize(recipe.getName()), false);
+	std::string name;
+	for (unsigned int k = 1; k <= recipe.number_of_ingredients(); ++k)
+	{
+		if (nameOf(recipe.getNth(k), name))
+		{
+			this->use(id, name, true);
+		}
+	}
+}
+
+void FuzzyIndex::recipeRemoved(Recipe const & recipe)
+{
+	std::uint32_t const * found = this->ids_.find(&recipe);
+	if (found == nullptr)
+	{
+		return;
+	}
+	std::uint32_t id = *found;
+
+	this->unuse(id, IngredientIndex::normalize(recipe.getName()), false);
+	std::string name;
+	for (unsigned int k = 1; k <= recipe.number_of_ingredients(); ++k)
+	{
+		if (nameOf(recipe.getNth(k), name))
+		{
+			this->unuse(id, name, true);
+		}
+	}
+
+	this->recipes_[id] = nullptr;
+	++this->removed_;
+	this->ids_.remove(&recipe);
+}
+
+void FuzzyIndex::ingredientAdded(Recipe const & recipe,
+									Ingredient const & ingredient)
+{
+	std::uint32_t const * id = this->ids_.find(&recipe);
+	std::string name;
+	if (id != nullptr && nameOf(ingredient, name))
+	{
+		this->use(*id, name, true);
+	}
+}
+
+void FuzzyIndex::ingredientRemoved(Recipe const & recipe,
+									Ingredient const & ingredient)
+{
+	std::uint32_t const * id = this->ids_.find(&recipe);
+	std::string name;
+	if (id != nullptr && nameOf(ingredient, name))
+	{
+		this->unuse(*id, name, true);
+	}
+}
+
+void FuzzyIndex::bookCleared()
+{
+	this->reset();
+}
+
+void FuzzyIndex::bookDestroyed()
+{
+	this->reset();
+	this->book_ = nullptr;
+}
+
+FuzzyIndex::~FuzzyIndex()
+{
+	if (this->book_ != nullptr)
+	{
+		this->book_->detach(this);
+	}
+}
+
+void FuzzyIndex::reset()
+{
+	this->recipes_.clear();
+	this->removed_ = 0;
+	this->ids_.clear();
+	this->text_.clear();
+	this->uses_.clear();
+	this->deadTerms_ = 0;
+	this->terms_.clear();
+	this->postings_.clear();
+}
+
+void FuzzyIndex::use(std::uint32_t recipe, std::string const & term,
+						bool ingredient)
+{
+	std::uint32_t id = this->intern(term);
+	if (this->uses_[id].empty())
+	{
+		--this->deadTerms_;
+	}
+
+	Use use = { recipe, ingredient };
+	this->uses_[id].push_back(use);
+}
+
+void FuzzyIndex::unuse(std::uint32_t recipe, std::string const & term,
+						bool ingredient)
+{
+	std::uint32_t const * id =
+			this->terms_.find(nostl::CowString::view(term.data(), term.size()));
+	if (id == nullptr)
+	{
+		return;
+	}
+
+	// the order of the uses doesn't matter
+	nostl::Vector<Use> & uses = this->uses_[*id];
+	for (unsigned int k = 0; k < uses.size(); ++k)
+	{
+		if (uses[k].recipe == recipe && uses[k].ingredient == ingredient)
+		{
+			uses[k] = uses.back();
+			uses.pop_back();
+			break;
+		}
+	}
+	if (uses.empty())
+	{
+		++this->deadTerms_;
+	}
+}
+
+std::uint32_t FuzzyIndex::intern(std::string const & term)
+{
+	std::uint32_t const * found =
+			this->terms_.find(nostl::CowString::view(term.data(), term.size()));
+	if (found != nullptr)
+	{
+		return *found;
+	}
+
+	// new terms are dead until used
+	std::uint32_t id = this->text_.size();
+	this->text_.push_back(term);
+	this->uses_.push_back(nostl::Vector<Use>());
+	++this->deadTerms_;
+	this->terms_.insert(nostl::CowString(term), id);
+
+	nostl::Vector<std::uint32_t> trigrams;
+	trigramsOf(term, trigrams);
+	for (unsigned int k = 0; k < trigrams.size(); ++k)
+	{
+		this->postings_[trigrams[k]].push_back(id);
+	}
+	return id;
+}
+
+bool FuzzyIndex::compactIfSparse()
+{
+	unsigned int liveRecipes = this->recipes_.size() - this->removed_;
+	bool deadTerms = this->deadTerms_ > 1024 &&
+						this->deadTerms_ > this->text_.size() - this->deadTerms_;
+	bool removed = this->removed_ > 64 && this->removed_ > liveRecipes;
+	if (!deadTerms && !removed)
+	{
+		return false;
+	}
+
+	this->rebuild();
+	return true;
+}
+
+} // namespace banch
@@ -0,0 +1,432 @@
+/// \file ingredient_index.cxx
+///
+/// \brief function definitions of ingredient_index.hxx
+
+#include "banch/ingredient_index.hxx"
+
+#include <sstream>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+namespace {
+
+/// \brief sorted ids in both of two sorted lists
+///
+/// \param lhs sorted ids
+/// \param rhs sorted ids
+///
+/// \return the intersection
+nostl::Vector<std::uint32_t> intersect(nostl::Vector<std::uint32_t> const & lhs,
+									nostl::Vector<std::uint32_t> const & rhs)
+{
+	nostl::Vector<std::uint32_t> result;
+	unsigned int i = 0, j = 0;
+	while (i < lhs.size() && j < rhs.size())
+	{
+		if (lhs[i] < rhs[j])
+		{
+			++i;
+		}
+		else if (rhs[j] < lhs[i])
+		{
+			++j;
+		}
+		else
+		{
+			result.push_back(lhs[i]);
+			++i;
+			++j;
+		}
+	}
+	return result;
+}
+
+/// \brief sorted ids in either of two sorted lists
+///
+/// \param lhs sorted ids
+/// \param rhs sorted ids
+///
+/// \return the union
+nostl::Vector<std::uint32_t> unite(nostl::Vector<std::uint32_t> const & lhs,
+								nostl::Vector<std::uint32_t> const & rhs)
+{
+	nostl::Vector<std::uint32_t> result;
+	result.reserve(lhs.size() + rhs.size());
+	unsigned int i = 0, j = 0;
+	while (i < lhs.size() || j < rhs.size())
+	{
+		if (j == rhs.size() || (i < lhs.size() && lhs[i] < rhs[j]))
+		{
+			result.push_back(lhs[i++]);
+		}
+		else if (i == lhs.size() || rhs[j] < lhs[i])
+		{
+			result.push_back(rhs[j++]);
+		}
+		else
+		{
+			result.push_back(lhs[i]);
+			++i;
+			++j;
+		}
+	}
+	return result;
+}
+
+/// \brief sorted ids in the first but not in the second of two sorted lists
+///
+/// \param lhs sorted ids
+/// \param rhs sorted ids
+///
+/// \return the difference
+nostl::Vector<std::uint32_t> subtract(nostl::Vector<std::uint32_t> const & lhs,
+									nostl::Vector<std::uint32_t> const & rhs)
+{
+	nostl::Vector<std::uint32_t> result;
+	unsigned int j = 0;
+	for (unsigned int i = 0; i < lhs.size(); ++i)
+	{
+		while (j < rhs.size() && rhs[j] < lhs[i])
+		{
+			++j;
+		}
+		if (j == rhs.size() || rhs[j] != lhs[i])
+		{
+			result.push_back(lhs[i]);
+		}
+	}
+	return result;
+}
+
+/// \brief find the position of an id in a sorted list
+///
+/// \param ids sorted ids
+/// \param id to look for
+///
+/// \return index of the first id not less than the one looked for
+unsigned int lowerBound(nostl::Vector<std::uint32_t> const & ids,
+						std::uint32_t id)
+{
+	unsigned int first = 0, last = ids.size();
+	while (first < last)
+	{
+		unsigned int middle = first + (last - first) / 2;
+		if (ids[middle] < id)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+	return first;
+}
+
+} // namespace
+
+// class IngredientIndex //
+
+IngredientIndex::IngredientIndex(RecipeBook & book)
+	: book_(&book), removed_(0)
+{
+	this->rebuild();
+	book.attach(this);
+}
+
+void IngredientIndex::rebuild()
+{
+	this->reset();
+	if (this->book_ == nullptr)
+	{
+		return;
+	}
+
+	for (unsigned int k = 1; k <= this->book_->number_of_entries(); ++k)
+	{
+		this->index(this->book_->getNth(k));
+	}
+}
+
+std::uint32_t IngredientIndex::termOf(Ingredient const & ingredient,
+										SymbolTable const & symbols)
+{
+	IngredientValue value;
+	if (!ingredient.toValue(value))
+	{
+		return SymbolTable::NONE;
+	}
+
+	// the book interns the names of the built-in kinds, others are looked up
+	std::uint32_t symbol = value.symbol != SymbolTable::NONE ? value.symbol :
+							symbols.find(value.name.data(), value.name.size());
+	return symbol == SymbolTable::NONE ? symbol : symbols.normalized(symbol);
+}
+
+nostl::Vector<Recipe *>
+IngredientIndex::recipesWith(std::string const & ingredient) const
+{
+	nostl::Vector<Recipe *> result;
+	Postings const * ids = this->postings(ingredient);
+	for (unsigned int k = 0; ids != nullptr && k < ids->size(); ++k)
+	{
+		result.push_back(this->recipes_[(*ids)[k]]);
+	}
+	return result;
+}
+
+nostl::Vector<Recipe *> IngredientIndex::query(std::string const & query) const
+{
+	// the OR of clauses, each of them the AND of (possibly negated) names
+	Postings result;
+	Postings included, excluded;
+	bool positive = false; // the clause has a name that isn't negated
+	bool negative = false; // the clause has a negated name
+	bool negated = false; // the name being read is negated
+	std::string name;
+
+	// a name ends at an operator or at the end of the query
+	std::istringstream words(query + " OR");
+	std::string word;
+	while (words >> word)
+	{
+		bool isOperator = word == "AND" || word == "OR" || word == "NOT";
+		if (isOperator && !name.empty())
+		{
+			Postings const * ids = this->postings(name);
+			Postings none;
+			if (ids == nullptr)
+			{
+				ids = &none;
+			}
+
+			if (negated)
+			{
+				excluded = unite(excluded, *ids);
+				negative = true;
+			}
+			else
+			{
+				included = positive ? intersect(included, *ids) : *ids;
+				positive = true;
+			}
+			name.clear();
+			negated = false;
+		}
+
+		if (word == "NOT")
+		{
+			negated = true;
+		}
+		else if (word == "OR")
+		{
+			// a clause of negated names only starts from everything
+			if (!positive && negative)
+			{
+				included = this->everything();
+				positive = true;
+			}
+			if (positive)
+			{
+				result = unite(result, subtract(included, excluded));
+			}
+			included.clear();
+			excluded.clear();
+			positive = false;
+			negative = false;
+			negated = false;
+		}
+		else if (!isOperator)
+		{
+			name += name.empty() ? "" : " ";
+			name += word;
+		}
+	}
+
+	nostl::Vector<Recipe *> recipes;
+	recipes.reserve(result.size());
+	for (unsigned int k = 0; k < result.size(); ++k)
+	{
+		recipes.push_back(this->recipes_[result[k]]);
+	}
+	return recipes;
+}
+
+void IngredientIndex::recipeAdded(Recipe const & recipe)
+{
+	// ids of removed Recipes pile up, a rebuild picks the new one up as well
+	if (this->removed_ > 64 &&
+			this->removed_ > this->recipes_.size() - this->removed_)
+	{
+		this->rebuild();
+		return;
+	}
+
+	this->index(recipe);
+}
+
+void IngredientIndex::recipeRemoved(Recipe const & recipe)
+{
+	std::uint32_t const * found = this->ids_.find(&recipe);
+	if (found == nullptr)
+	{
+		return;
+	}
+	std::uint32_t id = *found;
+
+	SymbolTable const & symbols = this->book_->symbols();
+	for (unsigned int k = 1; k <= recipe.number_of_ingredients(); ++k)
+	{
+		std::uint32_t term = termOf(recipe.getNth(k), symbols);
+		if (term != SymbolTable::NONE)
+		{
+			this->unpost(id, term);
+		}
+	}
+
+	this->recipes_[id] = nullptr;
+	++this->removed_;
+	this->ids_.remove(&recipe);
+}
+
+void IngredientIndex::ingredientAdded(Recipe const & recipe,
+										Ingredient const & ingredient)
+{
+	std::uint32_t const * id = this->ids_.find(&recipe);
+	if (id != nullptr)
+	{
+		this->post(*id, ingredient);
+	}
+}
+
+void IngredientIndex::ingredientRemoved(Recipe const & recipe,
+										Ingredient const & ingredient)
+{
+	std::uint32_t const * id = this->ids_.find(&recipe);
+	std::uint32_t term = termOf(ingredient, this->book_->symbols());
+	if (id == nullptr || term == SymbolTable::NONE)
+	{
+		return;
+	}
+
+	// the Recipe stays posted if another ingredient has the same name
+	SymbolTable const & symbols = this->book_->symbols();
+	for (unsigned int k = 1; k <= recipe.number_of_ingredients(); ++k)
+	{
+		Ingredient const & candidate = recipe.getNth(k);
+		if (&candidate != &ingredient && termOf(candidate, symbols) == term)
+		{
+			return;
+		}
+	}
+
+	this->unpost(*id, term);
+}
+
+void IngredientIndex::bookCleared()
+{
+	this->reset();
+}
+
+void IngredientIndex::bookDestroyed()
+{
+	this->reset();
+	this->book_ = nullptr;
+}
+
+IngredientIndex::~IngredientIndex()
+{
+	if (this->book_ != nullptr)
+	{
+		this->book_->detach(this);
+	}
+}
+
+void IngredientIndex::reset()
+{
+	this->recipes_.clear();
+	this->removed_ = 0;
+	this->ids_.clear();
+	this->postings_.clear();
+}
+
+void IngredientIndex::index(Recipe const & recipe)
+{
+	// the book hands out its Recipes as const, but they're its own to edit
+	std::uint32_t id = this->recipes_.size();
+	this->recipes_.push_back(const_cast<Recipe *>(&recipe));
+	this->ids_.insert(&recipe, id);
+
+	for (unsigned int k = 1; k <= recipe.number_of_ingredients(); ++k)
+	{
+		this->post(id, recipe.getNth(k));
+	}
+}
+
+void IngredientIndex::post(std::uint32_t id, Ingredient const & ingredient)
+{
+	std::uint32_t term = termOf(ingredient, this->book_->symbols());
+	if (term == SymbolTable::NONE)
+	{
+		return;
+	}
+
+	// new ids go to the end, edits of older Recipes into the middle
+	Postings & ids = this->postings_[term];
+	unsigned int position = lowerBound(ids, id);
+	if (position == ids.size() || ids[position] != id)
+	{
+		ids.insert(position, id);
+	}
+}
+
+void IngredientIndex::unpost(std::uint32_t id, std::uint32_t term)
+{
+	Postings * ids = this->postings_.find(term);
+	if (ids == nullptr)
+	{
+		return;
+	}
+
+	unsigned int position = lowerBound(*ids, id);
+	if (position < ids->size() && (*ids)[position] == id)
+	{
+		ids->erase(position);
+	}
+	if (ids->empty())
+	{
+		this->postings_.remove(term);
+	}
+}
+
+IngredientIndex::Postings const *
+IngredientIndex::postings(std::string const & name) const
+{
+	if (this->book_ == nullptr)
+	{
+		return nullptr;
+	}
+
+	// a normalized name is interned along with every name that has it
+	std::string normalized = normalize(name);
+	std::uint32_t term = this->book_->symbols().find(normalized.data(),
+														normalized.size());
+	return term == SymbolTable::NONE ? nullptr : this->postings_.find(term);
+}
+
+IngredientIndex::Postings IngredientIndex::everything() const
+{
+	Postings ids;
+	ids.reserve(this->recipes_.size() - this->removed_);
+	for (unsigned int k = 0; k < this->recipes_.size(); ++k)
+	{
+		if (this->recipes_[k] != nullptr)
+		{
+			ids.push_back(k);
+		}
+	}
+	return ids;
+}
+
+} // namespace banch
@@ -3,6 +3,8 @@
 /// \brief function definitons for interactiveFunctions.hxx
 
 #include "banch/interactiveFunctions.hxx"
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 
 /// \brief namespace for the banch project
@@ -55,11 +57,106 @@ void printSep(std::ostream & os, unsigned int n, char sepChar)
 	{
 		os << sepChar;
 	}
-	os << std::endl;
+	os << '\n';
 }
 
 
 
+namespace {
+
+/// \brief show a Recipe and let the user edit it through a menu
+///
+/// \param os stream to write messages into
+/// \param is stream to read user input from
+/// \param recipe to edit
+void editRecipe(std::ostream & os, std::istream & is, Recipe & recipe)
+{
+	os << "Editing:" << std::endl;
+	recipe.show(os);
+
+	// create menu with options
+	menu::AdvancedMenu menu(os, is,
+							std::function<void()>(Fshow_recipe(os, recipe)));
+	menu.add(menu::Option("add beverage ingredient",
+							std::function<void()>(Fadd_beverage(os, is,
+																recipe))));
+	menu.add(menu::Option("add extra ingredient",
+							std::function<void()>(Fadd_extra(os, is, recipe))));
+	menu.add(menu::Option("remove ingredient",
+							std::function<void()>(Fremove_ingredient(os, is,
+																	recipe))));
+
+	menu();
+}
+
+/// \brief ask the user for the name of a Recipe (or a prefix of it) and look
+/// it up
+///
+/// \param os stream to write messages into
+/// \param is stream to read the name from
+/// \param book to look the Recipe up in
+/// \param completer to complete prefixes with
+/// \param text to prompt user with
+///
+/// \return the Recipe or nullptr if the user cancelled
+Recipe * askRecipeName(std::ostream & os, std::istream & is,
+						RecipeBook const & book,
+						NameCompleter const & completer,
+						std::string const text)
+{
+	std::string name;
+	while (true)
+	{
+		os << std::endl;
+		os << text << ' ';
+		if (!getline(is, name) || name.empty())
+		{
+			return nullptr;
+		}
+
+		Recipe * recipe = book.findByName(name);
+		if (recipe != nullptr)
+		{
+			return recipe;
+		}
+
+		// not a name, maybe the start of one
+		nostl::Vector<Recipe *> completions = completer.complete(name);
+		if (completions.empty())
+		{
+			os << "There is no recipe called " << name << " or starting with"
+				" it!" << std::endl;
+			continue;
+		}
+		if (completions.size() == 1)
+		{
+			return completions[0];
+		}
+
+		os << "0) none of these" << '\n';
+		for (unsigned int k = 0; k < completions.size(); ++k)
+		{
+			os << k + 1 << ") " << completions[k]->getName() << '\n';
+		}
+		int selection;
+		do
+		{
+			selection = askNumber(os, is, "Please enter number of recipe" \
+											" (0 to type again):");
+		}
+		while (selection < 0 || selection > completions.size());
+
+		if (selection != 0)
+		{
+			return completions[selection - 1];
+		}
+	}
+}
+
+} // namespace
+
+
+
 //////////////////////
 // FUNCTION OBJECTS //
 //////////////////////
@@ -218,31 +315,25 @@ void Fmodify_recipe::operator()()
 		return;
 	}
 
-	// get reference to chosen Recipe
-	Recipe & recipe = this->book_.getNth(selection);
+	// edit chosen Recipe
+	editRecipe(this->os_, this->is_, this->book_.getNth(selection));
+}
 
-	this->os_ << "Editing:" << std::endl;
-	recipe.show(this->os_);
+// class Fmodify_recipe_by_name //
 
-	// create menu with options
-	menu::AdvancedMenu menu(this->os_,
-							this->is_,
-							std::function<void()>(Fshow_recipe(this->os_,
-																recipe)));
-	menu.add(menu::Option("add beverage ingredient",
-							std::function<void()>(Fadd_beverage(this->os_,
-																this->is_,
-																recipe))));
-	menu.add(menu::Option("add extra ingredient",
-							std::function<void()>(Fadd_extra(this->os_,
-																this->is_,
-																recipe))));
-	menu.add(menu::Option("remove ingredient",
-							std::function<void()>(Fremove_ingredient(this->os_,
-																	this->is_,
-																	recipe))));
+void Fmodify_recipe_by_name::operator()()
+{
+	// look the Recipe up by name
+	Recipe * recipe = askRecipeName(this->os_, this->is_, this->book_,
+									this->completer_,
+									"Please enter name of recipe to modify," \
+									" or its start (empty cancels):");
+	if (recipe == nullptr)
+	{
+		return;
+	}
 
-	menu();
+	editRecipe(this->os_, this->is_, *recipe);
 }
 
 // class Fremove_recipe //
@@ -282,6 +373,181 @@ void Fremove_recipe::operator()()
 	}
 }
 
+// class Fremove_duplicates //
+
+void Fremove_duplicates::operator()()
+{
+	nostl::Vector<Recipe *> duplicates = this->book_.findDuplicates();
+	if (duplicates.empty())
+	{
+		this->os_ << "There are no duplicate recipes." << std::endl;
+		return;
+	}
+
+	// show what goes (the first of equal Recipes stays)
+	this->os_ << std::endl;
+	this->os_ << "Will remove:" << '\n';
+	for (unsigned int k = 0; k < duplicates.size(); ++k)
+	{
+		this->os_ << "- " << duplicates[k]->getName() << '\n';
+	}
+	std::stringstream tmp;
+	tmp << duplicates.size() << " duplicate recipe(s)";
+	if (confirm(this->os_, this->is_, tmp.str()))
+	{
+		for (unsigned int k = 0; k < duplicates.size(); ++k)
+		{
+			this->book_.remove(duplicates[k]);
+		}
+	}
+}
+
+// class Fnear_duplicates //
+
+void Fnear_duplicates::operator()()
+{
+	unsigned int percent;
+	do
+	{
+		percent = askNumber(this->os_, this->is_,
+							"Please enter how alike the ingredients of" \
+							" recipes should be in percent (0 means 50):");
+	}
+	while (percent > 100);
+
+	this->os_ << std::endl;
+	NearDuplicateFinder finder(percent == 0 ? 0.5 : percent / 100.0,
+								this->threads_);
+	finder.report(this->os_, this->book_);
+}
+
+// class Fremove_recipe_by_name //
+
+void Fremove_recipe_by_name::operator()()
+{
+	// look the Recipe up by name
+	Recipe * recipe = askRecipeName(this->os_, this->is_, this->book_,
+									this->completer_,
+									"Please enter name of recipe to remove," \
+									" or its start (empty cancels):");
+	if (recipe == nullptr)
+	{
+		return;
+	}
+
+	// confirm
+	this->os_ << std::endl;
+	this->os_ << "Will remove:";
+	std::stringstream tmp;
+	recipe->show(tmp);
+	if (confirm(this->os_, this->is_, tmp.str()))
+	{
+		this->book_.remove(recipe);
+	}
+}
+
+// class Ffind_recipes //
+
+void Ffind_recipes::operator()()
+{
+	// prompt the user for a query
+	std::string input;
+	this->os_ << "Find recipes with ingredients" \
+				" [e.g. gin AND lime juice OR rum NOT mint]: ";
+	getline(this->is_, input);
+
+	// show what matches
+	nostl::Vector<Recipe *> recipes = this->index_.query(input);
+	if (recipes.empty())
+	{
+		this->os_ << "No recipes found!" << std::endl;
+		return;
+	}
+
+	for (unsigned int k = 0; k < recipes.size(); ++k)
+	{
+		this->os_ << '\n';
+		recipes[k]->show(this->os_);
+	}
+	this->os_ << recipes.size() << " recipes found" << std::endl;
+}
+
+// class Ffuzzy_search //
+
+void Ffuzzy_search::operator()()
+{
+	// prompt the user for a name
+	std::string input;
+	this->os_ << "Search recipes and ingredients by name" \
+				" [typos are fine]: ";
+	getline(this->is_, input);
+
+	// list the matches, closest first
+	nostl::Vector<FuzzyMatch> matches = this->index_.search(input);
+	if (matches.empty())
+	{
+		this->os_ << "No recipes found!" << std::endl;
+		return;
+	}
+
+	this->os_ << '\n';
+	for (unsigned int k = 0; k < matches.size(); ++k)
+	{
+		this->os_ << k + 1 << ") " << matches[k].recipe->getName();
+		if (matches[k].ingredient)
+		{
+			this->os_ << " (has " << matches[k].text << ')';
+		}
+		this->os_ << '\n';
+	}
+	this->os_ << std::flush;
+}
+
+// class Fwhat_can_i_make //
+
+void Fwhat_can_i_make::operator()()
+{
+	// prompt the user for the inventory, one ingredient a line
+	this->os_ << "Enter what's in stock, one ingredient a line" \
+				" [units name, empty line ends]:" << std::endl;
+	nostl::Vector<Stock> inventory;
+	std::string input;
+	while (getline(this->is_, input) && !input.empty())
+	{
+		std::stringstream line(input);
+		Stock stock;
+		if (!(line >> stock.units) || !getline(line, stock.name))
+		{
+			this->os_ << "Skipping malformed line!" << std::endl;
+			continue;
+		}
+		inventory.push_back(stock);
+	}
+
+	// list what can be made, most servings first
+	nostl::Vector<Makeable> makeable = this->matcher_.makeable(inventory);
+	if (makeable.empty())
+	{
+		this->os_ << "Nothing can be made!" << std::endl;
+		return;
+	}
+
+	this->os_ << '\n';
+	for (unsigned int k = 0; k < makeable.size(); ++k)
+	{
+		if (makeable[k].servings == InventoryMatcher::UNLIMITED)
+		{
+			this->os_ << "any number of ";
+		}
+		else
+		{
+			this->os_ << makeable[k].servings << " x ";
+		}
+		this->os_ << makeable[k].recipe->getName() << '\n';
+	}
+	this->os_ << makeable.size() << " recipes can be made" << std::endl;
+}
+
 // class Fsave_recipebook //
 
 void Fsave_recipebook::operator()()
@@ -291,20 +557,28 @@ void Fsave_recipebook::operator()()
 	this->os_ << "Save current database as [path]: ";
 	getline(this->is_, input);
 
-	// open a stream
-	std::ofstream ofs;
-	ofs.open(input);
-	if (!ofs.is_open())
+	// the journal only needs the edits since the last save
+	if (this->journal_ != nullptr && this->journal_->isOpen() &&
+			input == this->journal_->path())
 	{
-		this->os_ << "Failed to open file!" << std::endl;
+		unsigned int edits = this->journal_->pending();
+		if (!this->journal_->commit())
+		{
+			this->os_ << "Failed to write journal!" << std::endl;
+			return;
+		}
+		this->os_ << "Sucessfully saved " << edits << " edit(s) to " << input
+					<< std::endl;
 		return;
 	}
 
-	// serialize into stream
-	this->book_.serialize(ofs);
-
-	// close the stream
-	ofs.close();
+	// the file may be the one the book was loaded from, so it's replaced
+	// rather than overwritten
+	if (!this->book_.save(input.c_str(), this->binary_))
+	{
+		this->os_ << "Failed to write file!" << std::endl;
+		return;
+	}
 
 	this->os_ << "Sucessfully saved database as " << input << std::endl;
 }
@@ -318,22 +592,117 @@ void Fload_recipebook::operator()()
 	this->os_ << "Enter name of file to load [path]: ";
 	getline(this->is_, input);
 
-	// open a stream
+	// map the file and deserialize it in place (the format is detected)
+	if (!this->book_.load(input.c_str(), this->threads_))
+	{
+		this->os_ << "Failed to load file!" << std::endl;
+		return;
+	}
+
+	this->os_ << "Successfully loaded database from " << input << std::endl;
+}
+
+// class Fbrowse_recipebook //
+
+void Fbrowse_recipebook::operator()()
+{
+	// prompt the user for a filename
+	std::string input;
+	this->os_ << "Enter name of file to browse [path]: ";
+	getline(this->is_, input);
+
+	// only index the file
+	LazyBook book;
+	if (!book.open(input.c_str()))
+	{
+		this->os_ << "Failed to open file!" << std::endl;
+		return;
+	}
+	this->os_ << input << " has " << book.number_of_entries() << " recipe(s)"
+				<< std::endl;
+
+	// show Recipes by name or number, "list" lists the names
+	while (true)
+	{
+		this->os_ << "Enter name or number of recipe to show" \
+					" [list, empty line ends]: ";
+		if (!getline(this->is_, input) || input.empty())
+		{
+			return;
+		}
+		if (input == "list")
+		{
+			book.list(this->os_, true);
+			continue;
+		}
+
+		unsigned int n = book.numberOf(input);
+		if (n == 0)
+		{
+			n = std::strtoul(input.c_str(), nullptr, 10);
+		}
+		if (n == 0 || n > book.number_of_entries())
+		{
+			this->os_ << "There is no recipe called " << input << '!'
+						<< std::endl;
+			continue;
+		}
+		book.getNth(n).show(this->os_);
+		this->os_ << std::flush;
+	}
+}
+
+// class Fconvert_recipebook //
+
+void Fconvert_recipebook::operator()()
+{
+	// prompt the user for filenames
+	std::string input, output;
+	this->os_ << "Enter name of file to convert [path]: ";
+	getline(this->is_, input);
+	this->os_ << "Save converted database as [path]: ";
+	getline(this->is_, output);
+
+	// open the streams
 	std::ifstream ifs;
-	ifs.open(input);
+	ifs.open(input, std::ios::in | std::ios::binary);
 	if (!ifs.is_open())
 	{
 		this->os_ << "Failed to open file!" << std::endl;
 		return;
 	}
 
-	// deserialize from stream
-	this->book_.deserialize(ifs);
+	// the output may be the input, and a corrupt input mustn't leave a
+	// broken output behind either, so the conversion goes into a new file
+	// that replaces the output only once it's complete
+	std::string temporary = output + ".tmp";
+	std::ofstream ofs;
+	ofs.open(temporary, std::ios::out | std::ios::binary);
+	if (!ofs.is_open())
+	{
+		this->os_ << "Failed to open file!" << std::endl;
+		return;
+	}
 
-	// close the stream
+	// convert
+	bool converted = convertFormat(ifs, ofs);
+	ofs.close();
+	if (!converted)
+	{
+		std::remove(temporary.c_str());
+		this->os_ << "Failed to load corrupt database file!" << std::endl;
+		return;
+	}
 	ifs.close();
+	if (ofs.fail() || std::rename(temporary.c_str(), output.c_str()) != 0)
+	{
+		std::remove(temporary.c_str());
+		this->os_ << "Failed to write file!" << std::endl;
+		return;
+	}
 
-	this->os_ << "Successfully loaded database from " << input << std::endl;
+	this->os_ << "Successfully converted " << input << " into " << output
+				<< std::endl;
 }
 
 } // namespace banch
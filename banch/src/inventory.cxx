@@ -0,0 +1,309 @@
+/// \file inventory.cxx
+///
+/// \brief function definitions of inventory.hxx
+
+#include "banch/inventory.hxx"
+#include "banch/ingredient_index.hxx"
+#include "nostl/sort.hxx"
+
+/// \brief namespace for the banch project
+namespace banch {
+
+namespace {
+
+/// \brief orders Makeables by servings (most first)
+struct MoreServings {
+	/// \brief compare two Makeables
+	///
+	/// \param lhs left hand side
+	/// \param rhs right hand side
+	///
+	/// \return true if lhs has more servings
+	bool operator()(Makeable const & lhs, Makeable const & rhs) const
+	{
+		return lhs.servings > rhs.servings;
+	}
+}; // struct MoreServings
+
+} // namespace
+
+// class InventoryMatcher //
+
+unsigned long long const InventoryMatcher::UNLIMITED;
+
+InventoryMatcher::InventoryMatcher(RecipeBook & book)
+	: book_(&book), stale_(0), names_(0)
+{
+	this->rebuild();
+	book.attach(this);
+}
+
+void InventoryMatcher::rebuild()
+{
+	this->reset();
+	if (this->book_ == nullptr)
+	{
+		return;
+	}
+
+	for (unsigned int k = 1; k <= this->book_->number_of_entries(); ++k)
+	{
+		this->recipeAdded(this->book_->getNth(k));
+	}
+}
+
+nostl::Vector<Makeable>
+InventoryMatcher::makeable(nostl::Vector<Stock> const & inventory) const
+{
+	// the inventory as a dense bitset over the names, plus units by bit
+	nostl::Vector<std::uint64_t> stocked((this->names_ + 63) / 64, 0);
+	nostl::Vector<unsigned long long> units(this->names_, 0);
+	for (unsigned int k = 0; this->book_ != nullptr && k < inventory.size();
+			++k)
+	{
+		std::string name = IngredientIndex::normalize(inventory[k].name);
+		std::uint32_t term = this->book_->symbols().find(name.data(),
+															name.size());
+		std::uint32_t bit = term < this->bits_.size() ?
+								this->bits_[term] : SymbolTable::NONE;
+		if (bit != SymbolTable::NONE && inventory[k].units != 0)
+		{
+			stocked[bit / 64] |= std::uint64_t(1) << (bit % 64);
+			units[bit] += inventory[k].units;
+		}
+	}
+
+	nostl::Vector<Makeable> result;
+	std::uint32_t const * words = this->word_.begin();
+	std::uint64_t const * masks = this->mask_.begin();
+	for (unsigned int slot = 0; slot < this->recipe_.size(); ++slot)
+	{
+		if (this->recipe_[slot] == nullptr || !this->checkable_[slot])
+		{
+			continue;
+		}
+
+		// every name has to be in stock
+		std::uint64_t missing = 0;
+		std::uint32_t end = this->bitsAt_[slot] + this->bitsCount_[slot];
+		for (std::uint32_t j = this->bitsAt_[slot]; j < end; ++j)
+		{
+			missing |= masks[j] & ~stocked[words[j]];
+		}
+		if (missing != 0)
+		{
+			continue;
+		}
+
+		// the scarcest Beverage limits the servings
+		unsigned long long servings = UNLIMITED;
+		end = this->needsAt_[slot] + this->needsCount_[slot];
+		for (std::uint32_t j = this->needsAt_[slot]; j < end; ++j)
+		{
+			unsigned long long most =
+						units[this->needName_[j]] / this->needUnits_[j];
+			servings = most < servings ? most : servings;
+		}
+		if (servings != 0)
+		{
+			Makeable makeable = { this->recipe_[slot], servings };
+			result.push_back(makeable);
+		}
+	}
+
+	nostl::sort(result.begin(), result.end(), MoreServings());
+	return result;
+}
+
+void InventoryMatcher::recipeAdded(Recipe const & recipe)
+{
+	// a rebuild picks the new Recipe up from the book already
+	if (this->compactIfSparse())
+	{
+		return;
+	}
+
+	// the book hands out its Recipes as const, but they're its own to edit
+	std::uint32_t slot = this->recipe_.size();
+	this->recipe_.push_back(const_cast<Recipe *>(&recipe));
+	this->bitsAt_.push_back(0);
+	this->bitsCount_.push_back(0);
+	this->needsAt_.push_back(0);
+	this->needsCount_.push_back(0);
+	this->checkable_.push_back(1);
+	this->slotOf_.insert(&recipe, slot);
+	this->write(slot, recipe, nullptr);
+}
+
+void InventoryMatcher::recipeRemoved(Recipe const & recipe)
+{
+	std::uint32_t const * slot = this->slotOf_.find(&recipe);
+	if (slot == nullptr)
+	{
+		return;
+	}
+
+	this->stale_ += 1 + this->bitsCount_[*slot] + this->needsCount_[*slot];
+	this->recipe_[*slot] = nullptr;
+	this->slotOf_.remove(&recipe);
+}
+
+void InventoryMatcher::ingredientAdded(Recipe const & recipe,
+										Ingredient const &)
+{
+	std::uint32_t const * slot = this->slotOf_.find(&recipe);
+	if (slot != nullptr)
+	{
+		this->write(*slot, recipe, nullptr);
+	}
+	this->compactIfSparse();
+}
+
+void InventoryMatcher::ingredientRemoved(Recipe const & recipe,
+										Ingredient const & ingredient)
+{
+	// the ingredient is still in the Recipe, so a rebuild can't come now
+	std::uint32_t const * slot = this->slotOf_.find(&recipe);
+	if (slot != nullptr)
+	{
+		this->write(*slot, recipe, &ingredient);
+	}
+}
+
+void InventoryMatcher::bookCleared()
+{
+	this->reset();
+}
+
+void InventoryMatcher::bookDestroyed()
+{
+	this->reset();
+	this->book_ = nullptr;
+}
+
+InventoryMatcher::~InventoryMatcher()
+{
+	if (this->book_ != nullptr)
+	{
+		this->book_->detach(this);
+	}
+}
+
+void InventoryMatcher::reset()
+{
+	this->recipe_.clear();
+	this->bitsAt_.clear();
+	this->bitsCount_.clear();
+	this->needsAt_.clear();
+	this->needsCount_.clear();
+	this->checkable_.clear();
+	this->slotOf_.clear();
+	this->word_.clear();
+	this->mask_.clear();
+	this->needName_.clear();
+	this->needUnits_.clear();
+	this->stale_ = 0;
+	this->bits_.clear();
+	this->names_ = 0;
+}
+
+void InventoryMatcher::write(std::uint32_t slot, Recipe const & recipe,
+								Ingredient const * skip)
+{
+	// the previous entry goes stale
+	this->stale_ += this->bitsCount_[slot] + this->needsCount_[slot];
+
+	// collect the names (sorted, for the words) and the units they need
+	nostl::Vector<std::uint32_t> ids;
+	std::uint32_t needsAt = this->needName_.size();
+	bool checkable = true;
+	SymbolTable const & symbols = this->book_->symbols();
+	for (unsigned int k = 1; k <= recipe.number_of_ingredients(); ++k)
+	{
+		Ingredient const & ingredient = recipe.getNth(k);
+		IngredientValue value;
+		if (&ingredient == skip)
+		{
+			continue;
+		}
+		std::uint32_t term = IngredientIndex::termOf(ingredient, symbols);
+		if (term == SymbolTable::NONE || !ingredient.toValue(value))
+		{
+			checkable = false;
+			continue;
+		}
+
+		std::uint32_t id = this->bitOf(term);
+		unsigned int position = 0;
+		while (position < ids.size() && ids[position] < id)
+		{
+			++position;
+		}
+		if (position == ids.size() || ids[position] != id)
+		{
+			ids.insert(position, id);
+		}
+
+		if (value.kind != IngredientValue::BEVERAGE || value.quanta == 0)
+		{
+			continue;
+		}
+		std::uint32_t j = needsAt;
+		while (j < this->needName_.size() && this->needName_[j] != id)
+		{
+			++j;
+		}
+		if (j == this->needName_.size())
+		{
+			this->needName_.push_back(id);
+			this->needUnits_.push_back(0);
+		}
+		this->needUnits_[j] += value.quanta;
+	}
+
+	// one nonzero word per run of ids in the same 64
+	std::uint32_t bitsAt = this->word_.size();
+	for (unsigned int k = 0; k < ids.size(); ++k)
+	{
+		if (this->word_.size() == bitsAt || this->word_.back() != ids[k] / 64)
+		{
+			this->word_.push_back(ids[k] / 64);
+			this->mask_.push_back(0);
+		}
+		this->mask_.back() |= std::uint64_t(1) << (ids[k] % 64);
+	}
+
+	this->bitsAt_[slot] = bitsAt;
+	this->bitsCount_[slot] = this->word_.size() - bitsAt;
+	this->needsAt_[slot] = needsAt;
+	this->needsCount_[slot] = this->needName_.size() - needsAt;
+	this->checkable_[slot] = checkable;
+}
+
+std::uint32_t InventoryMatcher::bitOf(std::uint32_t term)
+{
+	if (this->bits_.size() <= term)
+	{
+		this->bits_.resize(term + 1, SymbolTable::NONE);
+	}
+	if (this->bits_[term] == SymbolTable::NONE)
+	{
+		this->bits_[term] = this->names_++;
+	}
+	return this->bits_[term];
+}
+
+bool InventoryMatcher::compactIfSparse()
+{
+	unsigned int total = this->recipe_.size() + this->word_.size() +
+							this->needName_.size();
+	if (this->stale_ <= 1024 || this->stale_ <= total - this->stale_)
+	{
+		return false;
+	}
+
+	this->rebuild();
+	return true;
+}
+
+} // namespace banch
@@ -0,0 +1,464 @@
+/// \file journal.cxx
+///
+/// \brief function definitions of journal.hxx
+
+#include "banch/journal.hxx"
+#include "banch/mapped_file.hxx"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+namespace {
+
+/// \brief hash the contents of a mapped file
+///
+/// \param file to hash
+///
+/// \return hash of all of its bytes
+std::uint64_t hashFile(MappedFile const & file)
+{
+	// eight bytes at a time, snapshots can be big
+	std::uint64_t hash = file.size();
+	std::size_t k = 0;
+	for (; k + sizeof(std::uint64_t) <= file.size(); k += sizeof(std::uint64_t))
+	{
+		std::uint64_t word;
+		std::memcpy(&word, file.data() + k, sizeof(word));
+		hash = nostl::mix(hash ^ word) + k;
+	}
+	return nostl::mix(hash ^ nostl::hashBytes(file.data() + k, file.size() - k));
+}
+
+/// \brief checksum of the payload of a record
+///
+/// \param data address of first byte
+/// \param size number of bytes
+///
+/// \return the checksum
+std::uint32_t checksum(char const * data, std::uint64_t size)
+{
+	return static_cast<std::uint32_t>(nostl::mix(nostl::hashBytes(data, size)));
+}
+
+/// \brief write all of some bytes into a file descriptor
+///
+/// \param fd to write into
+/// \param data address of first byte
+/// \param size number of bytes
+///
+/// \return false if write(2) failed
+bool writeAll(int fd, char const * data, std::size_t size)
+{
+	while (size != 0)
+	{
+		ssize_t written = ::write(fd, data, size);
+		if (written == -1)
+		{
+			return false;
+		}
+		data += written;
+		size -= written;
+	}
+	return true;
+}
+
+} // namespace
+
+// class Journal //
+
+Journal::Journal(RecipeBook & book)
+	:	book_(&book), fd_(-1), snapshotBytes_(0), snapshotHash_(0),
+		journalBytes_(0), pending_(0), recording_(false), cleared_(false)
+{
+	book.attach(this);
+}
+
+bool Journal::open(std::string const & path, unsigned int threads)
+{
+	this->close();
+	if (this->book_ == nullptr)
+	{
+		return false;
+	}
+
+	// the book is rebuilt from the files, that's nothing to record
+	this->path_ = path;
+	this->book_->clear();
+
+	MappedFile snapshot;
+	if (::access(path.c_str(), F_OK) == 0)
+	{
+		if (!this->book_->load(path.c_str(), threads) ||
+				!snapshot.open(path.c_str()))
+		{
+			return false;
+		}
+	}
+	this->snapshotBytes_ = snapshot.size();
+	this->snapshotHash_ = hashFile(snapshot);
+	snapshot.close();
+
+	std::string journalPath = path + ".journal";
+	MappedFile journal;
+	std::uint64_t intact = 0;
+	if (journal.open(journalPath.c_str()))
+	{
+		intact = this->replay(journal.data(), journal.size(),
+								this->snapshotBytes_, this->snapshotHash_);
+	}
+	journal.close();
+
+	// a journal that doesn't follow the snapshot starts over, a torn record
+	// at the end is cut off
+	this->fd_ = ::open(journalPath.c_str(), O_WRONLY | O_CREAT | O_APPEND,
+						0644);
+	if (this->fd_ == -1)
+	{
+		return false;
+	}
+	if (intact == 0)
+	{
+		if (!this->restart())
+		{
+			this->close();
+			return false;
+		}
+	}
+	else if (::ftruncate(this->fd_, intact) == -1)
+	{
+		this->close();
+		return false;
+	}
+	else
+	{
+		this->journalBytes_ = intact;
+	}
+
+	this->recording_ = true;
+	this->cleared_ = false;
+	return true;
+}
+
+bool Journal::commit()
+{
+	if (!this->isOpen())
+	{
+		return false;
+	}
+
+	// a cleared book is one big edit, a snapshot says it best
+	if (this->cleared_ || (this->journalBytes_ > COMPACTION &&
+							this->journalBytes_ > this->snapshotBytes_))
+	{
+		return this->compact();
+	}
+
+	std::string records = this->records_.str();
+	if (records.empty())
+	{
+		return true;
+	}
+	if (!writeAll(this->fd_, records.data(), records.size()) ||
+			::fdatasync(this->fd_) == -1)
+	{
+		// whatever made it is a prefix of whole records at worst followed by
+		// a torn one, cut it off again so the next try appends cleanly
+		if (::ftruncate(this->fd_, this->journalBytes_) == -1)
+		{
+			this->close();
+		}
+		return false;
+	}
+
+	this->journalBytes_ += records.size();
+	this->records_.str(std::string());
+	this->pending_ = 0;
+
+	if (this->journalBytes_ > COMPACTION &&
+			this->journalBytes_ > this->snapshotBytes_)
+	{
+		return this->compact();
+	}
+	return true;
+}
+
+bool Journal::compact()
+{
+	if (!this->isOpen())
+	{
+		return false;
+	}
+
+	// the new snapshot replaces the old one as a whole
+	if (!this->book_->save(this->path_.c_str(), true))
+	{
+		return false;
+	}
+
+	// the old journal doesn't follow the new snapshot, so it's ignored even
+	// if restarting it fails
+	MappedFile snapshot;
+	if (!snapshot.open(this->path_.c_str()))
+	{
+		return false;
+	}
+	this->snapshotBytes_ = snapshot.size();
+	this->snapshotHash_ = hashFile(snapshot);
+	snapshot.close();
+
+	this->records_.str(std::string());
+	this->pending_ = 0;
+	this->cleared_ = false;
+	return this->restart();
+}
+
+void Journal::recipeAdded(Recipe const & recipe)
+{
+	if (!this->recording_ || this->cleared_)
+	{
+		return;
+	}
+
+	nostl::Sink sink(this->record_);
+	BinaryWriter writer(sink);
+	writer.writeByte(RECIPE_ADDED);
+	recipe.serializeBinary(writer);
+	sink.flush();
+	this->queue();
+}
+
+void Journal::recipeRemoved(Recipe const & recipe)
+{
+	// a record of a Recipe that isn't in the book couldn't be replayed
+	if (!this->recording_ || this->cleared_ ||
+			this->book_->numberOf(recipe) == 0)
+	{
+		return;
+	}
+
+	nostl::Sink sink(this->record_);
+	BinaryWriter writer(sink);
+	writer.writeByte(RECIPE_REMOVED);
+	writer.writeVarint(this->book_->numberOf(recipe));
+	sink.flush();
+	this->queue();
+}
+
+void Journal::ingredientAdded(Recipe const & recipe,
+								Ingredient const & ingredient)
+{
+	if (!this->recording_ || this->cleared_ ||
+			this->book_->numberOf(recipe) == 0)
+	{
+		return;
+	}
+
+	nostl::Sink sink(this->record_);
+	BinaryWriter writer(sink);
+	writer.writeByte(INGREDIENT_ADDED);
+	writer.writeVarint(this->book_->numberOf(recipe));
+	ingredient.serializeBinary(writer);
+	sink.flush();
+	this->queue();
+}
+
+void Journal::ingredientRemoved(Recipe const & recipe,
+								Ingredient const & ingredient)
+{
+	if (!this->recording_ || this->cleared_ ||
+			this->book_->numberOf(recipe) == 0 ||
+			recipe.numberOf(ingredient) == 0)
+	{
+		return;
+	}
+
+	nostl::Sink sink(this->record_);
+	BinaryWriter writer(sink);
+	writer.writeByte(INGREDIENT_REMOVED);
+	writer.writeVarint(this->book_->numberOf(recipe));
+	writer.writeVarint(recipe.numberOf(ingredient));
+	sink.flush();
+	this->queue();
+}
+
+void Journal::bookCleared()
+{
+	if (!this->recording_)
+	{
+		return;
+	}
+
+	this->records_.str(std::string());
+	this->pending_ = 0;
+	this->cleared_ = true;
+}
+
+void Journal::bookDestroyed()
+{
+	this->book_ = nullptr;
+	this->close();
+}
+
+Journal::~Journal()
+{
+	this->close();
+	if (this->book_ != nullptr)
+	{
+		this->book_->detach(this);
+	}
+}
+
+void Journal::queue()
+{
+	std::string payload = this->record_.str();
+	this->record_.str(std::string());
+
+	nostl::Sink sink(this->records_);
+	BinaryWriter writer(sink);
+	writer.writeVarint(payload.size());
+	writer.writeBytes(payload.data(), payload.size());
+	writer.writeUint32(checksum(payload.data(), payload.size()));
+	sink.flush();
+	++this->pending_;
+}
+
+std::uint64_t Journal::replay(char const * data, std::uint64_t size,
+								std::uint64_t snapshot, std::uint64_t hash)
+{
+	BinaryReader reader(data, data + size);
+	char const * magic = reader.readBytes(sizeof(JOURNAL_MAGIC));
+	if (magic == nullptr ||
+			std::memcmp(magic, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+			reader.readByte() != JOURNAL_VERSION ||
+			reader.readVarint() != snapshot || reader.readVarint() != hash ||
+			!reader.good())
+	{
+		return 0;
+	}
+
+	// records up to the first one that is torn or doesn't check out (one
+	// that checks out was written whole, so if it doesn't fit the book it's
+	// skipped, the records after it still count)
+	char const * intact = reader.position();
+	while (!reader.atEnd())
+	{
+		std::uint64_t length = reader.readVarint();
+		char const * payload = reader.readBytes(length);
+		std::uint32_t sum = reader.readUint32();
+		if (!reader.good() || sum != checksum(payload, length))
+		{
+			break;
+		}
+		this->apply(payload, length);
+		intact = reader.position();
+	}
+	return intact - data;
+}
+
+bool Journal::apply(char const * data, std::uint64_t size)
+{
+	RecipeBook & book = *this->book_;
+	BinaryReader reader(data, data + size);
+	std::uint8_t operation = reader.readByte();
+
+	if (operation == RECIPE_ADDED)
+	{
+		Recipe * recipe = new Recipe;
+		recipe->deserializeBinary(reader);
+		if (!reader.good() || !reader.atEnd())
+		{
+			delete recipe;
+			return false;
+		}
+		book.add(recipe);
+		return true;
+	}
+
+	std::uint64_t n = reader.readVarint();
+	if (!reader.good() || n == 0 || n > book.number_of_entries())
+	{
+		return false;
+	}
+	Recipe & recipe = book.getNth(n);
+
+	if (operation == RECIPE_REMOVED && reader.atEnd())
+	{
+		book.remove(static_cast<unsigned int>(n));
+		return true;
+	}
+
+	if (operation == INGREDIENT_ADDED)
+	{
+		IngredientRegistry::Kind const * kind =
+						IngredientRegistry::instance().find(reader.readByte());
+		if (kind == nullptr)
+		{
+			return false;
+		}
+		Ingredient * ingredient = kind->factory();
+		ingredient->deserializeBinary(reader);
+		if (!reader.good() || !reader.atEnd())
+		{
+			delete ingredient;
+			return false;
+		}
+		recipe.add(ingredient);
+		return true;
+	}
+
+	if (operation == INGREDIENT_REMOVED)
+	{
+		std::uint64_t k = reader.readVarint();
+		if (!reader.good() || !reader.atEnd() || k == 0 ||
+				k > recipe.number_of_ingredients())
+		{
+			return false;
+		}
+		recipe.remove(static_cast<unsigned int>(k));
+		return true;
+	}
+
+	return false;
+}
+
+bool Journal::restart()
+{
+	std::ostringstream header;
+	{
+		nostl::Sink sink(header);
+		BinaryWriter writer(sink);
+		writer.writeBytes(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+		writer.writeByte(JOURNAL_VERSION);
+		writer.writeVarint(this->snapshotBytes_);
+		writer.writeVarint(this->snapshotHash_);
+	}
+
+	std::string bytes = header.str();
+	if (::ftruncate(this->fd_, 0) == -1 ||
+			!writeAll(this->fd_, bytes.data(), bytes.size()) ||
+			::fdatasync(this->fd_) == -1)
+	{
+		return false;
+	}
+	this->journalBytes_ = bytes.size();
+	return true;
+}
+
+void Journal::close()
+{
+	if (this->fd_ != -1)
+	{
+		::close(this->fd_);
+		this->fd_ = -1;
+	}
+	this->recording_ = false;
+	this->records_.str(std::string());
+	this->pending_ = 0;
+}
+
+} // namespace banch
@@ -0,0 +1,233 @@
+/// \file lazy_book.cxx
+///
+/// \brief function definitions of lazy_book.hxx
+
+#include "banch/lazy_book.hxx"
+
+#include <cassert>
+#include <cstring>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+namespace {
+
+/// \brief check whether a scanned line is a given keyword
+///
+/// \param line address of first character
+/// \param size number of characters
+/// \param keyword null terminated keyword
+///
+/// \return true if the line is the keyword
+bool isKeyword(char const * line, unsigned int size, char const * keyword)
+{
+	return size == std::strlen(keyword) && std::memcmp(line, keyword, size) == 0;
+}
+
+} // namespace
+
+// class LazyBook //
+
+bool LazyBook::open(char const * path)
+{
+	this->close();
+	if (!this->file_.open(path))
+	{
+		return false;
+	}
+
+	char const * begin = this->file_.data();
+	char const * end = begin + this->file_.size();
+	this->binary_ = this->file_.size() >= sizeof(BINARY_MAGIC) &&
+				std::memcmp(begin, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+	if (!this->binary_)
+	{
+		this->indexText(begin, end);
+	}
+	else if (!this->indexBinary(begin, end))
+	{
+		this->close();
+		return false;
+	}
+
+	// entries of the same name hash are chained in file order, so a lookup
+	// meets the first Recipe of a name first
+	for (unsigned int k = this->entries_.size(); k-- > 0; )
+	{
+		Entry & entry = this->entries_[k];
+		unsigned int & head =
+					this->byHash_[nostl::hashBytes(entry.name, entry.nameSize)];
+		entry.sameHash = head;
+		head = k + 1;
+	}
+	return true;
+}
+
+void LazyBook::close()
+{
+	// the Recipes point into the file
+	this->cache_.clear();
+	this->hand_ = 0;
+	this->byHash_.clear();
+	this->entries_.clear();
+	this->file_.close();
+}
+
+Recipe & LazyBook::getNth(unsigned int n)
+{
+	// assert correct call
+	assert((n > 0) && (n <= this->number_of_entries()));
+
+	Entry & entry = this->entries_[n - 1];
+	if (entry.slot != 0)
+	{
+		Slot & slot = this->cache_[entry.slot - 1];
+		slot.referenced = true;
+		return *slot.recipe;
+	}
+
+	std::unique_ptr<Recipe> recipe(this->build(entry));
+	if (this->cache_.size() < this->capacity_)
+	{
+		Slot slot = { std::move(recipe), n - 1, true };
+		this->cache_.push_back(std::move(slot));
+		entry.slot = this->cache_.size();
+		return *this->cache_.back().recipe;
+	}
+
+	// sweep, giving the Recipes asked for a second chance
+	while (this->cache_[this->hand_].referenced)
+	{
+		this->cache_[this->hand_].referenced = false;
+		this->hand_ = (this->hand_ + 1) % this->cache_.size();
+	}
+
+	Slot & victim = this->cache_[this->hand_];
+	this->entries_[victim.entry].slot = 0;
+	victim.recipe = std::move(recipe);
+	victim.entry = n - 1;
+	victim.referenced = true;
+	entry.slot = this->hand_ + 1;
+	this->hand_ = (this->hand_ + 1) % this->cache_.size();
+	return *victim.recipe;
+}
+
+unsigned int LazyBook::numberOf(std::string const & name) const
+{
+	unsigned int const * head =
+				this->byHash_.find(nostl::hashBytes(name.data(), name.size()));
+	for (unsigned int k = head == nullptr ? 0 : *head;
+			k != 0;
+			k = this->entries_[k - 1].sameHash)
+	{
+		Entry const & entry = this->entries_[k - 1];
+		if (entry.nameSize == name.size() &&
+				std::memcmp(entry.name, name.data(), name.size()) == 0)
+		{
+			return k;
+		}
+	}
+	return 0;
+}
+
+Recipe * LazyBook::findByName(std::string const & name)
+{
+	unsigned int n = this->numberOf(name);
+	return n == 0 ? nullptr : &this->getNth(n);
+}
+
+void LazyBook::list(std::ostream & os, bool numbered) const
+{
+	for (unsigned int k = 0; k < this->entries_.size(); ++k)
+	{
+		if (numbered)
+		{
+			os << k + 1 << ") ";
+		}
+		os.write(this->entries_[k].name, this->entries_[k].nameSize);
+		os << '\n';
+	}
+	os << std::flush;
+}
+
+void LazyBook::indexText(char const * begin, char const * end)
+{
+	LineScanner scanner(begin, end);
+	char const * line;
+	unsigned int size;
+	while (scanner.next(line, size))
+	{
+		if (!isKeyword(line, size, "startrecipe"))
+		{
+			continue;
+		}
+
+		// the name, then anything up to the end of the record
+		Entry entry = { line, 0, 0, line, end, 0 };
+		if (scanner.next(line, size))
+		{
+			entry.name = line;
+			entry.nameSize = size;
+		}
+		while (scanner.next(line, size))
+		{
+			if (isKeyword(line, size, "endrecipe"))
+			{
+				entry.end = line + size < end ? line + size + 1 : end;
+				break;
+			}
+		}
+		this->entries_.push_back(entry);
+	}
+}
+
+bool LazyBook::indexBinary(char const * begin, char const * end)
+{
+	BinaryReader reader(begin, end, true);
+	reader.readBytes(sizeof(BINARY_MAGIC));
+	if (reader.readByte() != BINARY_VERSION)
+	{
+		return false;
+	}
+
+	// a binary record has to be parsed to be skipped, a scratch Recipe (with
+	// its strings borrowed) takes the Ingredients each time
+	std::uint64_t count = reader.readVarint();
+	Recipe scratch;
+	for (std::uint64_t k = 0; k < count && reader.good(); ++k)
+	{
+		char const * record = reader.position();
+		scratch.deserializeBinary(reader);
+
+		// the name is the first thing in the record
+		BinaryReader name(record, reader.position(), true);
+		std::uint64_t size = name.readVarint();
+		Entry entry = { name.position(), static_cast<unsigned int>(size), 0,
+						record, reader.position(), 0 };
+		this->entries_.push_back(entry);
+		scratch.clear();
+	}
+	return reader.good();
+}
+
+Recipe * LazyBook::build(Entry const & entry) const
+{
+	Recipe * recipe = new Recipe;
+	if (this->binary_)
+	{
+		BinaryReader reader(entry.begin, entry.end, true);
+		recipe->deserializeBinary(reader);
+	}
+	else
+	{
+		// skip the "startrecipe" line
+		LineScanner scanner(entry.begin, entry.end);
+		char const * line;
+		unsigned int size;
+		scanner.next(line, size);
+		recipe->deserialize(scanner);
+	}
+	return recipe;
+}
+
+} // namespace banch
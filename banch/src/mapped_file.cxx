@@ -0,0 +1,71 @@
+/// \file mapped_file.cxx
+///
+/// \brief function definitions of mapped_file.hxx
+
+#include "banch/mapped_file.hxx"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+// class MappedFile //
+
+bool MappedFile::open(char const * path)
+{
+	this->close();
+
+	int fd = ::open(path, O_RDONLY);
+	if (fd == -1)
+	{
+		return false;
+	}
+
+	struct stat status;
+	if (::fstat(fd, &status) == -1 || !S_ISREG(status.st_mode))
+	{
+		::close(fd);
+		return false;
+	}
+
+	// an empty file can't be mapped, but it's a perfectly fine (empty) file
+	if (status.st_size != 0)
+	{
+		void * data = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE,
+								fd, 0);
+		if (data == MAP_FAILED)
+		{
+			::close(fd);
+			return false;
+		}
+
+		// parsing goes front to back
+		::madvise(data, status.st_size, MADV_SEQUENTIAL);
+
+		this->data_ = static_cast<char const *>(data);
+		this->size_ = status.st_size;
+	}
+
+	// the mapping stays valid without the descriptor
+	::close(fd);
+	this->open_ = true;
+
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (this->data_ != nullptr)
+	{
+		::munmap(const_cast<char *>(this->data_), this->size_);
+	}
+
+	this->data_ = nullptr;
+	this->size_ = 0;
+	this->open_ = false;
+}
+
+} // namespace banch
@@ -0,0 +1,88 @@
+/// \file registry.cxx
+///
+/// \brief function definitions of registry.hxx
+
+#include "banch/registry.hxx"
+#include "banch/banch.hxx"
+
+#include <cassert>
+#include <cstring>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+// class IngredientRegistry //
+
+unsigned char const IngredientRegistry::NONE;
+
+IngredientRegistry & IngredientRegistry::instance()
+{
+	// constructed on first use, which C++11 makes thread-safe
+	static IngredientRegistry registry;
+	return registry;
+}
+
+IngredientRegistry::IngredientRegistry() : seed_(0)
+{
+	std::memset(this->byTag_, NONE, sizeof(this->byTag_));
+
+	this->add("beverage", BINARY_TAG_BEVERAGE, &makeIngredient<Beverage>);
+	this->add("extra", BINARY_TAG_EXTRA, &makeIngredient<Extra>);
+}
+
+bool IngredientRegistry::add(char const * keyword, std::uint8_t tag,
+								IngredientFactory factory)
+{
+	unsigned int size = std::strlen(keyword);
+	if (this->kinds_.size() == NONE || this->byTag_[tag] != NONE ||
+			(!this->kinds_.empty() && this->find(keyword, size) != nullptr))
+	{
+		return false;
+	}
+
+	Kind kind = { keyword, size, tag, factory };
+	this->byTag_[tag] = this->kinds_.size();
+	this->kinds_.push_back(kind);
+	this->rebuild();
+
+	return true;
+}
+
+void IngredientRegistry::rebuild()
+{
+	// start from a table twice the number of kinds, try a few seeds for each
+	// size, grow if none of them does it
+	unsigned int size = 1;
+	while (size < 2 * this->kinds_.size())
+	{
+		size *= 2;
+	}
+
+	for (;; size *= 2)
+	{
+		assert(size <= (1u << 16));
+		for (std::uint64_t seed = 0; seed < 64; ++seed)
+		{
+			this->byKeyword_.clear();
+			this->byKeyword_.resize(size, NONE);
+
+			bool perfect = true;
+			for (unsigned int k = 0; k < this->kinds_.size() && perfect; ++k)
+			{
+				unsigned char & slot = this->byKeyword_[
+					hash(this->kinds_[k].keyword, this->kinds_[k].keywordSize,
+							seed) & (size - 1)];
+				perfect = slot == NONE;
+				slot = k;
+			}
+
+			if (perfect)
+			{
+				this->seed_ = seed;
+				return;
+			}
+		}
+	}
+}
+
+} // namespace banch
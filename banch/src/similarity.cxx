@@ -0,0 +1,256 @@
+/// \file similarity.cxx
+///
+/// \brief function definitions of similarity.hxx
+
+#include "banch/similarity.hxx"
+#include "banch/ingredient_index.hxx"
+#include "nostl/hash_map.hxx"
+
+#include <atomic>
+#include <iomanip>
+#include <string>
+#include <thread>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+namespace {
+
+/// \brief a pair of Recipes (by position) similar enough to be clustered
+struct Link {
+	unsigned int lhs; ///< position of one Recipe
+	unsigned int rhs; ///< position of the other Recipe
+}; // struct Link
+
+/// \brief hash an ingredient into an element of the set a MinHash is over
+///
+/// \param ingredient to hash
+///
+/// \return hash of the normalized name (the fingerprint if there is none)
+std::uint64_t elementOf(Ingredient const & ingredient)
+{
+	IngredientValue value;
+	if (!ingredient.toValue(value))
+	{
+		return ingredient.fingerprint();
+	}
+	std::string name = IngredientIndex::normalize(value.name.data(),
+													value.name.size());
+	return nostl::hashBytes(name.data(), name.size());
+}
+
+/// \brief run a job on several threads, handing out work items one by one
+///
+/// \param items number of work items
+/// \param threads number of threads to run on (the caller is one of them)
+/// \param job called with every item number (from any of the threads)
+template <typename Job>
+void runParallel(unsigned int items, unsigned int threads, Job const & job)
+{
+	std::atomic<unsigned int> next(0);
+	auto work = [&]()
+	{
+		for (unsigned int k = next++; k < items; k = next++)
+		{
+			job(k);
+		}
+	};
+
+	nostl::Vector<std::thread> workers;
+	for (unsigned int k = 1; k < threads && k < items; ++k)
+	{
+		workers.emplace_back(work);
+	}
+	work();
+	for (unsigned int k = 0; k < workers.size(); ++k)
+	{
+		workers[k].join();
+	}
+}
+
+/// \brief find the representative of a cluster (halving the path to it)
+///
+/// \param parent union-find forest
+/// \param k element whose cluster to find
+///
+/// \return the representative
+unsigned int findRoot(nostl::Vector<unsigned int> & parent, unsigned int k)
+{
+	while (parent[k] != k)
+	{
+		parent[k] = parent[parent[k]];
+		k = parent[k];
+	}
+	return k;
+}
+
+} // namespace
+
+// struct MinHash //
+
+MinHash MinHash::of(Recipe const & recipe)
+{
+	MinHash signature;
+	for (unsigned int k = 0; k < SIZE; ++k)
+	{
+		signature.values[k] = ~0ULL;
+	}
+
+	// the hash functions are mix() of the element xor a seed of their own
+	for (unsigned int n = 1; n <= recipe.number_of_ingredients(); ++n)
+	{
+		std::uint64_t element = elementOf(recipe.getNth(n));
+		for (unsigned int k = 0; k < SIZE; ++k)
+		{
+			std::uint64_t hash = nostl::mix(element ^
+											(k + 1) * 0x9e3779b97f4a7c15ULL);
+			if (hash < signature.values[k])
+			{
+				signature.values[k] = hash;
+			}
+		}
+	}
+	return signature;
+}
+
+// class NearDuplicateFinder //
+
+nostl::Vector<nostl::Vector<Recipe *> >
+NearDuplicateFinder::clusters(RecipeBook & book) const
+{
+	// Recipes with ingredients, in book order
+	nostl::Vector<Recipe *> recipes;
+	for (unsigned int n = 1; n <= book.number_of_entries(); ++n)
+	{
+		if (book.getNth(n).number_of_ingredients() != 0)
+		{
+			recipes.push_back(&book.getNth(n));
+		}
+	}
+
+	// signatures, a chunk of Recipes at a time
+	static unsigned int const CHUNK = 4096;
+	nostl::Vector<MinHash> signatures(recipes.size());
+	runParallel((recipes.size() + CHUNK - 1) / CHUNK, this->threads_,
+		[&](unsigned int chunk)
+		{
+			for (unsigned int k = chunk * CHUNK;
+					k < recipes.size() && k < (chunk + 1) * CHUNK;
+					++k)
+			{
+				signatures[k] = MinHash::of(*recipes[k]);
+			}
+		});
+
+	// bucket every band on its own; a Recipe is compared to the ones in its
+	// bucket that weren't similar to an earlier one (the representatives,
+	// chained through next as positions plus one, 0 ends)
+	nostl::Vector<nostl::Vector<Link> > links(BANDS);
+	runParallel(BANDS, this->threads_,
+		[&](unsigned int band)
+		{
+			nostl::HashMap<std::uint64_t, unsigned int> latest;
+			nostl::Vector<unsigned int> next(recipes.size());
+			for (unsigned int k = 0; k < recipes.size(); ++k)
+			{
+				std::uint64_t key = band;
+				for (unsigned int row = 0; row < ROWS; ++row)
+				{
+					key = nostl::mix(key ^
+									signatures[k].values[band * ROWS + row]);
+				}
+
+				unsigned int & head = latest[key];
+				bool linked = false;
+				for (unsigned int j = head; j != 0 && !linked; j = next[j - 1])
+				{
+					if (signatures[j - 1].similarity(signatures[k]) >=
+							this->threshold_)
+					{
+						Link link = { j - 1, k };
+						links[band].push_back(link);
+						linked = true;
+					}
+				}
+				if (!linked)
+				{
+					next[k] = head;
+					head = k + 1;
+				}
+			}
+		});
+
+	// join the linked Recipes
+	nostl::Vector<unsigned int> parent(recipes.size());
+	for (unsigned int k = 0; k < recipes.size(); ++k)
+	{
+		parent[k] = k;
+	}
+	for (unsigned int band = 0; band < BANDS; ++band)
+	{
+		for (unsigned int k = 0; k < links[band].size(); ++k)
+		{
+			unsigned int lhs = findRoot(parent, links[band][k].lhs);
+			unsigned int rhs = findRoot(parent, links[band][k].rhs);
+
+			// the earlier Recipe stays the root, so roots come in book order
+			if (lhs < rhs)
+			{
+				parent[rhs] = lhs;
+			}
+			else if (rhs < lhs)
+			{
+				parent[lhs] = rhs;
+			}
+		}
+	}
+
+	// count the members of every cluster, then hand out the ones with more
+	// than one (a root comes before its members)
+	nostl::Vector<unsigned int> size(recipes.size(), 0);
+	for (unsigned int k = 0; k < recipes.size(); ++k)
+	{
+		++size[findRoot(parent, k)];
+	}
+
+	static unsigned int const NONE = ~0u;
+	nostl::Vector<unsigned int> clusterOf(recipes.size(), NONE);
+	nostl::Vector<nostl::Vector<Recipe *> > clusters;
+	for (unsigned int k = 0; k < recipes.size(); ++k)
+	{
+		unsigned int root = findRoot(parent, k);
+		if (size[root] < 2)
+		{
+			continue;
+		}
+		if (clusterOf[root] == NONE)
+		{
+			clusterOf[root] = clusters.size();
+			clusters.push_back(nostl::Vector<Recipe *>());
+		}
+		clusters[clusterOf[root]].push_back(recipes[k]);
+	}
+	return clusters;
+}
+
+unsigned int NearDuplicateFinder::report(std::ostream & os,
+											RecipeBook & book) const
+{
+	nostl::Vector<nostl::Vector<Recipe *> > found = this->clusters(book);
+	for (unsigned int k = 0; k < found.size(); ++k)
+	{
+		// how alike the others are to the first one
+		MinHash first = MinHash::of(*found[k][0]);
+		os << k + 1 << ") " << found[k][0]->getName() << '\n';
+		for (unsigned int i = 1; i < found[k].size(); ++i)
+		{
+			double similarity = first.similarity(MinHash::of(*found[k][i]));
+			os << "   " << found[k][i]->getName() << " (~" << std::fixed
+				<< std::setprecision(0) << similarity * 100 << "% alike)\n";
+		}
+	}
+	os << found.size() << " group(s) of near-duplicates" << std::endl;
+	return found.size();
+}
+
+} // namespace banch
@@ -0,0 +1,73 @@
+/// \file symbols.cxx
+///
+/// \brief function definitions of symbols.hxx
+
+#include "banch/symbols.hxx"
+
+#include <cctype>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+std::uint32_t const SymbolTable::NONE;
+
+// class SymbolTable //
+
+std::uint32_t SymbolTable::intern(char const * data, unsigned int size)
+{
+	std::uint32_t const * id =
+						this->ids_.find(nostl::CowString::view(data, size));
+	if (id != nullptr)
+	{
+		return *id;
+	}
+
+	nostl::CowString kept = nostl::CowString::view(
+							this->characters_.copy(data, size), size);
+	std::uint32_t fresh = this->names_.size();
+	this->names_.push_back(kept);
+	this->normalized_.push_back(fresh);
+	this->ids_.insert(kept, fresh);
+
+	// the normalized form of a normalized name is the name itself
+	std::string normal = normalize(data, size);
+	if (normal.size() != size || normal.compare(0, size, data, size) != 0)
+	{
+		std::uint32_t id = this->intern(normal.data(), normal.size());
+		this->normalized_[fresh] = id;
+	}
+	return fresh;
+}
+
+void SymbolTable::clear()
+{
+	this->ids_.clear();
+	this->names_.clear();
+	this->normalized_.clear();
+	this->characters_.release();
+}
+
+std::string SymbolTable::normalize(char const * data, unsigned int size)
+{
+	std::string normalized;
+	normalized.reserve(size);
+	bool space = false; // a space is due before the next word
+	for (unsigned int k = 0; k < size; ++k)
+	{
+		unsigned char c = data[k];
+		if (std::isspace(c))
+		{
+			space = !normalized.empty();
+			continue;
+		}
+		if (space)
+		{
+			normalized += ' ';
+			space = false;
+		}
+		normalized += static_cast<char>(std::tolower(c));
+	}
+	return normalized;
+}
+
+} // namespace banch
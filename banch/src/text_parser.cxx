@@ -0,0 +1,331 @@
+/// \file text_parser.cxx
+///
+/// \brief function definitions of text_parser.hxx
+
+#include "banch/text_parser.hxx"
+#include "banch/ingredient_index.hxx"
+
+#include <algorithm>
+#include <cstring>
+
+/// \brief namespace for the banch project
+namespace banch {
+
+namespace {
+
+/// \brief check whether a scanned line is a given keyword
+///
+/// \param line address of first character
+/// \param size number of characters
+/// \param keyword null terminated keyword
+///
+/// \return true if the line is the keyword
+bool isKeyword(char const * line, unsigned int size, char const * keyword)
+{
+	return size == std::strlen(keyword) && std::memcmp(line, keyword, size) == 0;
+}
+
+/// \brief the lines of a stream, read one at a time
+///
+/// Two buffers take turns, so a line stays valid while the next one is read
+/// (a Beverage needs its name and its quanta at the same time).
+class StreamLines {
+public:
+	/// \brief constructor
+	///
+	/// \param is stream to read
+	explicit StreamLines(std::istream & is) : is_(&is), current_(0) {}
+
+	/// \brief get the next line
+	///
+	/// \param line set to the address of the first character of the line
+	/// \param size set to the number of characters in the line
+	///
+	/// \return false if there are no more lines
+	bool next(char const * & line, unsigned int & size)
+	{
+		this->current_ ^= 1;
+		std::string & buffer = this->buffers_[this->current_];
+		if (!getline(*this->is_, buffer))
+		{
+			return false;
+		}
+		line = buffer.data();
+		size = buffer.size();
+		return true;
+	}
+
+	/// \brief get the stream
+	///
+	/// \return the stream the lines come from
+	std::istream & stream() { return *this->is_; }
+
+
+private:
+	std::istream * is_; ///< the stream
+	std::string buffers_[2]; ///< the last two lines
+	unsigned int current_; ///< buffer of the last line
+}; // class StreamLines
+
+/// \brief read the fields of an Ingredient from a scanner
+///
+/// \param ingredient to read into
+/// \param scanner to take the lines from
+void readFields(Ingredient & ingredient, LineScanner & scanner)
+{
+	ingredient.deserialize(scanner);
+}
+
+/// \brief read the fields of an Ingredient from a stream
+///
+/// \param ingredient to read into
+/// \param lines to take the stream from
+void readFields(Ingredient & ingredient, StreamLines & lines)
+{
+	ingredient.deserialize(lines.stream());
+}
+
+/// \brief push every record of some lines to a handler
+///
+/// \param lines to take the lines from (a LineScanner or StreamLines)
+/// \param handler to call
+///
+/// Goes through the records just like Recipe::deserialize() does, so a
+/// skipped record still has its fields read past (a field may well say
+/// "endrecipe").
+template <typename Lines>
+void parse(Lines & lines, TextHandler & handler)
+{
+	IngredientRegistry const & registry = IngredientRegistry::instance();
+	char const * line;
+	unsigned int size;
+	while (lines.next(line, size))
+	{
+		if (!isKeyword(line, size, "startrecipe"))
+		{
+			continue;
+		}
+		if (!lines.next(line, size))
+		{
+			return;
+		}
+		bool wanted = handler.recipeStart(nostl::CowString::view(line, size));
+
+		while (lines.next(line, size) && !isKeyword(line, size, "endrecipe"))
+		{
+			IngredientRegistry::Kind const * kind = registry.find(line, size);
+			if (kind == nullptr)
+			{
+				continue;
+			}
+
+			// the built-in kinds are read right off the lines
+			if (kind->tag == BINARY_TAG_BEVERAGE)
+			{
+				char const * name;
+				unsigned int nameSize;
+				if (lines.next(name, nameSize) && lines.next(line, size) &&
+						wanted)
+				{
+					handler.beverage(nostl::CowString::view(name, nameSize),
+										parseUnsigned(line, size));
+				}
+			}
+			else if (kind->tag == BINARY_TAG_EXTRA)
+			{
+				if (lines.next(line, size) && wanted)
+				{
+					handler.extra(nostl::CowString::view(line, size));
+				}
+			}
+			else
+			{
+				std::unique_ptr<Ingredient> ingredient(kind->factory());
+				readFields(*ingredient, lines);
+				if (wanted)
+				{
+					handler.ingredient(std::move(ingredient));
+				}
+			}
+		}
+
+		if (wanted)
+		{
+			handler.recipeEnd();
+		}
+	}
+}
+
+} // namespace
+
+void parseText(LineScanner & scanner, TextHandler & handler)
+{
+	parse(scanner, handler);
+}
+
+void parseText(std::istream & is, TextHandler & handler)
+{
+	StreamLines lines(is);
+	parse(lines, handler);
+}
+
+// class TextWriter //
+
+bool TextWriter::recipeStart(nostl::CowString const & name)
+{
+	*this->sink_ << "startrecipe\n" << name << '\n';
+	return true;
+}
+
+void TextWriter::beverage(nostl::CowString const & name, unsigned int quanta)
+{
+	*this->sink_ << "beverage\n" << name << '\n' << quanta << '\n';
+}
+
+void TextWriter::extra(nostl::CowString const & text)
+{
+	*this->sink_ << "extra\n" << text << '\n';
+}
+
+void TextWriter::ingredient(std::unique_ptr<Ingredient> ingredient)
+{
+	ingredient->serialize(*this->sink_);
+}
+
+void TextWriter::recipeEnd()
+{
+	*this->sink_ << "endrecipe\n";
+	++this->recipes_;
+}
+
+// class RecipeFilter //
+
+void RecipeFilter::require(std::string const & name)
+{
+	this->required_.push_back(IngredientIndex::normalize(name));
+}
+
+void RecipeFilter::exclude(std::string const & name)
+{
+	this->excluded_.push_back(IngredientIndex::normalize(name));
+}
+
+bool RecipeFilter::recipeStart(nostl::CowString const & name)
+{
+	// the name alone may rule a Recipe out, then it isn't even read
+	char const * end = name.data() + name.size();
+	if (!this->name_.empty() &&
+			std::search(name.data(), end, this->name_.begin(),
+						this->name_.end()) == end)
+	{
+		++this->dropped_;
+		return false;
+	}
+
+	this->current_.assign(name.data(), name.size());
+	this->held_.clear();
+	this->found_.clear();
+	this->found_.resize(this->required_.size(), false);
+	this->skipping_ = false;
+	return true;
+}
+
+void RecipeFilter::beverage(nostl::CowString const & name, unsigned int quanta)
+{
+	this->see(name);
+	if (!this->skipping_)
+	{
+		Held held = { IngredientValue::beverage(name.str(), quanta), nullptr };
+		this->held_.push_back(std::move(held));
+	}
+}
+
+void RecipeFilter::extra(nostl::CowString const & text)
+{
+	this->see(text);
+	if (!this->skipping_)
+	{
+		Held held = { IngredientValue::extra(text.str()), nullptr };
+		this->held_.push_back(std::move(held));
+	}
+}
+
+void RecipeFilter::ingredient(std::unique_ptr<Ingredient> ingredient)
+{
+	if (!this->skipping_)
+	{
+		Held held = { IngredientValue::extra(""), std::move(ingredient) };
+		this->held_.push_back(std::move(held));
+	}
+}
+
+void RecipeFilter::recipeEnd()
+{
+	bool match = !this->skipping_;
+	for (unsigned int k = 0; match && k < this->found_.size(); ++k)
+	{
+		match = this->found_[k];
+	}
+	if (!match)
+	{
+		++this->dropped_;
+		this->held_.clear();
+		return;
+	}
+
+	++this->passed_;
+	TextHandler & next = *this->next_;
+	if (next.recipeStart(nostl::CowString::view(this->current_.data(),
+												this->current_.size())))
+	{
+		for (unsigned int k = 0; k < this->held_.size(); ++k)
+		{
+			Held & held = this->held_[k];
+			if (held.other)
+			{
+				next.ingredient(std::move(held.other));
+			}
+			else if (held.value.kind == IngredientValue::BEVERAGE)
+			{
+				next.beverage(held.value.name, held.value.quanta);
+			}
+			else
+			{
+				next.extra(held.value.name);
+			}
+		}
+		next.recipeEnd();
+	}
+	this->held_.clear();
+}
+
+void RecipeFilter::see(nostl::CowString const & name)
+{
+	if (this->skipping_ ||
+			(this->required_.empty() && this->excluded_.empty()))
+	{
+		return;
+	}
+
+	std::string normalized = IngredientIndex::normalize(name.data(),
+														name.size());
+	for (unsigned int k = 0; k < this->excluded_.size(); ++k)
+	{
+		if (this->excluded_[k] == normalized)
+		{
+			// nothing more of it has to be held back
+			this->skipping_ = true;
+			this->held_.clear();
+			return;
+		}
+	}
+	for (unsigned int k = 0; k < this->required_.size(); ++k)
+	{
+		if (this->required_[k] == normalized)
+		{
+			this->found_[k] = true;
+		}
+	}
+}
+
+} // namespace banch
@@ -0,0 +1,76 @@
+#ifndef BANCH_BENCH_BENCH_HXX
+#define BANCH_BENCH_BENCH_HXX
+
+/// \file bench.hxx
+///
+/// \brief tiny helpers shared by the benchmarks
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/// \brief namespace for the benchmarks
+namespace bench {
+
+/// \brief stopwatch that starts when it's created
+class Stopwatch {
+public:
+	/// \brief constructor w/o parameters --- starts measuring
+	Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+	/// \brief get the time elapsed since construction
+	///
+	/// \return elapsed time in milliseconds
+	double ms() const
+	{
+		std::chrono::duration<double, std::milli> elapsed =
+									std::chrono::steady_clock::now() - start_;
+		return elapsed.count();
+	}
+
+
+private:
+	std::chrono::steady_clock::time_point start_; ///< time of construction
+}; // class Stopwatch
+
+/// \brief print one line of results
+///
+/// \param os stream to print into
+/// \param what name of the measurement
+/// \param ms time it took in milliseconds
+inline void report(std::ostream & os, std::string const & what, double ms)
+{
+	os << std::left << std::setw(40) << what
+		<< std::right << std::setw(10) << std::fixed << std::setprecision(2)
+		<< ms << " ms" << std::endl;
+}
+
+/// \brief print one line of results as a throughput
+///
+/// \param os stream to print into
+/// \param what name of the measurement
+/// \param bytes number of bytes processed
+/// \param ms time it took in milliseconds
+inline void reportRate(std::ostream & os, std::string const & what,
+						double bytes, double ms)
+{
+	os << std::left << std::setw(40) << what
+		<< std::right << std::setw(10) << std::fixed << std::setprecision(2)
+		<< bytes / 1e6 / (ms / 1e3) << " MB/s" << std::endl;
+}
+
+/// \brief keep the optimizer from throwing away a computed value
+///
+/// \param value to keep
+template <typename T>
+inline void keep(T const & value)
+{
+	static T volatile sink;
+	sink = value;
+	static_cast<void>(sink);
+}
+
+} // namespace bench
+
+#endif // BANCH_BENCH_BENCH_HXX
@@ -0,0 +1,101 @@
+/// \file bench_columns.cxx
+///
+/// \brief aggregate scans: walking the RecipeBook vs the ColumnarBook
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+#include "banch/columns.hxx"
+
+#include <string>
+
+/// \brief number of recipes in the book
+static unsigned int const N = 100000;
+
+/// \brief number of times every scan is repeated
+static unsigned int const REPEAT = 20;
+
+int main()
+{
+	static char const * const spirits[] = { "rum", "gin", "vodka", "tequila" };
+
+	banch::RecipeBook book;
+	for (unsigned int i = 0; i < N; ++i)
+	{
+		banch::Recipe * recipe = new banch::Recipe("recipe" + std::to_string(i));
+		recipe->add(new banch::Beverage(spirits[i % 4], i % 5 + 1));
+		recipe->add(new banch::Beverage("lime juice", 1));
+		for (unsigned int k = 0; k < i % 7; ++k)
+		{
+			recipe->add(new banch::Extra("ice"));
+		}
+		book.add(recipe);
+	}
+
+	banch::ColumnarBook * columns = nullptr;
+	{
+		bench::Stopwatch watch;
+		columns = new banch::ColumnarBook(book);
+		bench::report(std::cout, "ColumnarBook build", watch.ms());
+	}
+
+	// total units of rum
+	{
+		bench::Stopwatch watch;
+		for (unsigned int r = 0; r < REPEAT; ++r)
+		{
+			unsigned long long total = 0;
+			for (unsigned int i = 1; i <= book.number_of_entries(); ++i)
+			{
+				banch::Recipe & recipe = book.getNth(i);
+				for (unsigned int k = 1; k <= recipe.number_of_ingredients(); ++k)
+				{
+					banch::IngredientValue value;
+					if (recipe.getNth(k).toValue(value) &&
+							value.kind == banch::IngredientValue::BEVERAGE &&
+							value.name == "rum")
+					{
+						total += value.quanta;
+					}
+				}
+			}
+			bench::keep(total);
+		}
+		bench::report(std::cout, "RecipeBook total units of rum", watch.ms());
+	}
+	{
+		bench::Stopwatch watch;
+		for (unsigned int r = 0; r < REPEAT; ++r)
+		{
+			bench::keep(columns->totalQuanta("rum"));
+		}
+		bench::report(std::cout, "ColumnarBook total units of rum", watch.ms());
+	}
+
+	// recipes with more than 5 ingredients
+	{
+		bench::Stopwatch watch;
+		for (unsigned int r = 0; r < REPEAT; ++r)
+		{
+			unsigned int count = 0;
+			for (unsigned int i = 1; i <= book.number_of_entries(); ++i)
+			{
+				count += book.getNth(i).number_of_ingredients() > 5;
+			}
+			bench::keep(count);
+		}
+		bench::report(std::cout, "RecipeBook more than 5 ingredients", watch.ms());
+	}
+	{
+		bench::Stopwatch watch;
+		for (unsigned int r = 0; r < REPEAT; ++r)
+		{
+			bench::keep(columns->countRecipesWithMoreThan(5));
+		}
+		bench::report(std::cout, "ColumnarBook more than 5 ingredients",
+						watch.ms());
+	}
+
+	delete columns;
+	return 0;
+}
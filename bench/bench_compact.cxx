@@ -0,0 +1,94 @@
+/// \file bench_compact.cxx
+///
+/// \brief Recipe (heap ingredients, virtual calls) vs CompactRecipe (inline
+/// values, visitor): building and serializing
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+#include "banch/compact.hxx"
+
+#include <sstream>
+#include <string>
+
+/// \brief number of recipes built of each kind
+static unsigned int const N = 100000;
+
+int main()
+{
+	nostl::Vector<banch::Recipe *> recipes;
+	nostl::Vector<banch::CompactRecipe> compacts;
+
+	// build
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			banch::Recipe * recipe = new banch::Recipe("recipe");
+			recipe->add(new banch::Beverage("gin", 4));
+			recipe->add(new banch::Beverage("tonic water", 10));
+			recipe->add(new banch::Extra("ice"));
+			recipe->add(new banch::Extra("a slice of cucumber"));
+			recipes.push_back(recipe);
+		}
+		bench::report(std::cout, "Recipe build", watch.ms());
+	}
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			banch::CompactRecipe compact("recipe");
+			compact.add(banch::IngredientValue::beverage("gin", 4));
+			compact.add(banch::IngredientValue::beverage("tonic water", 10));
+			compact.add(banch::IngredientValue::extra("ice"));
+			compact.add(banch::IngredientValue::extra("a slice of cucumber"));
+			compacts.push_back(std::move(compact));
+		}
+		bench::report(std::cout, "CompactRecipe build", watch.ms());
+	}
+
+	// serialize
+	{
+		std::stringstream ss;
+		bench::Stopwatch watch;
+		{
+			nostl::Sink sink(ss);
+			for (unsigned int i = 0; i < N; ++i)
+			{
+				recipes[i]->serialize(sink);
+			}
+		}
+		bench::keep(ss.str().size());
+		bench::report(std::cout, "Recipe serialize", watch.ms());
+	}
+	{
+		std::stringstream ss;
+		bench::Stopwatch watch;
+		{
+			nostl::Sink sink(ss);
+			for (unsigned int i = 0; i < N; ++i)
+			{
+				compacts[i].serialize(sink);
+			}
+		}
+		bench::keep(ss.str().size());
+		bench::report(std::cout, "CompactRecipe serialize", watch.ms());
+	}
+
+	// teardown
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			delete recipes[i];
+		}
+		bench::report(std::cout, "Recipe teardown", watch.ms());
+	}
+	{
+		bench::Stopwatch watch;
+		compacts.clear();
+		bench::report(std::cout, "CompactRecipe teardown", watch.ms());
+	}
+
+	return 0;
+}
@@ -0,0 +1,59 @@
+/// \file bench_dedupe.cxx
+///
+/// \brief finding the duplicates in a book of a million Recipes
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+
+#include <string>
+
+/// \brief number of recipes in the book
+static unsigned int const N = 1000000;
+
+/// \brief number of distinct recipes (every one comes up N / DISTINCT times)
+static unsigned int const DISTINCT = 250000;
+
+int main()
+{
+	banch::RecipeBook book;
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			// the ingredients of the copies come in a different order
+			unsigned int k = i % DISTINCT;
+			banch::Recipe * recipe = new banch::Recipe(
+										"recipe" + std::to_string(k % 1000));
+			banch::Ingredient * ingredients[3] = {
+				new banch::Beverage("spirit" + std::to_string(k % 50), k % 7 + 1),
+				new banch::Beverage("mixer" + std::to_string(k / 1000), 4),
+				new banch::Extra("garnish" + std::to_string(k % 13))
+			};
+			for (unsigned int j = 0; j < 3; ++j)
+			{
+				recipe->add(ingredients[(i / DISTINCT + j) % 3]);
+			}
+			book.add(recipe);
+		}
+		bench::report(std::cout, "RecipeBook build", watch.ms());
+	}
+
+	{
+		bench::Stopwatch watch;
+		nostl::Vector<banch::Recipe *> duplicates = book.findDuplicates();
+		bench::keep(duplicates.size());
+		bench::report(std::cout, "find duplicates (" +
+						std::to_string(duplicates.size()) + " found)",
+						watch.ms());
+	}
+
+	{
+		bench::Stopwatch watch;
+		unsigned int removed = book.removeDuplicates();
+		bench::keep(removed);
+		bench::report(std::cout, "remove duplicates", watch.ms());
+	}
+
+	return 0;
+}
@@ -0,0 +1,185 @@
+/// \file bench_intern.cxx
+///
+/// \brief ingredient names owned by every Ingredient vs interned by the book:
+/// heap in use, comparing names and loading a book in arena mode
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+
+#include <cstdio>
+#include <malloc.h>
+#include <string>
+
+/// \brief number of recipes
+static unsigned int const N = 200000;
+
+/// \brief number of distinct ingredient names
+static unsigned int const NAMES = 64;
+
+/// \brief database file the arena book is loaded from
+static char const * const PATH = "bench_intern.tmp";
+
+/// \brief get the bytes of heap in use
+///
+/// \return bytes allocated and not freed
+static double heapInUse()
+{
+	return static_cast<double>(mallinfo2().uordblks);
+}
+
+/// \brief count the Beverages having the name of a given one
+///
+/// \param recipes to look at
+/// \param name Beverage to compare with (the first one of the first recipe)
+///
+/// \return number of equal names
+static unsigned int countSame(nostl::Vector<banch::Recipe *> const & recipes)
+{
+	banch::IngredientValue first;
+	recipes[0]->getNth(1).toValue(first);
+
+	unsigned int same = 0;
+	banch::IngredientValue value;
+	for (unsigned int k = 0; k < recipes.size(); ++k)
+	{
+		for (unsigned int j = 1; j <= recipes[k]->number_of_ingredients(); ++j)
+		{
+			recipes[k]->getNth(j).toValue(value);
+			same += value.name == first.name;
+		}
+	}
+	return same;
+}
+
+/// \brief count the Beverages having the name of a given one, by symbol
+///
+/// \param recipes to look at (in a book)
+///
+/// \return number of equal names
+static unsigned int countSameSymbol(
+								nostl::Vector<banch::Recipe *> const & recipes)
+{
+	banch::IngredientValue first;
+	recipes[0]->getNth(1).toValue(first);
+
+	unsigned int same = 0;
+	banch::IngredientValue value;
+	for (unsigned int k = 0; k < recipes.size(); ++k)
+	{
+		for (unsigned int j = 1; j <= recipes[k]->number_of_ingredients(); ++j)
+		{
+			recipes[k]->getNth(j).toValue(value);
+			same += value.symbol == first.symbol;
+		}
+	}
+	return same;
+}
+
+int main()
+{
+	// the names of a bar: long enough not to fit into a std::string itself
+	nostl::Vector<std::string> names;
+	for (unsigned int k = 0; k < NAMES; ++k)
+	{
+		names.push_back("freshly squeezed juice of fruit no. " +
+						std::to_string(k));
+	}
+
+	double const empty = heapInUse();
+	nostl::Vector<banch::Recipe *> recipes;
+	for (unsigned int i = 0; i < N; ++i)
+	{
+		banch::Recipe * recipe = new banch::Recipe("recipe " +
+													std::to_string(i));
+		recipe->add(new banch::Beverage(names[i % NAMES], 4));
+		recipe->add(new banch::Beverage(names[(i * 7 + 1) % NAMES], 10));
+		recipe->add(new banch::Beverage(names[(i * 13 + 2) % NAMES], 2));
+		recipe->add(new banch::Extra(names[(i * 31 + 3) % NAMES]));
+		recipes.push_back(recipe);
+	}
+	double const owned = heapInUse() - empty;
+
+	{
+		bench::Stopwatch watch;
+		unsigned int same = 0;
+		for (unsigned int r = 0; r < 10; ++r)
+		{
+			same += countSame(recipes);
+		}
+		bench::keep(same);
+		bench::report(std::cout, "compare names, owned", watch.ms());
+	}
+
+	// what the index of a book takes, to leave it out below
+	double index;
+	{
+		nostl::Vector<banch::Recipe *> bare;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			bare.push_back(new banch::Recipe("recipe " + std::to_string(i)));
+		}
+		banch::RecipeBook other;
+		double const unindexed = heapInUse();
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			other.add(bare[i]);
+		}
+		index = heapInUse() - unindexed;
+	}
+
+	// adding them to a book interns the names
+	banch::RecipeBook book;
+	double const before = heapInUse();
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			book.add(recipes[i]);
+		}
+		bench::report(std::cout, "add to a book (interning)", watch.ms());
+	}
+	double const interned = owned + heapInUse() - before - index;
+
+	{
+		bench::Stopwatch watch;
+		unsigned int same = 0;
+		for (unsigned int r = 0; r < 10; ++r)
+		{
+			same += countSame(recipes);
+		}
+		bench::keep(same);
+		bench::report(std::cout, "compare names, interned", watch.ms());
+	}
+
+	{
+		bench::Stopwatch watch;
+		unsigned int same = 0;
+		for (unsigned int r = 0; r < 10; ++r)
+		{
+			same += countSameSymbol(recipes);
+		}
+		bench::keep(same);
+		bench::report(std::cout, "compare symbols", watch.ms());
+	}
+
+	// a book in arena mode interns what it loads instead of copying it
+	book.save(PATH);
+	double loaded;
+	{
+		banch::RecipeBook arena(banch::RecipeBook::ARENA);
+		double const unloaded = heapInUse();
+		bench::Stopwatch watch;
+		arena.load(PATH, 4);
+		bench::report(std::cout, "load into an arena", watch.ms());
+		loaded = heapInUse() - unloaded;
+	}
+	std::remove(PATH);
+
+	std::cout << "recipes with owned names      " << owned / 1e6 << " MB\n"
+				<< "recipes with interned names   " << interned / 1e6
+				<< " MB\n"
+				<< "recipes loaded into an arena  " << loaded / 1e6
+				<< " MB" << std::endl;
+	return 0;
+}
@@ -0,0 +1,70 @@
+/// \file bench_inventory.cxx
+///
+/// \brief "what can I make" on a book of a million Recipes
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+#include "banch/inventory.hxx"
+
+#include <string>
+
+/// \brief number of recipes in the book
+static unsigned int const N = 1000000;
+
+/// \brief number of distinct ingredient names
+static unsigned int const NAMES = 2000;
+
+int main()
+{
+	banch::RecipeBook book;
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			banch::Recipe * recipe = new banch::Recipe("recipe");
+			recipe->add(new banch::Beverage(
+							"spirit" + std::to_string(i % 50), i % 5 + 1));
+			recipe->add(new banch::Beverage(
+							"mixer" + std::to_string(i * 7 % NAMES), 4));
+			recipe->add(new banch::Extra(
+							"garnish" + std::to_string(i * 13 % NAMES)));
+			book.add(recipe);
+		}
+		bench::report(std::cout, "RecipeBook build", watch.ms());
+	}
+
+	banch::InventoryMatcher * matcher = nullptr;
+	{
+		bench::Stopwatch watch;
+		matcher = new banch::InventoryMatcher(book);
+		bench::report(std::cout, "InventoryMatcher build", watch.ms());
+	}
+
+	// a bar that has every spirit, but only some of the rest
+	nostl::Vector<banch::Stock> inventory;
+	for (unsigned int k = 0; k < 50; ++k)
+	{
+		banch::Stock stock = { "spirit" + std::to_string(k), 20 };
+		inventory.push_back(stock);
+	}
+	for (unsigned int k = 0; k < NAMES; k += 3)
+	{
+		banch::Stock mixer = { "mixer" + std::to_string(k), 40 };
+		banch::Stock garnish = { "garnish" + std::to_string(k), 1 };
+		inventory.push_back(mixer);
+		inventory.push_back(garnish);
+	}
+
+	{
+		bench::Stopwatch watch;
+		nostl::Vector<banch::Makeable> makeable = matcher->makeable(inventory);
+		bench::keep(makeable.size());
+		bench::report(std::cout, "what can I make (" +
+						std::to_string(makeable.size()) + " found)",
+						watch.ms());
+	}
+
+	delete matcher;
+	return 0;
+}
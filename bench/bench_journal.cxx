@@ -0,0 +1,73 @@
+/// \file bench_journal.cxx
+///
+/// \brief saving one edit of a book of a million Recipes: a full rewrite
+/// against a journal commit
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+#include "banch/journal.hxx"
+
+#include <cstdio>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/// \brief number of recipes in the book
+static unsigned int const N = 1000000;
+
+/// \brief snapshot the journal follows
+static char const * const PATH = "bench_journal.tmp";
+
+int main()
+{
+	banch::RecipeBook book;
+	banch::Journal journal(book);
+	if (!journal.open(PATH))
+	{
+		std::cerr << "Could not open journal of " << PATH << std::endl;
+		return 1;
+	}
+
+	for (unsigned int i = 0; i < N; ++i)
+	{
+		banch::Recipe * recipe = new banch::Recipe("recipe" + std::to_string(i));
+		recipe->add(new banch::Beverage("spirit" + std::to_string(i % 50),
+										i % 7 + 1));
+		recipe->add(new banch::Extra("garnish" + std::to_string(i % 13)));
+		book.add(recipe);
+	}
+	{
+		bench::Stopwatch watch;
+		journal.commit();
+		bench::report(std::cout, "first commit (snapshot)", watch.ms());
+	}
+
+	{
+		bench::Stopwatch watch;
+		int fd = ::open(PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		{
+			nostl::Sink sink(fd);
+			book.serializeBinary(sink);
+		}
+		::fsync(fd);
+		::close(fd);
+		bench::report(std::cout, "full rewrite", watch.ms());
+	}
+	journal.compact();
+
+	{
+		bench::Stopwatch watch;
+		for (unsigned int k = 1; k <= 100; ++k)
+		{
+			book.getNth(k * 1000).add(new banch::Extra("ice"));
+			journal.commit();
+		}
+		bench::report(std::cout, "100 commits of one edit", watch.ms());
+	}
+
+	std::remove(PATH);
+	std::remove((std::string(PATH) + ".journal").c_str());
+	return 0;
+}
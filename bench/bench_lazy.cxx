@@ -0,0 +1,76 @@
+/// \file bench_lazy.cxx
+///
+/// \brief looking at a few Recipes of a big database: loading it all vs
+/// opening it lazily
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+#include "banch/lazy_book.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/// \brief number of recipes in the generated database
+static unsigned int const N = 1000000;
+
+/// \brief number of recipes looked at
+static unsigned int const LOOKS = 100;
+
+/// \brief file the generated database is written to
+static char const * const PATH = "bench_lazy.tmp";
+
+int main()
+{
+	// generate the database
+	{
+		banch::RecipeBook book;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			banch::Recipe * recipe = new banch::Recipe("recipe " +
+														std::to_string(i));
+			recipe->add(new banch::Beverage("gin " + std::to_string(i), 4));
+			recipe->add(new banch::Beverage("tonic water", 10 + i % 7));
+			recipe->add(new banch::Extra("a slice of cucumber, "
+											"cut rather thin"));
+			book.add(recipe);
+		}
+
+		std::ofstream ofs(PATH);
+		book.serialize(ofs);
+	}
+
+	// build everything, then look
+	{
+		bench::Stopwatch watch;
+		banch::RecipeBook book;
+		book.load(PATH);
+		unsigned int ingredients = 0;
+		for (unsigned int k = 0; k < LOOKS; ++k)
+		{
+			ingredients += book.findByName("recipe " + std::to_string(k * 9973))
+											->number_of_ingredients();
+		}
+		bench::keep(ingredients);
+		bench::report(std::cout, "load, then look at 100", watch.ms());
+	}
+
+	// only index, build what's looked at
+	{
+		bench::Stopwatch watch;
+		banch::LazyBook book;
+		book.open(PATH);
+		unsigned int ingredients = 0;
+		for (unsigned int k = 0; k < LOOKS; ++k)
+		{
+			ingredients += book.findByName("recipe " + std::to_string(k * 9973))
+											->number_of_ingredients();
+		}
+		bench::keep(ingredients);
+		bench::report(std::cout, "open lazily, then look at 100", watch.ms());
+	}
+
+	std::remove(PATH);
+	return 0;
+}
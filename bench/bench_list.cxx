@@ -0,0 +1,81 @@
+/// \file bench_list.cxx
+///
+/// \brief List vs UnrolledList: append, traversal and remove
+
+#include "bench.hxx"
+
+#include "nostl/list.hxx"
+#include "nostl/unrolled_list.hxx"
+
+/// \brief number of elements the containers are filled with
+static unsigned int const N = 1000000;
+
+/// \brief number of removals from the middle of the containers
+static unsigned int const MIDDLE_REMOVALS = 1000;
+
+/// \brief run all measurements on one container type
+///
+/// \tparam Container List or UnrolledList of longs
+///
+/// \param name to print in front of the results
+template <typename Container>
+void run(std::string const & name)
+{
+	Container container;
+
+	// append
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			container.append(static_cast<long>(i));
+		}
+		bench::report(std::cout, name + " append", watch.ms());
+	}
+
+	// traversal (a few rounds so it isn't dominated by cold caches)
+	{
+		bench::Stopwatch watch;
+		long sum = 0;
+		for (unsigned int round = 0; round < 10; ++round)
+		{
+			for (typename Container::Iterator i = container.begin();
+					i != container.end(); ++i)
+			{
+				sum += *i;
+			}
+		}
+		bench::keep(sum);
+		bench::report(std::cout, name + " traversal x10", watch.ms());
+	}
+
+	// remove from the middle (linear search for each)
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < MIDDLE_REMOVALS; ++i)
+		{
+			container.remove(static_cast<long>(N / 2 + i));
+		}
+		bench::report(std::cout, name + " remove (middle, 1000)", watch.ms());
+	}
+
+	// remove everything front to back
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			container.remove(static_cast<long>(i));
+		}
+		bench::report(std::cout, name + " remove (front, all)", watch.ms());
+	}
+}
+
+int main()
+{
+	std::cout << N << " longs" << std::endl;
+	run<nostl::List<long, nostl::HeapAllocator> >("List (heap)");
+	run<nostl::List<long> >("List (pool)");
+	run<nostl::UnrolledList<long> >("UnrolledList");
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+/// \file bench_load.cxx
+///
+/// \brief loading a big text database: stream vs mapping, 1..n threads
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+/// \brief number of recipes in the generated database
+static unsigned int const N = 200000;
+
+/// \brief file the generated database is written to
+static char const * const PATH = "bench_load.tmp";
+
+int main()
+{
+	// generate the database
+	{
+		banch::RecipeBook book;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			banch::Recipe * recipe = new banch::Recipe("recipe " +
+														std::to_string(i));
+			recipe->add(new banch::Beverage("gin " + std::to_string(i), 4));
+			recipe->add(new banch::Beverage("tonic water", 10 + i % 7));
+			recipe->add(new banch::Extra("a slice of cucumber, "
+											"cut rather thin"));
+			book.add(recipe);
+		}
+
+		std::ofstream ofs(PATH);
+		book.serialize(ofs);
+	}
+
+	// the old way: std::getline into fresh strings
+	{
+		bench::Stopwatch watch;
+		banch::RecipeBook book;
+		std::ifstream ifs(PATH);
+		book.deserialize(ifs);
+		bench::keep(book.number_of_entries());
+		bench::report(std::cout, "stream deserialize", watch.ms());
+	}
+
+	// mapped, with more and more threads
+	unsigned int cores = std::thread::hardware_concurrency();
+	for (unsigned int threads = 1; threads <= (cores < 8 ? 8 : cores);
+			threads *= 2)
+	{
+		bench::Stopwatch watch;
+		banch::RecipeBook book;
+		book.load(PATH, threads);
+		bench::keep(book.number_of_entries());
+		bench::report(std::cout, "mapped load, " + std::to_string(threads) +
+									" thread(s)", watch.ms());
+	}
+
+	std::remove(PATH);
+
+	return 0;
+}
@@ -0,0 +1,146 @@
+/// \file bench_scan.cxx
+///
+/// \brief throughput of parsing the text format: iostream vs the line
+/// scanner, from splitting lines to building whole books
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+/// \brief number of recipes in the generated database
+static unsigned int const N = 200000;
+
+/// \brief number of times each measurement is repeated
+static unsigned int const ROUNDS = 5;
+
+int main()
+{
+	// generate the database, in memory
+	std::string text;
+	{
+		banch::RecipeBook book;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			banch::Recipe * recipe = new banch::Recipe("recipe " +
+														std::to_string(i));
+			recipe->add(new banch::Beverage("gin " + std::to_string(i), 4));
+			recipe->add(new banch::Beverage("tonic water", 10 + i % 7));
+			recipe->add(new banch::Extra("lime"));
+			book.add(recipe);
+		}
+
+		std::stringstream ss;
+		book.serialize(ss);
+		text = ss.str();
+	}
+	double const bytes = static_cast<double>(text.size()) * ROUNDS;
+	std::cout << "scanning with blocks of " << banch::LineScanner::BLOCK
+				<< " bytes" << std::endl;
+
+	// splitting lines
+	{
+		bench::Stopwatch watch;
+		unsigned int lines = 0;
+		for (unsigned int r = 0; r < ROUNDS; ++r)
+		{
+			std::istringstream iss(text);
+			std::string line;
+			while (getline(iss, line))
+			{
+				++lines;
+			}
+		}
+		bench::keep(lines);
+		bench::reportRate(std::cout, "lines: std::getline", bytes, watch.ms());
+	}
+	{
+		bench::Stopwatch watch;
+		unsigned int lines = 0;
+		for (unsigned int r = 0; r < ROUNDS; ++r)
+		{
+			char const * current = text.data();
+			char const * end = current + text.size();
+			while (current != end)
+			{
+				char const * newline = static_cast<char const *>(
+									std::memchr(current, '\n', end - current));
+				current = newline == nullptr ? end : newline + 1;
+				++lines;
+			}
+		}
+		bench::keep(lines);
+		bench::reportRate(std::cout, "lines: memchr each", bytes, watch.ms());
+	}
+	{
+		bench::Stopwatch watch;
+		unsigned int lines = 0;
+		for (unsigned int r = 0; r < ROUNDS; ++r)
+		{
+			banch::LineScanner scanner(text.data(), text.data() + text.size());
+			char const * line;
+			unsigned int size;
+			while (scanner.next(line, size))
+			{
+				++lines;
+			}
+		}
+		bench::keep(lines);
+		bench::reportRate(std::cout, "lines: LineScanner", bytes, watch.ms());
+	}
+
+	// quantities
+	{
+		bench::Stopwatch watch;
+		unsigned int sum = 0;
+		for (unsigned int r = 0; r < ROUNDS * N; ++r)
+		{
+			std::istringstream iss("  1234");
+			unsigned int quanta;
+			iss >> quanta;
+			sum += quanta;
+		}
+		bench::keep(sum);
+		bench::report(std::cout, "quantities: operator>>", watch.ms());
+	}
+	{
+		bench::Stopwatch watch;
+		unsigned int sum = 0;
+		char const * volatile digits = "  1234";
+		for (unsigned int r = 0; r < ROUNDS * N; ++r)
+		{
+			sum += banch::parseUnsigned(digits, 6);
+		}
+		bench::keep(sum);
+		bench::report(std::cout, "quantities: parseUnsigned", watch.ms());
+	}
+
+	// whole books
+	{
+		bench::Stopwatch watch;
+		for (unsigned int r = 0; r < ROUNDS; ++r)
+		{
+			std::istringstream iss(text);
+			banch::RecipeBook book;
+			book.deserialize(iss);
+			bench::keep(book.number_of_entries());
+		}
+		bench::reportRate(std::cout, "book: std::istream", bytes, watch.ms());
+	}
+	{
+		bench::Stopwatch watch;
+		for (unsigned int r = 0; r < ROUNDS; ++r)
+		{
+			banch::LineScanner scanner(text.data(), text.data() + text.size());
+			banch::RecipeBook book;
+			book.deserialize(scanner);
+			bench::keep(book.number_of_entries());
+		}
+		bench::reportRate(std::cout, "book: LineScanner", bytes, watch.ms());
+	}
+
+	return 0;
+}
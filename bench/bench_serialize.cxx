@@ -0,0 +1,95 @@
+/// \file bench_serialize.cxx
+///
+/// \brief saving a big book: a flush per line vs a Sink on the descriptor
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/// \brief number of recipes in the book (4 lines of ingredients each)
+static unsigned int const N = 250000;
+
+/// \brief file the book is saved to
+static char const * const PATH = "bench_serialize.tmp";
+
+/// \brief file buffer that counts how often it's synced (once per std::endl,
+/// each being a write(2) of the line)
+class CountingFilebuf : public std::filebuf {
+public:
+	/// \brief number of syncs so far
+	unsigned long syncs = 0;
+
+protected:
+	/// \brief count, then sync
+	///
+	/// \return result of std::filebuf::sync
+	int sync() override
+	{
+		++this->syncs;
+		return std::filebuf::sync();
+	}
+}; // class CountingFilebuf
+
+int main()
+{
+	banch::RecipeBook book;
+	for (unsigned int i = 0; i < N; ++i)
+	{
+		banch::Recipe * recipe = new banch::Recipe("recipe " +
+													std::to_string(i));
+		recipe->add(new banch::Beverage("vodka", 4));
+		recipe->add(new banch::Beverage("orange juice " + std::to_string(i),
+										12));
+		recipe->add(new banch::Extra("ice"));
+		recipe->add(new banch::Extra("an orange slice"));
+		book.add(recipe);
+	}
+
+	// before: every line ended with std::endl, i.e. a flush
+	std::string text;
+	{
+		std::stringstream ss;
+		book.serialize(ss);
+		text = ss.str();
+	}
+	{
+		bench::Stopwatch watch;
+		CountingFilebuf buffer;
+		buffer.open(PATH, std::ios::out | std::ios::trunc);
+		std::ostream os(&buffer);
+		std::istringstream lines(text);
+		std::string line;
+		while (std::getline(lines, line))
+		{
+			os << line << std::endl;
+		}
+		buffer.close();
+		bench::report(std::cout, "std::endl per line (" +
+						std::to_string(buffer.syncs) + " writes)", watch.ms());
+	}
+
+	// after: a Sink straight on the descriptor
+	{
+		bench::Stopwatch watch;
+		int fd = ::open(PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		nostl::Sink sink(fd);
+		book.serialize(sink);
+		sink.flush();
+		::close(fd);
+		bench::report(std::cout, "Sink on descriptor (" +
+						std::to_string(sink.writes()) + " writes)", watch.ms());
+	}
+
+	std::cout << text.size() / 1024 / 1024 << " MiB each" << std::endl;
+	std::remove(PATH);
+
+	return 0;
+}
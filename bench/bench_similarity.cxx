@@ -0,0 +1,66 @@
+/// \file bench_similarity.cxx
+///
+/// \brief clustering the near-duplicates of a book of a million Recipes
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+#include "banch/similarity.hxx"
+
+#include <string>
+#include <thread>
+
+/// \brief number of recipes in the book
+static unsigned int const N = 1000000;
+
+/// \brief number of recipes every family of near-duplicates has
+static unsigned int const FAMILY = 4;
+
+int main()
+{
+	banch::RecipeBook book;
+	{
+		bench::Stopwatch watch;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			// members of a family share all but one of their ingredients
+			unsigned int family = i / FAMILY;
+			banch::Recipe * recipe = new banch::Recipe(
+										"recipe" + std::to_string(family));
+			for (unsigned int k = 0; k < 6; ++k)
+			{
+				recipe->add(new banch::Beverage("spirit" +
+							std::to_string(family) + '/' + std::to_string(k),
+							k + 1));
+			}
+			recipe->add(new banch::Extra("garnish" + std::to_string(i)));
+			book.add(recipe);
+		}
+		bench::report(std::cout, "RecipeBook build", watch.ms());
+	}
+
+	{
+		bench::Stopwatch watch;
+		std::uint64_t sum = 0;
+		for (unsigned int n = 1; n <= book.number_of_entries(); ++n)
+		{
+			sum += banch::MinHash::of(book.getNth(n)).values[0];
+		}
+		bench::keep(sum);
+		bench::report(std::cout, "MinHash signatures", watch.ms());
+	}
+
+	unsigned int threads = std::thread::hardware_concurrency();
+	for (unsigned int t = 1; t <= (threads == 0 ? 1 : threads); t *= 2)
+	{
+		bench::Stopwatch watch;
+		nostl::Vector<nostl::Vector<banch::Recipe *> > clusters =
+							banch::NearDuplicateFinder(0.5, t).clusters(book);
+		bench::keep(clusters.size());
+		bench::report(std::cout, "near-duplicates, " + std::to_string(t) +
+						" thread(s) (" + std::to_string(clusters.size()) +
+						" groups)", watch.ms());
+	}
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+/// \file bench_stream.cxx
+///
+/// \brief filtering a big database: loading a book and saving what matches vs
+/// streaming it through the push parser
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+#include "banch/text_parser.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+/// \brief number of recipes in the generated database
+static unsigned int const N = 1000000;
+
+/// \brief file the generated database is written to
+static char const * const PATH = "bench_stream.tmp";
+
+/// \brief file the filtered database is written to
+static char const * const OUT = "bench_stream.out.tmp";
+
+int main()
+{
+	// generate the database
+	{
+		banch::RecipeBook book;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			banch::Recipe * recipe = new banch::Recipe("recipe " +
+														std::to_string(i));
+			recipe->add(new banch::Beverage(i % 3 == 0 ? "gin" : "rum", 4));
+			recipe->add(new banch::Beverage("tonic water", 10 + i % 7));
+			recipe->add(new banch::Extra("a slice of cucumber, "
+											"cut rather thin"));
+			book.add(recipe);
+		}
+
+		std::ofstream ofs(PATH);
+		book.serialize(ofs);
+	}
+
+	// build everything, save what matches
+	{
+		bench::Stopwatch watch;
+		banch::RecipeBook book;
+		book.load(PATH);
+		std::ofstream ofs(OUT);
+		nostl::Sink sink(ofs);
+		unsigned int kept = 0;
+		for (unsigned int k = 1; k <= book.number_of_entries(); ++k)
+		{
+			banch::Recipe & recipe = book.getNth(k);
+			banch::IngredientValue value;
+			bool gin = false;
+			for (unsigned int j = 1; j <= recipe.number_of_ingredients(); ++j)
+			{
+				gin = gin || (recipe.getNth(j).toValue(value) &&
+								value.name == "gin");
+			}
+			if (gin)
+			{
+				recipe.serialize(sink);
+				++kept;
+			}
+		}
+		sink.flush();
+		bench::keep(kept);
+		bench::report(std::cout, "load, save the matching ones", watch.ms());
+	}
+
+	// stream the text through a filter, nothing is built
+	{
+		bench::Stopwatch watch;
+		banch::MappedFile file;
+		file.open(PATH);
+		std::ofstream ofs(OUT);
+		nostl::Sink sink(ofs);
+		banch::TextWriter writer(sink);
+		banch::RecipeFilter filter(writer);
+		filter.require("gin");
+		banch::LineScanner scanner(file.data(), file.data() + file.size());
+		banch::parseText(scanner, filter);
+		sink.flush();
+		bench::keep(filter.passed());
+		bench::report(std::cout, "stream through a filter", watch.ms());
+	}
+
+	std::remove(PATH);
+	std::remove(OUT);
+	return 0;
+}
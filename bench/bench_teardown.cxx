@@ -0,0 +1,68 @@
+/// \file bench_teardown.cxx
+///
+/// \brief loading and clearing a book of a million Recipes, on the heap and in
+/// arenas
+
+#include "bench.hxx"
+
+#include "banch/banch.hxx"
+
+#include <sstream>
+#include <string>
+
+/// \brief number of recipes in the book
+static unsigned int const N = 1000000;
+
+/// \brief load the text into a book, then clear it (twice, like a reload)
+///
+/// \param text serialized book
+/// \param memory where the book keeps its Recipes
+/// \param what name of the book in the report
+void run(std::string const & text, banch::RecipeBook::Memory memory,
+			std::string const & what)
+{
+	banch::RecipeBook book(memory);
+	for (unsigned int round = 0; round < 2; ++round)
+	{
+		{
+			bench::Stopwatch watch;
+			banch::LineScanner scanner(text.data(), text.data() + text.size());
+			book.deserialize(scanner);
+			bench::keep(book.number_of_entries());
+			bench::report(std::cout, what + " load", watch.ms());
+		}
+
+		{
+			bench::Stopwatch watch;
+			book.clear();
+			bench::report(std::cout, what + " clear", watch.ms());
+		}
+	}
+}
+
+int main()
+{
+	std::string text;
+	{
+		banch::RecipeBook book;
+		for (unsigned int i = 0; i < N; ++i)
+		{
+			banch::Recipe * recipe = new banch::Recipe(
+											"recipe" + std::to_string(i));
+			recipe->add(new banch::Beverage("spirit" + std::to_string(i % 50),
+											i % 7 + 1));
+			recipe->add(new banch::Beverage("mixer" + std::to_string(i % 100),
+											4));
+			recipe->add(new banch::Extra("garnish" + std::to_string(i % 13)));
+			book.add(recipe);
+		}
+		std::stringstream ss;
+		book.serialize(ss);
+		text = ss.str();
+	}
+
+	run(text, banch::RecipeBook::HEAP, "heap");
+	run(text, banch::RecipeBook::ARENA, "arena");
+
+	return 0;
+}
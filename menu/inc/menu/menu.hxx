@@ -8,6 +8,7 @@
 #include <iostream>
 #include <string>
 #include <functional>
+#include <utility>
 #include <sstream>
 
 #include "nostl/list.hxx"
@@ -32,8 +33,11 @@ public:
 	///
 	/// \param name name of the option
 	/// \param fnctn function to execute when option is selected
-	inline Option(string const name, std::function<void()> const & fnctn)
-		: name_(name), function_(fnctn) {}
+	///
+	/// \note both parameters are taken by value and moved into the Option, so
+	/// passing temporaries doesn't copy the string or the function object
+	inline Option(string name, std::function<void()> fnctn)
+		: name_(std::move(name)), function_(std::move(fnctn)) {}
 
 	/// \brief overloaded inserter operator
 	///
@@ -65,13 +69,18 @@ public:
 	///
 	/// \note the constructor automatically adds an exit option
 	inline Menu(std::ostream & os, std::istream & is)
-		: os_(os), is_(is) { this->add(std::move(Option("exit menu"))); }
+		: os_(os), is_(is) { this->add(Option("exit menu")); }
 
 	/// \brief add option to the menu
 	///
-	/// \param option to add (use std::move)
+	/// \param option to add
 	inline void add(Option const & opt) { this->options_.append(opt); }
 
+	/// \brief add option to the menu by moving it in
+	///
+	/// \param option to add
+	inline void add(Option && opt) { this->options_.append(std::move(opt)); }
+
 	/// \brief get number of option entries in the menu
 	///
 	/// \return number of entries
@@ -0,0 +1,480 @@
+#ifndef BANCH_NOSTL_ALLOCATOR_HXX
+#define BANCH_NOSTL_ALLOCATOR_HXX
+
+/// \file allocator.hxx
+///
+/// \brief allocator policies for the node based containers, storage policies
+/// for the array based ones and a monotonic arena
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief allocator policy that gives every object its own heap block
+///
+/// \tparam T type of objects to allocate storage for
+///
+/// This is what the containers used to do with plain new and delete. It is
+/// kept around for the cases where the pool would waste memory (e.g. lots of
+/// tiny containers that are never filled).
+template <typename T>
+class HeapAllocator {
+public:
+	/// \brief get uninitialized storage for one object
+	///
+	/// \return address of the storage
+	inline T * allocate() { return static_cast<T *>(::operator new(sizeof(T))); }
+
+	/// \brief give back storage obtained by allocate()
+	///
+	/// \param address of the storage (the object must already be destroyed)
+	inline void deallocate(T * p) { ::operator delete(p); }
+
+	/// \brief swap the state of two allocators (there is none)
+	inline void swap(HeapAllocator &) {}
+}; // class HeapAllocator
+
+
+/// \brief allocator policy that carves objects out of big blocks
+///
+/// \tparam T type of objects to allocate storage for
+///
+/// Storage is handed out from the current block with a bump pointer, freed
+/// objects go onto a free list and are recycled before touching the block
+/// again. Blocks grow geometrically, so a container with a handful of elements
+/// stays small and a huge one only calls operator new a few dozen times. All
+/// blocks are given back at once when the allocator dies. Blocks are aligned
+/// to what T asks for, even if that's more than operator new guarantees (e.g.
+/// cache line aligned types).
+///
+/// \note copying an allocator does not share or copy the pool, the new
+/// instance simply starts with a pool of its own
+template <typename T>
+class PoolAllocator {
+public:
+	/// \brief constructor w/o parameters --- doesn't allocate anything yet
+	inline PoolAllocator();
+
+	/// \brief copy constructor (creates an empty pool)
+	inline PoolAllocator(PoolAllocator const &) : PoolAllocator() {}
+
+	/// \brief assignment operator (keeps the pool of *this*)
+	///
+	/// \return the allocator itself
+	inline PoolAllocator & operator=(PoolAllocator const &) { return *this; }
+
+
+	/// \brief get uninitialized storage for one object
+	///
+	/// \return address of the storage
+	inline T * allocate();
+
+	/// \brief give back storage obtained by allocate()
+	///
+	/// \param address of the storage (the object must already be destroyed)
+	inline void deallocate(T *);
+
+	/// \brief swap the pools of two allocators
+	///
+	/// \param allocator to swap with
+	inline void swap(PoolAllocator &);
+
+
+	/// \brief destructor (frees all blocks)
+	inline ~PoolAllocator();
+
+
+private:
+	/// \brief a piece of a block: either a free list link or an object
+	union Slot {
+		Slot * next_; ///< next free Slot (or next block in a block header)
+		alignas(T) unsigned char storage_[sizeof(T)]; ///< the object itself
+	};
+
+	/// \brief get a new block from the heap and make it the current one
+	inline void grow();
+
+private:
+	static unsigned int const first_block_size_ = 8; ///< Slots in 1st block
+	static unsigned int const max_block_size_ = 4096; ///< upper limit
+
+	Slot * blocks_; ///< most recent block, the first Slot links the previous
+	Slot * free_; ///< head of the free list
+	Slot * bump_; ///< next never used Slot in the current block
+	Slot * bump_end_; ///< past-the-last Slot of the current block
+	unsigned int next_block_size_; ///< size of the next block in Slots
+}; // class PoolAllocator
+
+/// \brief storage policy that takes the memory of containers from the heap
+///
+/// The array based containers (Vector and what's built on it) ask their
+/// storage policy for whole arrays of any size, unlike the allocator policies
+/// above that hand out one object of one type at a time.
+struct HeapStorage {
+	/// \brief get uninitialized memory
+	///
+	/// \param bytes number of bytes needed
+	///
+	/// \return address of the memory (aligned for any type)
+	inline void * allocate(std::size_t bytes) { return ::operator new(bytes); }
+
+	/// \brief give back memory obtained by allocate()
+	///
+	/// \param address of the memory (may be nullptr)
+	inline void deallocate(void * p) { ::operator delete(p); }
+}; // struct HeapStorage
+
+
+/// \brief monotonic arena: hands out memory of any size from big blocks and
+/// only ever gives it back all at once
+///
+/// Allocation is a bump of a pointer, there is no per-object bookkeeping and
+/// nothing is freed one by one: release() (or the destructor) hands the
+/// blocks back in one go, which is O(number of blocks) no matter how many
+/// objects live in them. Objects made with create() are not destroyed, so
+/// they must not own anything outside the arena; heap objects that should
+/// die along with the arena can be adopt()ed.
+class Arena {
+public:
+	/// \brief constructor w/o parameters --- doesn't allocate anything yet
+	inline Arena();
+
+	/// \brief an Arena can't be copied
+	Arena(Arena const &) = delete;
+
+	/// \brief an Arena can't be copied
+	Arena & operator=(Arena const &) = delete;
+
+
+	/// \brief get uninitialized memory
+	///
+	/// \param bytes number of bytes needed
+	/// \param align alignment needed (a power of two)
+	///
+	/// \return address of the memory, valid until release()
+	inline void * allocate(std::size_t bytes,
+							std::size_t align = alignof(std::max_align_t));
+
+	/// \brief construct an object in the arena
+	///
+	/// \tparam T type of the object
+	/// \param args arguments to pass to the constructor
+	///
+	/// \return the object (its destructor never runs)
+	template <typename T, typename... Args>
+	inline T * create(Args &&... args)
+	{
+		return new (this->allocate(sizeof(T), alignof(T)))
+					T(std::forward<Args>(args)...);
+	}
+
+	/// \brief copy characters into the arena
+	///
+	/// \param data address of the first character
+	/// \param size number of characters
+	///
+	/// \return address of the copy (not null terminated)
+	inline char const * copy(char const * data, std::size_t size);
+
+	/// \brief make a heap object die along with the arena
+	///
+	/// \tparam T type of the object
+	/// \param object to delete on release() (most recently adopted first)
+	template <typename T>
+	inline void adopt(T * object)
+	{
+		Cleanup * cleanup = this->create<Cleanup>();
+		cleanup->object_ = object;
+		cleanup->destroy_ = &Arena::destroy<T>;
+		cleanup->next_ = this->cleanups_;
+		this->cleanups_ = cleanup;
+	}
+
+	/// \brief delete the adopted objects and give back all blocks
+	inline void release();
+
+
+	/// \brief get the number of bytes handed out since the last release()
+	///
+	/// \return bytes (alignment padding included)
+	inline std::size_t bytes() const { return this->bytes_; }
+
+	/// \brief get the number of blocks held
+	///
+	/// \return number of blocks
+	inline unsigned int blocks() const { return this->number_of_blocks_; }
+
+
+	/// \brief destructor (releases everything)
+	inline ~Arena() { this->release(); }
+
+
+private:
+	/// \brief header at the start of every block
+	struct Block {
+		Block * previous_; ///< block allocated before this one
+	}; // struct Block
+
+	/// \brief an adopted object, kept in a list in the arena itself
+	struct Cleanup {
+		void * object_; ///< the object
+		void (*destroy_)(void *); ///< deletes the object
+		Cleanup * next_; ///< adopted before this one
+	}; // struct Cleanup
+
+	/// \brief delete an adopted object
+	///
+	/// \tparam T type of the object
+	/// \param object to delete
+	template <typename T>
+	static void destroy(void * object) { delete static_cast<T *>(object); }
+
+	/// \brief get a new block from the heap and make it the current one
+	///
+	/// \param bytes least number of usable bytes it has to have
+	inline void grow(std::size_t bytes);
+
+private:
+	static std::size_t const first_block_size_ = 4096; ///< bytes of 1st block
+	static std::size_t const max_block_size_ = 1 << 20; ///< upper limit
+
+	Block * blocks_; ///< most recent block, linking the previous ones
+	Cleanup * cleanups_; ///< most recently adopted object
+	char * bump_; ///< next unused byte of the current block
+	char * end_; ///< past-the-last byte of the current block
+	std::size_t next_block_size_; ///< size of the next block in bytes
+	std::size_t bytes_; ///< bytes handed out
+	unsigned int number_of_blocks_; ///< blocks held
+}; // class Arena
+
+
+/// \brief storage policy that takes the memory of containers from an Arena
+///
+/// Without an Arena it falls back to the heap, so a container type can be
+/// used both ways. Memory from the Arena is never given back by the container
+/// (growing leaves the old array behind until the Arena is released).
+class ArenaStorage {
+public:
+	/// \brief constructor
+	///
+	/// \param arena to take the memory from (nullptr for the heap)
+	inline ArenaStorage(Arena * arena = nullptr) : arena_(arena) {}
+
+	/// \brief get uninitialized memory
+	///
+	/// \param bytes number of bytes needed
+	///
+	/// \return address of the memory (aligned for any type)
+	inline void * allocate(std::size_t bytes)
+	{
+		return this->arena_ != nullptr ? this->arena_->allocate(bytes)
+										: ::operator new(bytes);
+	}
+
+	/// \brief give back memory obtained by allocate()
+	///
+	/// \param address of the memory (may be nullptr)
+	inline void deallocate(void * p)
+	{
+		if (this->arena_ == nullptr)
+		{
+			::operator delete(p);
+		}
+	}
+
+	/// \brief get the Arena the memory comes from
+	///
+	/// \return the Arena (nullptr for the heap)
+	inline Arena * arena() const { return this->arena_; }
+
+private:
+	Arena * arena_; ///< where the memory comes from (nullptr for the heap)
+}; // class ArenaStorage
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+template <typename T>
+PoolAllocator<T>::PoolAllocator()
+	:	blocks_(nullptr), free_(nullptr), bump_(nullptr), bump_end_(nullptr),
+		next_block_size_(first_block_size_)
+{
+}
+
+template <typename T>
+T * PoolAllocator<T>::allocate()
+{
+	// recycle freed storage first
+	if (this->free_ != nullptr)
+	{
+		Slot * slot = this->free_;
+		this->free_ = slot->next_;
+		return reinterpret_cast<T *>(slot->storage_);
+	}
+
+	// current block is used up
+	if (this->bump_ == this->bump_end_)
+	{
+		this->grow();
+	}
+
+	return reinterpret_cast<T *>((this->bump_++)->storage_);
+}
+
+template <typename T>
+void PoolAllocator<T>::deallocate(T * p)
+{
+	Slot * slot = reinterpret_cast<Slot *>(p);
+	slot->next_ = this->free_;
+	this->free_ = slot;
+}
+
+template <typename T>
+void PoolAllocator<T>::swap(PoolAllocator & other)
+{
+	std::swap(this->blocks_, other.blocks_);
+	std::swap(this->free_, other.free_);
+	std::swap(this->bump_, other.bump_);
+	std::swap(this->bump_end_, other.bump_end_);
+	std::swap(this->next_block_size_, other.next_block_size_);
+}
+
+template <typename T>
+void PoolAllocator<T>::grow()
+{
+	// over-allocate, so the Slots can be aligned by hand and the address
+	// operator new returned can be stashed right before them
+	std::size_t bytes = (this->next_block_size_ + 1) * sizeof(Slot)
+						+ alignof(Slot) + sizeof(void *);
+	char * raw = static_cast<char *>(::operator new(bytes));
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw)
+								+ sizeof(void *);
+	address = (address + alignof(Slot) - 1)
+				& ~static_cast<std::uintptr_t>(alignof(Slot) - 1);
+
+	Slot * block = reinterpret_cast<Slot *>(address);
+	reinterpret_cast<void **>(block)[-1] = raw;
+
+	// the first Slot of every block links the previously allocated block
+	block->next_ = this->blocks_;
+	this->blocks_ = block;
+
+	this->bump_ = block + 1;
+	this->bump_end_ = block + 1 + this->next_block_size_;
+
+	if (this->next_block_size_ < max_block_size_)
+	{
+		this->next_block_size_ *= 2;
+	}
+}
+
+template <typename T>
+PoolAllocator<T>::~PoolAllocator()
+{
+	while (this->blocks_ != nullptr)
+	{
+		Slot * previous = this->blocks_->next_;
+		::operator delete(reinterpret_cast<void **>(this->blocks_)[-1]);
+		this->blocks_ = previous;
+	}
+}
+
+Arena::Arena()
+	:	blocks_(nullptr), cleanups_(nullptr), bump_(nullptr), end_(nullptr),
+		next_block_size_(first_block_size_), bytes_(0), number_of_blocks_(0)
+{
+}
+
+void * Arena::allocate(std::size_t bytes, std::size_t align)
+{
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(this->bump_);
+	std::uintptr_t aligned = (address + align - 1)
+								& ~static_cast<std::uintptr_t>(align - 1);
+
+	// current block is used up (or there is none yet)
+	if (this->bump_ == nullptr ||
+			aligned + bytes > reinterpret_cast<std::uintptr_t>(this->end_))
+	{
+		this->grow(bytes + align);
+		address = reinterpret_cast<std::uintptr_t>(this->bump_);
+		aligned = (address + align - 1) & ~static_cast<std::uintptr_t>(align - 1);
+	}
+
+	this->bytes_ += aligned + bytes - address;
+	this->bump_ = reinterpret_cast<char *>(aligned + bytes);
+	return reinterpret_cast<void *>(aligned);
+}
+
+char const * Arena::copy(char const * data, std::size_t size)
+{
+	char * copy = static_cast<char *>(this->allocate(size, 1));
+	for (std::size_t k = 0; k < size; ++k)
+	{
+		copy[k] = data[k];
+	}
+	return copy;
+}
+
+void Arena::release()
+{
+	// adopted objects may still look at the blocks (e.g. their Cleanups)
+	while (this->cleanups_ != nullptr)
+	{
+		Cleanup * next = this->cleanups_->next_;
+		this->cleanups_->destroy_(this->cleanups_->object_);
+		this->cleanups_ = next;
+	}
+
+	while (this->blocks_ != nullptr)
+	{
+		Block * previous = this->blocks_->previous_;
+		::operator delete(this->blocks_);
+		this->blocks_ = previous;
+	}
+
+	this->bump_ = nullptr;
+	this->end_ = nullptr;
+	this->next_block_size_ = first_block_size_;
+	this->bytes_ = 0;
+	this->number_of_blocks_ = 0;
+}
+
+void Arena::grow(std::size_t bytes)
+{
+	// the header is padded, so the usable part starts fully aligned
+	std::size_t header = (sizeof(Block) + alignof(std::max_align_t) - 1)
+							& ~(alignof(std::max_align_t) - 1);
+	std::size_t size = this->next_block_size_;
+	while (size < header + bytes)
+	{
+		size *= 2;
+	}
+
+	Block * block = static_cast<Block *>(::operator new(size));
+	block->previous_ = this->blocks_;
+	this->blocks_ = block;
+	++this->number_of_blocks_;
+
+	this->bump_ = reinterpret_cast<char *>(block) + header;
+	this->end_ = reinterpret_cast<char *>(block) + size;
+
+	if (this->next_block_size_ < max_block_size_)
+	{
+		this->next_block_size_ *= 2;
+	}
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_ALLOCATOR_HXX
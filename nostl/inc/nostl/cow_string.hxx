@@ -0,0 +1,241 @@
+#ifndef BANCH_NOSTL_COW_STRING_HXX
+#define BANCH_NOSTL_COW_STRING_HXX
+
+/// \file cow_string.hxx
+///
+/// \brief string that borrows its characters until it's written to
+
+#include "nostl/hash.hxx"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief string that is either a view into someone else's memory or owns
+/// its characters
+///
+/// Views cost no allocation, which is what makes parsing a memory-mapped file
+/// in place worthwhile. The first mutate() copies the characters into an
+/// owned std::string (copy-on-write), the borrowed memory is never written.
+///
+/// \note a view must not outlive the memory it points into
+class CowString {
+public:
+	/// \brief constructor w/o parameters (empty, owned)
+	inline CowString() : view_(nullptr), size_(0) {}
+
+	/// \brief constructor from an std::string (owned)
+	///
+	/// \param str string to take over
+	inline CowString(std::string str)
+		: owned_(std::move(str)), view_(nullptr), size_(0) {}
+
+	/// \brief constructor from a C string (owned)
+	///
+	/// \param str characters to copy
+	inline CowString(char const * str)
+		: owned_(str), view_(nullptr), size_(0) {}
+
+	/// \brief create a view into memory owned by someone else
+	///
+	/// \param data address of first character (not null)
+	/// \param size number of characters
+	///
+	/// \return the view
+	static inline CowString view(char const *, unsigned int);
+
+
+	/// \brief get address of the characters
+	///
+	/// \return address of first character (not null terminated if a view)
+	inline char const * data() const
+	{
+		return this->view_ != nullptr ? this->view_ : this->owned_.data();
+	}
+
+	/// \brief get number of characters
+	///
+	/// \return the size of the string
+	inline unsigned int size() const
+	{
+		return this->view_ != nullptr ? this->size_ : this->owned_.size();
+	}
+
+	/// \brief tell whether the string is empty
+	///
+	/// \return true if there are no characters
+	inline bool empty() const { return this->size() == 0; }
+
+	/// \brief tell whether the characters are borrowed
+	///
+	/// \return true if the string is still a view
+	inline bool borrowed() const { return this->view_ != nullptr; }
+
+	/// \brief get a copy as an std::string
+	///
+	/// \return the copy
+	inline std::string str() const
+	{
+		return std::string(this->data(), this->size());
+	}
+
+
+	/// \brief get write access to the characters, copying them if borrowed
+	///
+	/// \return reference to the owned string
+	inline std::string & mutate();
+
+	/// \brief assignment operator from an std::string (becomes owned)
+	///
+	/// \param str string to take over
+	///
+	/// \return reference to this
+	inline CowString & operator=(std::string str);
+
+	/// \brief become a view, giving the memory of owned characters back
+	///
+	/// \param data address of first character (not null)
+	/// \param size number of characters
+	inline void borrow(char const * data, unsigned int size);
+
+
+	/// \brief equals operator
+	///
+	/// \param rhs string to check equality with
+	///
+	/// \return true if the characters are the same
+	inline bool operator==(CowString const & rhs) const
+	{
+		return this->equals(rhs.data(), rhs.size());
+	}
+
+	/// \brief equals operator
+	///
+	/// \param rhs string to check equality with
+	///
+	/// \return true if the characters are the same
+	inline bool operator==(std::string const & rhs) const
+	{
+		return this->equals(rhs.data(), rhs.size());
+	}
+
+	/// \brief equals operator
+	///
+	/// \param rhs C string to check equality with
+	///
+	/// \return true if the characters are the same
+	inline bool operator==(char const * rhs) const
+	{
+		return this->equals(rhs, std::strlen(rhs));
+	}
+
+	/// \brief not equals operator
+	///
+	/// \param rhs string to check inequality with
+	///
+	/// \return true if the characters differ
+	template <typename U>
+	inline bool operator!=(U const & rhs) const { return !(*this == rhs); }
+
+
+private:
+	/// \brief compare to a range of characters
+	///
+	/// \param data address of first character
+	/// \param size number of characters
+	///
+	/// \return true if the characters are the same
+	inline bool equals(char const *, unsigned int) const;
+
+private:
+	std::string owned_; ///< the characters, if owned
+	char const * view_; ///< the characters, if borrowed (nullptr otherwise)
+	unsigned int size_; ///< number of borrowed characters
+}; // class CowString
+
+
+/// \brief hash policy for CowStrings (same as the one for std::strings)
+template <>
+struct Hash<CowString> {
+	/// \brief hash a string
+	///
+	/// \param value to hash
+	///
+	/// \return the hash
+	std::uint64_t operator()(CowString const & value) const
+	{
+		return hashBytes(value.data(), value.size());
+	}
+}; // struct Hash<CowString>
+
+
+/// \brief print a CowString
+///
+/// \param os stream to print into
+/// \param str string to print
+///
+/// \return the stream
+inline std::ostream & operator<<(std::ostream & os, CowString const & str)
+{
+	return os.write(str.data(), str.size());
+}
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+CowString CowString::view(char const * data, unsigned int size)
+{
+	CowString str;
+	str.view_ = data;
+	str.size_ = size;
+	return str;
+}
+
+std::string & CowString::mutate()
+{
+	if (this->view_ != nullptr)
+	{
+		this->owned_.assign(this->view_, this->size_);
+		this->view_ = nullptr;
+		this->size_ = 0;
+	}
+	return this->owned_;
+}
+
+void CowString::borrow(char const * data, unsigned int size)
+{
+	// assigning keeps the capacity, swapping with an empty string doesn't
+	std::string().swap(this->owned_);
+	this->view_ = data;
+	this->size_ = size;
+}
+
+CowString & CowString::operator=(std::string str)
+{
+	this->owned_ = std::move(str);
+	this->view_ = nullptr;
+	this->size_ = 0;
+	return *this;
+}
+
+bool CowString::equals(char const * data, unsigned int size) const
+{
+	// interned strings share their characters, no need to look at them
+	return this->size() == size &&
+			(this->data() == data || std::memcmp(this->data(), data, size) == 0);
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_COW_STRING_HXX
@@ -0,0 +1,96 @@
+#ifndef BANCH_NOSTL_HASH_HXX
+#define BANCH_NOSTL_HASH_HXX
+
+/// \file hash.hxx
+///
+/// \brief default hash and equality policies for the hash containers
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+/// \brief scramble the bits of a 64 bit value (MurmurHash3's finalizer)
+///
+/// \param value to scramble
+///
+/// \return the scrambled value
+///
+/// Used on top of the hash policies, so that weak hashes (std::hash of a
+/// pointer is the address itself) still spread over the whole table.
+inline std::uint64_t mix(std::uint64_t value)
+{
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+	return value;
+}
+
+/// \brief hash a range of bytes (64 bit FNV-1a)
+///
+/// \param data address of first byte
+/// \param size number of bytes
+///
+/// \return the hash
+inline std::uint64_t hashBytes(char const * data, unsigned int size)
+{
+	std::uint64_t hash = 0xcbf29ce484222325ULL;
+	for (unsigned int k = 0; k < size; ++k)
+	{
+		hash ^= static_cast<unsigned char>(data[k]);
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+/// \brief default hash policy
+///
+/// \tparam T type of values to hash
+template <typename T>
+struct Hash {
+	/// \brief hash a value
+	///
+	/// \param value to hash
+	///
+	/// \return the hash
+	std::uint64_t operator()(T const & value) const
+	{
+		return std::hash<T>()(value);
+	}
+}; // struct Hash
+
+/// \brief hash policy for strings
+template <>
+struct Hash<std::string> {
+	/// \brief hash a string
+	///
+	/// \param value to hash
+	///
+	/// \return the hash
+	std::uint64_t operator()(std::string const & value) const
+	{
+		return hashBytes(value.data(), value.size());
+	}
+}; // struct Hash<std::string>
+
+/// \brief default equality policy
+///
+/// \tparam T type of values to compare
+template <typename T>
+struct EqualTo {
+	/// \brief compare two values
+	///
+	/// \param lhs value to compare
+	/// \param rhs value to compare
+	///
+	/// \return true if the values are equal
+	bool operator()(T const & lhs, T const & rhs) const { return lhs == rhs; }
+}; // struct EqualTo
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_HASH_HXX
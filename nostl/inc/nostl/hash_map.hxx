@@ -0,0 +1,352 @@
+#ifndef BANCH_NOSTL_HASH_MAP_HXX
+#define BANCH_NOSTL_HASH_MAP_HXX
+
+/// \file hash_map.hxx
+///
+/// \brief open addressing hash map
+
+#include "nostl/hash.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <utility>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief hash map with O(1) average insert, remove and lookup
+///
+/// \tparam K type of keys (default constructible)
+/// \tparam V type of values (default constructible)
+/// \tparam HashPolicy function object that hashes a K
+/// \tparam Equal function object that compares two Ks
+///
+/// Keys and values live right in a linear probing table that is kept at most
+/// half full. Removal shifts the following entries of the probe sequence back
+/// instead of leaving tombstones, so lookups never get slower over time.
+///
+/// \note pointers to values are invalidated by insertions and removals,
+/// iteration order is unspecified
+template <typename K, typename V, typename HashPolicy = Hash<K>,
+			typename Equal = EqualTo<K> >
+class HashMap {
+private:
+	/// \brief an entry of the table
+	struct Slot {
+		K key_; ///< the key
+		V value_; ///< the value
+		bool used_; ///< false if the slot is free
+	}; // struct Slot
+
+public:
+	/// \brief constructor with default arguments
+	///
+	/// \param hash hash policy instance to use
+	/// \param equal equality policy instance to use
+	inline HashMap(HashPolicy const & hash = HashPolicy(),
+					Equal const & equal = Equal())
+		:	number_of_elements_(0), hash_(hash), equal_(equal) {}
+
+
+	/// \brief add a key with a value, unless the key is there already
+	///
+	/// \param key to add
+	/// \param value to map it to
+	///
+	/// \return false if the key was already there (its value is untouched)
+	inline bool insert(K const & key, V value);
+
+	/// \brief get the value of a key, adding the key if it's missing
+	///
+	/// \param key to look up
+	///
+	/// \return reference to the value (default constructed if it was missing)
+	inline V & operator[](K const & key);
+
+	/// \brief remove a key
+	///
+	/// \param key to remove
+	///
+	/// \return false if the key wasn't there
+	inline bool remove(K const & key);
+
+	/// \brief clear the map (i.e. remove all of its entries)
+	inline void clear();
+
+
+	/// \brief find the value of a key
+	///
+	/// \param key to look up
+	///
+	/// \return pointer to the value or nullptr if the key isn't there
+	inline V * find(K const & key)
+	{
+		if (this->number_of_elements_ == 0)
+		{
+			return nullptr;
+		}
+		unsigned int slot = this->findSlot(key);
+		return this->slots_[slot].used_ ? &this->slots_[slot].value_ : nullptr;
+	}
+
+	/// \brief find the value of a key
+	///
+	/// \param key to look up
+	///
+	/// \return pointer to the value or nullptr if the key isn't there
+	inline V const * find(K const & key) const
+	{
+		return const_cast<HashMap *>(this)->find(key);
+	}
+
+	/// \brief tell whether a key is there
+	///
+	/// \param key to look up
+	///
+	/// \return true if the map contains the key
+	inline bool contains(K const & key) const
+	{
+		return this->find(key) != nullptr;
+	}
+
+	/// \brief get the number of entries
+	///
+	/// \return the map's size
+	inline unsigned int size() const { return this->number_of_elements_; }
+
+	/// \brief tell whether the map is empty
+	///
+	/// \return true if there are no entries
+	inline bool empty() const { return this->number_of_elements_ == 0; }
+
+
+private:
+	/// \brief find the slot of a key, or the free slot it would go into
+	///
+	/// \param key to look up
+	///
+	/// \return slot index (the table must not be empty)
+	inline unsigned int findSlot(K const & key) const;
+
+	/// \brief get the home slot of a key
+	///
+	/// \param key to hash
+	///
+	/// \return slot index
+	inline unsigned int home(K const & key) const
+	{
+		return mix(this->hash_(key)) & (this->slots_.size() - 1);
+	}
+
+	/// \brief make room for one more entry (growing the table if needed)
+	inline void reserveOne();
+
+private:
+	Vector<Slot> slots_; ///< the table (size is zero or a power of two)
+	unsigned int number_of_elements_; ///< number of used slots
+	HashPolicy hash_; ///< hash policy instance
+	Equal equal_; ///< equality policy instance
+
+public:
+	/// \brief iterator over the entries
+	class Iterator {
+	public:
+		/// \brief constructor
+		///
+		/// \param map to iterate
+		/// \param slot to start at (skips to the first used one)
+		inline Iterator(HashMap const * map, unsigned int slot)
+			: map_(map), slot_(slot) { this->skip(); }
+
+		/// \brief get the key of the current entry
+		///
+		/// \return const reference to the key
+		inline K const & key() const { return this->map_->slots_[this->slot_].key_; }
+
+		/// \brief get the value of the current entry
+		///
+		/// \return const reference to the value
+		inline V const & value() const
+		{
+			return this->map_->slots_[this->slot_].value_;
+		}
+
+		/// \brief prefix increment
+		///
+		/// \return iterator to the next entry
+		inline Iterator operator++()
+		{
+			++this->slot_;
+			this->skip();
+			return *this;
+		}
+
+		/// \brief equals operator
+		///
+		/// \param rhs iterator to check equality with
+		///
+		/// \return true if both point to the same entry
+		inline bool operator==(Iterator const & rhs) const
+		{
+			return this->slot_ == rhs.slot_;
+		}
+
+		/// \brief not equals operator
+		///
+		/// \param rhs iterator to check inequality with
+		///
+		/// \return true if they point to different entries
+		inline bool operator!=(Iterator const & rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+	private:
+		/// \brief move forward to the next used slot
+		inline void skip()
+		{
+			while (this->slot_ < this->map_->slots_.size() &&
+					!this->map_->slots_[this->slot_].used_)
+			{
+				++this->slot_;
+			}
+		}
+
+	private:
+		HashMap const * map_; ///< the map iterated over
+		unsigned int slot_; ///< current slot
+	}; // class Iterator
+
+	/// \brief get an iterator to the first entry
+	///
+	/// \return iterator
+	inline Iterator begin() const { return Iterator(this, 0); }
+
+	/// \brief get an iterator past the last entry
+	///
+	/// \return iterator
+	inline Iterator end() const { return Iterator(this, this->slots_.size()); }
+}; // class HashMap
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+template <typename K, typename V, typename HashPolicy, typename Equal>
+bool HashMap<K, V, HashPolicy, Equal>::insert(K const & key, V value)
+{
+	this->reserveOne();
+
+	Slot & slot = this->slots_[this->findSlot(key)];
+	if (slot.used_)
+	{
+		return false;
+	}
+
+	slot.key_ = key;
+	slot.value_ = std::move(value);
+	slot.used_ = true;
+	++this->number_of_elements_;
+	return true;
+}
+
+template <typename K, typename V, typename HashPolicy, typename Equal>
+V & HashMap<K, V, HashPolicy, Equal>::operator[](K const & key)
+{
+	this->reserveOne();
+
+	Slot & slot = this->slots_[this->findSlot(key)];
+	if (!slot.used_)
+	{
+		slot.key_ = key;
+		slot.value_ = V();
+		slot.used_ = true;
+		++this->number_of_elements_;
+	}
+	return slot.value_;
+}
+
+template <typename K, typename V, typename HashPolicy, typename Equal>
+bool HashMap<K, V, HashPolicy, Equal>::remove(K const & key)
+{
+	if (this->number_of_elements_ == 0)
+	{
+		return false;
+	}
+
+	unsigned int hole = this->findSlot(key);
+	if (!this->slots_[hole].used_)
+	{
+		return false;
+	}
+
+	// shift back whatever would not be found anymore across the hole
+	unsigned int mask = this->slots_.size() - 1;
+	for (unsigned int next = (hole + 1) & mask;
+			this->slots_[next].used_;
+			next = (next + 1) & mask)
+	{
+		unsigned int wanted = this->home(this->slots_[next].key_);
+		if (((next - wanted) & mask) >= ((next - hole) & mask))
+		{
+			this->slots_[hole] = std::move(this->slots_[next]);
+			hole = next;
+		}
+	}
+
+	this->slots_[hole].key_ = K();
+	this->slots_[hole].value_ = V();
+	this->slots_[hole].used_ = false;
+	--this->number_of_elements_;
+	return true;
+}
+
+template <typename K, typename V, typename HashPolicy, typename Equal>
+void HashMap<K, V, HashPolicy, Equal>::clear()
+{
+	this->slots_.clear();
+	this->number_of_elements_ = 0;
+}
+
+template <typename K, typename V, typename HashPolicy, typename Equal>
+unsigned int HashMap<K, V, HashPolicy, Equal>::findSlot(K const & key) const
+{
+	unsigned int mask = this->slots_.size() - 1;
+	unsigned int slot = this->home(key);
+	while (this->slots_[slot].used_ && !this->equal_(this->slots_[slot].key_, key))
+	{
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+template <typename K, typename V, typename HashPolicy, typename Equal>
+void HashMap<K, V, HashPolicy, Equal>::reserveOne()
+{
+	if (2 * (this->number_of_elements_ + 1) <= this->slots_.size())
+	{
+		return;
+	}
+
+	// grow and reinsert everything
+	Vector<Slot> old(std::move(this->slots_));
+	this->slots_.clear();
+	this->slots_.resize(old.size() == 0 ? 8 : 2 * old.size(), Slot());
+	for (unsigned int k = 0; k < old.size(); ++k)
+	{
+		if (old[k].used_)
+		{
+			this->slots_[this->findSlot(old[k].key_)] = std::move(old[k]);
+		}
+	}
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_HASH_MAP_HXX
@@ -0,0 +1,506 @@
+#ifndef BANCH_NOSTL_HASH_SET_HXX
+#define BANCH_NOSTL_HASH_SET_HXX
+
+/// \file hash_set.hxx
+///
+/// \brief open addressing hash set that remembers insertion order
+
+#include "nostl/hash.hxx"
+#include "nostl/indexed_sequence.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <utility>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief hash set with O(1) average insert, remove and lookup
+///
+/// \tparam T type of elements that the HashSet contains
+/// \tparam HashPolicy function object that hashes a T
+/// \tparam Equal function object that compares two Ts
+/// \tparam Storage policy the storage of the tables comes from
+///
+/// The elements are kept in an IndexedSequence of entries in the order they
+/// were inserted, and an open addressing (linear probing) table of slots in it
+/// is used to find them. Removed entries are only marked dead; they are
+/// compacted away when the table is rebuilt. Iterating therefore visits the
+/// elements in insertion order, just like a Set does, and it has the same
+/// Iterator semantics. On top of that, the n-th element can be looked up or
+/// removed in O(log n).
+template <typename T, typename HashPolicy = Hash<T>,
+			typename Equal = EqualTo<T>, typename Storage = HeapStorage>
+class HashSet {
+public:
+	/// \brief constructor with default arguments
+	///
+	/// \param hash hash policy instance to use
+	/// \param equal equality policy instance to use
+	/// \param storage storage policy instance to use
+	inline HashSet(HashPolicy const & hash = HashPolicy(),
+					Equal const & equal = Equal(),
+					Storage const & storage = Storage())
+		:	entries_(storage), slots_(storage),
+			number_of_elements_(0), used_slots_(0),
+			hash_(hash), equal_(equal) {}
+
+
+	/// \brief add element to the HashSet
+	///
+	/// \param value of new element
+	inline void insert(T const & val) { this->emplace(val); }
+
+	/// \brief add element to the HashSet by moving it in
+	///
+	/// \param value of new element
+	///
+	/// \note the value is left untouched if the HashSet already contains it
+	inline void insert(T && val) { this->emplace(std::move(val)); }
+
+	/// \brief tell whether an element is in the HashSet
+	///
+	/// \param value to look for
+	///
+	/// \return true if the HashSet contains the value
+	inline bool contains(T const & val) const;
+
+	/// \brief remove an element from the HashSet
+	///
+	/// \param value of element to remove (nothing happens if it's not there)
+	inline void remove(T const &);
+
+	/// \brief remove the n-th element (in insertion order) from the HashSet
+	///
+	/// \param rank of element to remove (0 is the first one)
+	inline void removeAt(unsigned int);
+
+	/// \brief get the n-th element (in insertion order)
+	///
+	/// \param rank of element (0 is the first one, must be less than size())
+	///
+	/// \return the element
+	inline T const & at(unsigned int rank) const
+	{
+		return this->entries_.at(rank).value_;
+	}
+
+	/// \brief get the position of an element (in insertion order)
+	///
+	/// \param value to look for
+	///
+	/// \return rank of the element (0 is the first one) or size() if it's
+	/// not in the HashSet
+	inline unsigned int indexOf(T const &) const;
+
+	/// \brief clear the HashSet (i.e. remove all of its elements)
+	inline void clear();
+
+
+	/// \brief get the size of the HashSet (i.e. the number of its elements)
+	///
+	/// \return the HashSet's size
+	inline unsigned int size() const { return this->number_of_elements_; }
+
+
+	/// \brief equality operator
+	///
+	/// \param HashSet to check equality with
+	///
+	/// \return true if the two HashSets contain the same elements
+	inline bool operator==(HashSet const &) const;
+
+	/// \brief inequality operator
+	///
+	/// \param HashSet to check inequality with
+	///
+	/// \return true if the two HashSets differ somehow
+	inline bool operator!=(HashSet const & rhs) const { return !(*this == rhs); }
+
+
+private:
+	/// \brief an element together with its hash
+	struct Entry {
+		T value_; ///< the element
+		std::uint64_t hash_; ///< its (mixed) hash, saves rehashing
+	};
+
+	static unsigned int const EMPTY = ~0u; ///< slot that was never used
+	static unsigned int const DELETED = ~0u - 1; ///< slot of removed element
+
+private:
+	/// \brief add element if it's not in the HashSet yet
+	///
+	/// \param value of new element (forwarded into the entry)
+	template <typename U>
+	inline void emplace(U && val);
+
+	/// \brief find the slot that points to an element
+	///
+	/// \param value to look for
+	/// \param its mixed hash
+	///
+	/// \return index of the slot or EMPTY if the element is not there
+	inline unsigned int findSlot(T const &, std::uint64_t) const;
+
+	/// \brief kill the entry a slot of the table points to
+	///
+	/// \param index of the slot
+	inline void erase(unsigned int);
+
+	/// \brief compact the entries and rebuild the table
+	///
+	/// \param number of slots of the new table (a power of 2)
+	inline void rehash(unsigned int);
+
+private:
+	IndexedSequence<Entry, Storage> entries_; ///< elements in insertion order
+	Vector<unsigned int, Storage> slots_; ///< the table (slots of entries_)
+	unsigned int number_of_elements_; ///< number of alive entries
+	unsigned int used_slots_; ///< slots of the table that aren't EMPTY
+	HashPolicy hash_; ///< hash policy instance
+	Equal equal_; ///< equality policy instance
+
+
+public:
+	/// \brief iterator that visits the elements in insertion order
+	class Iterator {
+	public:
+		/// \brief constructor for the HashSet's Iterator
+		///
+		/// \param address of the HashSet's entries
+		/// \param slot of entry to point to
+		inline Iterator(IndexedSequence<Entry, Storage> const * entries,
+						unsigned int index)
+			: entries_(entries), index_(index) {}
+
+
+		/// \brief dereference operator
+		///
+		/// \return the element currently pointed to
+		inline T const & operator*() const
+		{
+			return (*this->entries_)[this->index_].value_;
+		}
+
+
+		/// \brief preincrement operator (doesn't go past end())
+		///
+		/// \return Iterator of next element
+		inline Iterator operator++();
+
+		/// \brief postincrement operator (doesn't go past end())
+		///
+		/// \param int dummy parameter
+		///
+		/// \return Iterator of current element
+		inline Iterator operator++(int);
+
+		/// \brief predecrement operator (doesn't go below the first element)
+		///
+		/// \return Iterator of previous element
+		inline Iterator operator--();
+
+		/// \brief postdecrement operator (doesn't go below the first element)
+		///
+		/// \param int dummy parameter
+		///
+		/// \return Iterator of current element
+		inline Iterator operator--(int);
+
+
+		/// \brief equality operator
+		///
+		/// \param Iterator to check equality with
+		///
+		/// \return true if the Iterators point to the same element
+		inline bool operator==(Iterator const & rhs) const
+		{
+			return this->index_ == rhs.index_;
+		}
+
+		/// \brief inequality operator
+		///
+		/// \param Iterator to check inequality with
+		///
+		/// \return true if the Iterators point to different elements
+		inline bool operator!=(Iterator const & rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+
+	private:
+		IndexedSequence<Entry, Storage> const * entries_; ///< the HashSet's entries
+		unsigned int index_; ///< slot of current entry
+	}; // class Iterator
+
+
+public:
+	/// \brief get Iterator to the first element of the HashSet
+	///
+	/// \return Iterator to first element
+	inline Iterator begin() const
+	{
+		return Iterator(&this->entries_, this->entries_.first());
+	}
+
+	/// \brief get Iterator to the element that would come after the last one
+	///
+	/// \return the past-the-last element
+	inline Iterator end() const
+	{
+		return Iterator(&this->entries_, this->entries_.slots());
+	}
+}; // class HashSet
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+unsigned int const HashSet<T, HashPolicy, Equal, Storage>::EMPTY;
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+unsigned int const HashSet<T, HashPolicy, Equal, Storage>::DELETED;
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+bool HashSet<T, HashPolicy, Equal, Storage>::contains(T const & val) const
+{
+	if (this->number_of_elements_ == 0)
+	{
+		return false;
+	}
+
+	return this->findSlot(val, mix(this->hash_(val))) != EMPTY;
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+void HashSet<T, HashPolicy, Equal, Storage>::remove(T const & val)
+{
+	if (this->number_of_elements_ == 0)
+	{
+		return;
+	}
+
+	unsigned int slot = this->findSlot(val, mix(this->hash_(val)));
+	if (slot != EMPTY)
+	{
+		this->erase(slot);
+	}
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+void HashSet<T, HashPolicy, Equal, Storage>::removeAt(unsigned int rank)
+{
+	// the entry knows its hash, which leads to its slot in the table
+	unsigned int index = this->entries_.slotOf(rank);
+	unsigned int mask = this->slots_.size() - 1;
+	unsigned int slot = this->entries_[index].hash_ & mask;
+	while (this->slots_[slot] != index)
+	{
+		slot = (slot + 1) & mask;
+	}
+
+	this->erase(slot);
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+unsigned int HashSet<T, HashPolicy, Equal, Storage>::indexOf(T const & val) const
+{
+	if (this->number_of_elements_ == 0)
+	{
+		return 0;
+	}
+
+	unsigned int slot = this->findSlot(val, mix(this->hash_(val)));
+	if (slot == EMPTY)
+	{
+		return this->number_of_elements_;
+	}
+
+	return this->entries_.rankOf(this->slots_[slot]);
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+void HashSet<T, HashPolicy, Equal, Storage>::clear()
+{
+	this->entries_.clear();
+	this->slots_.clear();
+	this->number_of_elements_ = 0;
+	this->used_slots_ = 0;
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+bool HashSet<T, HashPolicy, Equal, Storage>::operator==(HashSet const & rhs) const
+{
+	if (this->size() != rhs.size())
+	{
+		return false;
+	}
+
+	for (Iterator i = this->begin(); i != this->end(); ++i)
+	{
+		if (!rhs.contains(*i))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+template <typename U>
+void HashSet<T, HashPolicy, Equal, Storage>::emplace(U && val)
+{
+	// keep the table at most 3/4 full (dead slots count too)
+	if ((this->used_slots_ + 1) * 4 > this->slots_.size() * 3)
+	{
+		unsigned int capacity = 16;
+		while ((this->number_of_elements_ + 1) * 2 > capacity)
+		{
+			capacity *= 2;
+		}
+		this->rehash(capacity);
+	}
+
+	std::uint64_t hash = mix(this->hash_(val));
+	unsigned int mask = this->slots_.size() - 1;
+	unsigned int slot = hash & mask;
+	unsigned int target = EMPTY;
+
+	// probe until an empty slot, remembering the first reusable one
+	while (this->slots_[slot] != EMPTY)
+	{
+		unsigned int index = this->slots_[slot];
+		if (index == DELETED)
+		{
+			if (target == EMPTY)
+			{
+				target = slot;
+			}
+		}
+		else if (this->entries_[index].hash_ == hash &&
+					this->equal_(this->entries_[index].value_, val))
+		{
+			// already there
+			return;
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	if (target == EMPTY)
+	{
+		target = slot;
+		++this->used_slots_;
+	}
+
+	Entry entry = { std::forward<U>(val), hash };
+	this->slots_[target] = this->entries_.append(std::move(entry));
+	++this->number_of_elements_;
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+unsigned int HashSet<T, HashPolicy, Equal, Storage>::findSlot(T const & val,
+													std::uint64_t hash) const
+{
+	unsigned int mask = this->slots_.size() - 1;
+	unsigned int slot = hash & mask;
+
+	while (this->slots_[slot] != EMPTY)
+	{
+		unsigned int index = this->slots_[slot];
+		if (index != DELETED && this->entries_[index].hash_ == hash &&
+				this->equal_(this->entries_[index].value_, val))
+		{
+			return slot;
+		}
+		slot = (slot + 1) & mask;
+	}
+
+	return EMPTY;
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+void HashSet<T, HashPolicy, Equal, Storage>::erase(unsigned int slot)
+{
+	this->entries_.erase(this->slots_[slot]);
+	this->slots_[slot] = DELETED;
+	--this->number_of_elements_;
+
+	// compact once there are more dead entries than alive ones
+	if (this->entries_.slots() > 16 &&
+			this->entries_.slots() - this->number_of_elements_ >
+				this->number_of_elements_)
+	{
+		this->rehash(this->slots_.size());
+	}
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+void HashSet<T, HashPolicy, Equal, Storage>::rehash(unsigned int capacity)
+{
+	// move alive entries to the front, keeping their order
+	this->entries_.compact();
+
+	// rebuild the table from the stored hashes
+	this->slots_.clear();
+	this->slots_.resize(capacity, EMPTY);
+	unsigned int mask = capacity - 1;
+	for (unsigned int k = 0; k < this->entries_.slots(); ++k)
+	{
+		unsigned int slot = this->entries_[k].hash_ & mask;
+		while (this->slots_[slot] != EMPTY)
+		{
+			slot = (slot + 1) & mask;
+		}
+		this->slots_[slot] = k;
+	}
+	this->used_slots_ = this->entries_.slots();
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+typename HashSet<T, HashPolicy, Equal, Storage>::Iterator
+HashSet<T, HashPolicy, Equal, Storage>::Iterator::operator++()
+{
+	this->index_ = this->entries_->next(this->index_);
+	return *this;
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+typename HashSet<T, HashPolicy, Equal, Storage>::Iterator
+HashSet<T, HashPolicy, Equal, Storage>::Iterator::operator++(int)
+{
+	Iterator rv = *this;
+	++(*this);
+	return rv;
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+typename HashSet<T, HashPolicy, Equal, Storage>::Iterator
+HashSet<T, HashPolicy, Equal, Storage>::Iterator::operator--()
+{
+	// stays put if there is no previous element
+	this->index_ = this->entries_->previous(this->index_);
+	return *this;
+}
+
+template <typename T, typename HashPolicy, typename Equal, typename Storage>
+typename HashSet<T, HashPolicy, Equal, Storage>::Iterator
+HashSet<T, HashPolicy, Equal, Storage>::Iterator::operator--(int)
+{
+	Iterator rv = *this;
+	--(*this);
+	return rv;
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_HASH_SET_HXX
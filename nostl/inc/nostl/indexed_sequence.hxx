@@ -0,0 +1,352 @@
+#ifndef BANCH_NOSTL_INDEXED_SEQUENCE_HXX
+#define BANCH_NOSTL_INDEXED_SEQUENCE_HXX
+
+/// \file indexed_sequence.hxx
+///
+/// \brief append-only sequence with O(log n) rank lookup and positional erase
+
+#include "nostl/vector.hxx"
+
+#include <utility>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief sequence that can find and erase its n-th element in O(log n)
+///
+/// \tparam T type of elements that the IndexedSequence contains
+/// \tparam Storage policy the storage of the Vectors comes from
+///
+/// Elements are only ever appended, so the order of the sequence is the order
+/// of insertion. Every element gets a slot in a Vector, erasing an element only
+/// marks its slot dead. A Fenwick tree over the alive flags maps ranks (the
+/// position of an element among the alive ones) to slots and back, both in
+/// O(log n), which is all an order-statistic tree would give us here without
+/// the pointer chasing. Dead slots are reclaimed by compact().
+///
+/// \note slots are stable until compact() is called, ranks shift whenever an
+/// element before them is erased
+template <typename T, typename Storage = HeapStorage>
+class IndexedSequence {
+public:
+	/// \brief constructor with default argument
+	///
+	/// \param storage to take the memory from
+	explicit inline IndexedSequence(Storage const & storage = Storage())
+		:	values_(storage), alive_(storage), tree_(storage),
+			number_of_elements_(0), first_(0) {}
+
+
+	/// \brief add element to the end of the sequence
+	///
+	/// \param value of new element (forwarded into the slot)
+	///
+	/// \return slot of the new element
+	template <typename U>
+	inline unsigned int append(U && val);
+
+	/// \brief erase the element in a slot
+	///
+	/// \param slot of element to erase (must be alive)
+	inline void erase(unsigned int);
+
+	/// \brief erase the element at a given rank
+	///
+	/// \param rank of element to erase (0 is the first one)
+	inline void eraseAt(unsigned int rank) { this->erase(this->slotOf(rank)); }
+
+	/// \brief move the alive elements to the front, forgetting dead slots
+	///
+	/// Order is kept, but slots change (the k-th element ends up in slot k).
+	inline void compact();
+
+	/// \brief clear the sequence (i.e. remove all of its elements)
+	inline void clear();
+
+
+	/// \brief get the number of alive elements
+	///
+	/// \return the sequence's size
+	inline unsigned int size() const { return this->number_of_elements_; }
+
+	/// \brief get the number of slots (alive or not)
+	///
+	/// \return number of slots
+	inline unsigned int slots() const { return this->values_.size(); }
+
+	/// \brief tell whether the element in a slot is still there
+	///
+	/// \param slot to check
+	///
+	/// \return true if the slot is alive
+	inline bool alive(unsigned int slot) const { return this->alive_[slot]; }
+
+
+	/// \brief find the slot of the element at a given rank
+	///
+	/// \param rank of element (0 is the first one, must be less than size())
+	///
+	/// \return slot of the element
+	inline unsigned int slotOf(unsigned int) const;
+
+	/// \brief find the rank of the element in a slot
+	///
+	/// \param slot of element (must be alive)
+	///
+	/// \return rank of the element (0 is the first one)
+	inline unsigned int rankOf(unsigned int slot) const
+	{
+		return this->prefix(slot);
+	}
+
+
+	/// \brief get the element in a slot
+	///
+	/// \param slot of element
+	///
+	/// \return reference to the element
+	inline T & operator[](unsigned int slot) { return this->values_[slot]; }
+
+	/// \brief get the element in a slot
+	///
+	/// \param slot of element
+	///
+	/// \return const reference to the element
+	inline T const & operator[](unsigned int slot) const
+	{
+		return this->values_[slot];
+	}
+
+	/// \brief get the element at a given rank
+	///
+	/// \param rank of element (0 is the first one)
+	///
+	/// \return reference to the element
+	inline T & at(unsigned int rank) { return this->values_[this->slotOf(rank)]; }
+
+	/// \brief get the element at a given rank
+	///
+	/// \param rank of element (0 is the first one)
+	///
+	/// \return const reference to the element
+	inline T const & at(unsigned int rank) const
+	{
+		return this->values_[this->slotOf(rank)];
+	}
+
+
+	/// \brief get the first alive slot
+	///
+	/// \return the slot or slots() if the sequence is empty
+	inline unsigned int first() const { return this->first_; }
+
+	/// \brief get the next alive slot
+	///
+	/// \param slot to start from
+	///
+	/// \return the next alive slot or slots() if there is none
+	inline unsigned int next(unsigned int) const;
+
+	/// \brief get the previous alive slot
+	///
+	/// \param slot to start from
+	///
+	/// \return the previous alive slot or the same slot if there is none
+	inline unsigned int previous(unsigned int) const;
+
+
+private:
+	/// \brief count alive slots before a slot
+	///
+	/// \param slot to count up to (exclusive)
+	///
+	/// \return number of alive slots before it
+	inline unsigned int prefix(unsigned int) const;
+
+	/// \brief add to the Fenwick tree
+	///
+	/// \param slot whose count changes
+	/// \param difference to add (+1 or -1, as an unsigned, wrapping)
+	inline void add(unsigned int, unsigned int);
+
+private:
+	Vector<T, Storage> values_; ///< elements by slot
+	Vector<unsigned char, Storage> alive_; ///< 1 for alive slots, 0 for dead
+	Vector<unsigned int, Storage> tree_; ///< Fenwick tree of alive_ (1-based)
+	unsigned int number_of_elements_; ///< number of alive slots
+	unsigned int first_; ///< slots before this one are all dead
+}; // class IndexedSequence
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+template <typename T, typename Storage>
+template <typename U>
+unsigned int IndexedSequence<T, Storage>::append(U && val)
+{
+	unsigned int slot = this->values_.size();
+	this->values_.push_back(std::forward<U>(val));
+	this->alive_.push_back(1);
+
+	// Fenwick node i covers (i - lowbit(i), i], fill it from the prefix sums
+	unsigned int i = slot + 1;
+	unsigned int low = i - (i & (~i + 1));
+	this->tree_.push_back(this->prefix(slot) - this->prefix(low) + 1);
+
+	if (this->number_of_elements_ == 0)
+	{
+		this->first_ = slot;
+	}
+	++this->number_of_elements_;
+
+	return slot;
+}
+
+template <typename T, typename Storage>
+void IndexedSequence<T, Storage>::erase(unsigned int slot)
+{
+	// let go of whatever the value holds
+	this->values_[slot] = T();
+	this->alive_[slot] = 0;
+	this->add(slot, ~0u);
+	--this->number_of_elements_;
+
+	// keep first() O(1) when erasing from the front
+	if (slot == this->first_)
+	{
+		this->first_ = this->next(slot);
+	}
+}
+
+template <typename T, typename Storage>
+void IndexedSequence<T, Storage>::compact()
+{
+	unsigned int alive = 0;
+	for (unsigned int k = 0; k < this->values_.size(); ++k)
+	{
+		if (this->alive_[k])
+		{
+			if (alive != k)
+			{
+				this->values_[alive] = std::move(this->values_[k]);
+			}
+			++alive;
+		}
+	}
+	while (this->values_.size() > alive)
+	{
+		this->values_.pop_back();
+	}
+
+	// every slot is alive now: node i of the tree covers lowbit(i) slots
+	this->alive_.clear();
+	this->alive_.resize(alive, 1);
+	this->tree_.clear();
+	for (unsigned int i = 1; i <= alive; ++i)
+	{
+		this->tree_.push_back(i & (~i + 1));
+	}
+	this->first_ = 0;
+}
+
+template <typename T, typename Storage>
+void IndexedSequence<T, Storage>::clear()
+{
+	this->values_.clear();
+	this->alive_.clear();
+	this->tree_.clear();
+	this->number_of_elements_ = 0;
+	this->first_ = 0;
+}
+
+template <typename T, typename Storage>
+unsigned int IndexedSequence<T, Storage>::slotOf(unsigned int rank) const
+{
+	// descend the implicit tree looking for the (rank + 1)-th alive slot
+	unsigned int n = this->tree_.size();
+	unsigned int step = 1;
+	while (step * 2 <= n)
+	{
+		step *= 2;
+	}
+
+	unsigned int position = 0; // 1-based index of the last skipped node
+	unsigned int remaining = rank + 1;
+	for (; step != 0; step /= 2)
+	{
+		unsigned int candidate = position + step;
+		if (candidate <= n && this->tree_[candidate - 1] < remaining)
+		{
+			position = candidate;
+			remaining -= this->tree_[candidate - 1];
+		}
+	}
+
+	// position slots hold exactly rank alive ones, the next one is ours
+	return position;
+}
+
+template <typename T, typename Storage>
+unsigned int IndexedSequence<T, Storage>::next(unsigned int slot) const
+{
+	unsigned int n = this->values_.size();
+	if (slot >= n)
+	{
+		return n;
+	}
+
+	do
+	{
+		++slot;
+	}
+	while (slot < n && !this->alive_[slot]);
+
+	return slot;
+}
+
+template <typename T, typename Storage>
+unsigned int IndexedSequence<T, Storage>::previous(unsigned int slot) const
+{
+	unsigned int k = slot;
+	while (k > 0)
+	{
+		--k;
+		if (this->alive_[k])
+		{
+			return k;
+		}
+	}
+
+	return slot;
+}
+
+template <typename T, typename Storage>
+unsigned int IndexedSequence<T, Storage>::prefix(unsigned int slot) const
+{
+	unsigned int sum = 0;
+	for (unsigned int i = slot; i > 0; i -= i & (~i + 1))
+	{
+		sum += this->tree_[i - 1];
+	}
+	return sum;
+}
+
+template <typename T, typename Storage>
+void IndexedSequence<T, Storage>::add(unsigned int slot, unsigned int difference)
+{
+	for (unsigned int i = slot + 1; i <= this->tree_.size(); i += i & (~i + 1))
+	{
+		this->tree_[i - 1] += difference;
+	}
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_INDEXED_SEQUENCE_HXX
@@ -5,6 +5,10 @@
 ///
 /// \brief re-implementation of std::List<T>
 
+#include "nostl/allocator.hxx"
+
+#include <utility>
+
 /// \brief namespace for STL reimplementations
 namespace nostl {
 
@@ -15,11 +19,14 @@ namespace nostl {
 /// \brief re-implementation of std::List<T>
 ///
 /// \tparam T type of elements that the List contains
+/// \tparam Allocator allocator policy the Nodes are obtained from
 ///
 /// I had to re-implement the List class because using STL containers was
 /// prohibited. My List is doubly-linked and has two sentinels (a head and a
-/// tail).
-template <typename T>
+/// tail). The sentinels live inside the List object, every other Node comes
+/// from the allocator, which by default is a pool, so filling a List doesn't
+/// call operator new for each element.
+template <typename T, template <typename> class Allocator = PoolAllocator>
 class List {
 public:
 	/// \brief constructor w/o parameters --- only creates sentinels
@@ -33,6 +40,14 @@ public:
 	/// only copy pointers to the head and tail of the List.
 	inline List(List const &);
 
+	/// \brief move constructor
+	///
+	/// \param List to steal the elements of (it is left empty)
+	///
+	/// Takes over the Nodes and the allocator of the other List in O(1), none
+	/// of the elements are copied or moved one by one.
+	inline List(List &&);
+
 	/// \brief assignment operator
 	///
 	/// \param List to set *this* equal to
@@ -40,17 +55,42 @@ public:
 	/// \return the List itself
 	inline List & operator=(List const &);
 
+	/// \brief move assignment operator
+	///
+	/// \param List to steal the elements of (it is left empty)
+	///
+	/// \return the List itself
+	inline List & operator=(List &&);
+
 
 	/// \brief add element to end of List
 	///
 	/// \param value of new element
 	inline void append(T const &);
 
+	/// \brief add element to end of List by moving it in
+	///
+	/// \param value of new element
+	inline void append(T &&);
+
+	/// \brief construct element in place at the end of List
+	///
+	/// \tparam Args types of constructor arguments
+	///
+	/// \param args arguments forwarded to the constructor of T
+	template <typename... Args>
+	inline void emplace_back(Args &&... args);
+
 	/// \brief add element to beginning of List
 	///
 	/// \param value of new element
 	inline void prepend(T const &);
 
+	/// \brief add element to beginning of List by moving it in
+	///
+	/// \param value of new element
+	inline void prepend(T &&);
+
 	/// \brief remove an element from the List
 	///
 	/// \param value of element to remove
@@ -74,21 +114,21 @@ public:
 	/// \param List to check equality with
 	///
 	/// \return true if all elements of the Lists match
-	inline bool operator==(List<T> const &) const;
+	inline bool operator==(List const &) const;
 
 	/// \brief inequality operator
 	///
 	/// \param List to check inequality with
 	///
 	/// \return true if the Lists differ somehow
-	inline bool operator!=(List<T> const &) const;
+	inline bool operator!=(List const &) const;
 
 
 	/// \brief destructor
 	///
 	/// The default destructor function needs to be overridden because the class
 	/// uses dynamic memory allocation
-	inline ~List();
+	inline ~List() { this->clear(); }
 
 
 private:
@@ -97,6 +137,17 @@ private:
 	/// Each Node has a value and knows the preceding and succeeding Node's
 	/// address
 	struct Node {
+		/// \brief constructor for sentinels (value is left default)
+		Node() : value_(), previous_(nullptr), next_(nullptr) {}
+
+		/// \brief constructor for actual elements
+		///
+		/// \param args arguments forwarded to the constructor of the value
+		template <typename... Args>
+		Node(Args &&... args)
+			:	value_(std::forward<Args>(args)...),
+				previous_(nullptr), next_(nullptr) {}
+
 		T value_; ///< the actual value that is stored by the Node
 		Node * previous_; ///< address of preceding Node
 		Node * next_; ///< address of succeeding Node
@@ -113,10 +164,28 @@ private:
 	/// \note the function returns the *first* occurrence of the value passed
 	Node * find(T const &) const;
 
+	/// \brief link a freshly constructed Node in between two others
+	///
+	/// \param Node to link in
+	/// \param Node that will precede it
+	/// \param Node that will succeed it
+	inline void link(Node *, Node *, Node *);
+
+	/// \brief unlink a Node, destroy it and give its storage back
+	///
+	/// \param Node to get rid of
+	inline void unlink(Node *);
+
+	/// \brief take over all Nodes of another List (*this* must be empty)
+	///
+	/// \param List to steal from (it is left empty)
+	inline void steal(List &);
+
 private:
-	Node * head_; ///< head sentinel (its value is irrelevant)
-	Node * tail_; ///< tail sentinel (its value is irrelevant)
+	Node head_; ///< head sentinel (its value is irrelevant)
+	Node tail_; ///< tail sentinel (its value is irrelevant)
 	unsigned int number_of_elements_; ///< size of the List
+	Allocator<Node> allocator_; ///< where the Nodes come from
 
 
 public:
@@ -216,44 +285,52 @@ public:
 // INLINE DEFINITIONS //
 ////////////////////////
 
-template <typename T>
-List<T>::List()
+template <typename T, template <typename> class Allocator>
+List<T, Allocator>::List()
 {
 	this->number_of_elements_ = 0;
 
-	this->head_ = new Node;
-	this->tail_ = new Node;
-
-	this->head_->previous_ = nullptr;
-	this->head_->next_ = this->tail_;
+	this->head_.previous_ = nullptr;
+	this->head_.next_ = &this->tail_;
 
-	this->tail_->previous_ = this->head_;
-	this->tail_->next_ = nullptr;
+	this->tail_.previous_ = &this->head_;
+	this->tail_.next_ = nullptr;
 }
 
-template <typename T>
-List<T>::List(List const & obj)
+template <typename T, template <typename> class Allocator>
+List<T, Allocator>::List(List const & obj)
 {
 	// initiating empty list
-	this->head_ = new Node;
-	this->tail_ = new Node;
-	this->head_->previous_ = nullptr;
-	this->head_->next_ = this->tail_;
-	this->tail_->previous_ = this->head_;
-	this->tail_->next_ = nullptr;
+	this->head_.previous_ = nullptr;
+	this->head_.next_ = &this->tail_;
+	this->tail_.previous_ = &this->head_;
+	this->tail_.next_ = nullptr;
 	this->number_of_elements_ = 0;
 
 	// copying list
-	Node * traveller = obj.head_->next_;
-	while (traveller->next_ != obj.tail_)
+	Node * traveller = obj.head_.next_;
+	while (traveller != &obj.tail_)
 	{
 		this->append(traveller->value_); // this also sets the node counter
 		traveller = traveller->next_;
 	}
 }
 
-template <typename T>
-List<T> & List<T>::operator=(List<T> const & rhs)
+template <typename T, template <typename> class Allocator>
+List<T, Allocator>::List(List && obj)
+{
+	// initiating empty list
+	this->head_.previous_ = nullptr;
+	this->head_.next_ = &this->tail_;
+	this->tail_.previous_ = &this->head_;
+	this->tail_.next_ = nullptr;
+	this->number_of_elements_ = 0;
+
+	this->steal(obj);
+}
+
+template <typename T, template <typename> class Allocator>
+List<T, Allocator> & List<T, Allocator>::operator=(List const & rhs)
 {
 	// checking for self-assignment
 	if (this == &rhs)
@@ -271,8 +348,8 @@ List<T> & List<T>::operator=(List<T> const & rhs)
 	}
 
 	// copying list
-	Node * traveller = rhs.head_->next_;
-	while (traveller != rhs.tail_)
+	Node * traveller = rhs.head_.next_;
+	while (traveller != &rhs.tail_)
 	{
 		this->append(traveller->value_); // this also sets the node counter
 		traveller = traveller->next_;
@@ -280,87 +357,98 @@ List<T> & List<T>::operator=(List<T> const & rhs)
 
 	return *this;
 }
+template <typename T, template <typename> class Allocator>
+List<T, Allocator> & List<T, Allocator>::operator=(List && rhs)
+{
+	// checking for self-assignment
+	if (this == &rhs)
+	{
+		return *this;
+	}
 
+	// clearing current list, then taking over the other one's Nodes
+	this->clear();
+	this->steal(rhs);
 
+	return *this;
+}
 
 
-template <typename T>
-void List<T>::append(T const & val)
-{
-	Node * new_node = new Node;
-	new_node->value_ = val;
-
-	// setting new_node's pointers
-	new_node->previous_ = this->tail_->previous_;
-	new_node->next_ = this->tail_;
 
-	// setting neighbouring nodes' pointers
-	new_node->previous_->next_ = new_node;
-	new_node->next_->previous_ = new_node;
 
-	// incrementing counter
-	++this->number_of_elements_;
+template <typename T, template <typename> class Allocator>
+void List<T, Allocator>::append(T const & val)
+{
+	Node * new_node = new (this->allocator_.allocate()) Node(val);
+	this->link(new_node, this->tail_.previous_, &this->tail_);
 }
 
-template <typename T>
-void List<T>::prepend(T const & val)
+template <typename T, template <typename> class Allocator>
+void List<T, Allocator>::append(T && val)
 {
-	Node * new_node = new Node;
-	new_node->value_ = val;
+	Node * new_node = new (this->allocator_.allocate()) Node(std::move(val));
+	this->link(new_node, this->tail_.previous_, &this->tail_);
+}
 
-	// setting new_node's pointers
-	new_node->previous_ = this->head_;
-	new_node->next_ = this->head_->next_;
+template <typename T, template <typename> class Allocator>
+template <typename... Args>
+void List<T, Allocator>::emplace_back(Args &&... args)
+{
+	Node * new_node = new (this->allocator_.allocate())
+										Node(std::forward<Args>(args)...);
+	this->link(new_node, this->tail_.previous_, &this->tail_);
+}
 
-	// setting neighbouring nodes' pointers
-	new_node->previous_->next_ = new_node;
-	new_node->next_->previous_ = new_node;
+template <typename T, template <typename> class Allocator>
+void List<T, Allocator>::prepend(T const & val)
+{
+	Node * new_node = new (this->allocator_.allocate()) Node(val);
+	this->link(new_node, &this->head_, this->head_.next_);
+}
 
-	// incrementing counter
-	++this->number_of_elements_;
+template <typename T, template <typename> class Allocator>
+void List<T, Allocator>::prepend(T && val)
+{
+	Node * new_node = new (this->allocator_.allocate()) Node(std::move(val));
+	this->link(new_node, &this->head_, this->head_.next_);
 }
 
-template <typename T>
-void List<T>::remove(T const & val)
+template <typename T, template <typename> class Allocator>
+void List<T, Allocator>::remove(T const & val)
 {
 	// find node
 	Node * delendum = find(val);
 
 	if (delendum != nullptr)
 	{
-		// set neighbouring nodes' pointers
-		delendum->previous_->next_ = delendum->next_;
-		delendum->next_->previous_ = delendum->previous_;
-
-		// delete delendum
-		delete delendum;
-
-		// decrementing node counter
-		--this->number_of_elements_;
+		this->unlink(delendum);
 	}
 }
 
-template <typename T>
-void List<T>::clear()
+template <typename T, template <typename> class Allocator>
+void List<T, Allocator>::clear()
 {
-	// traverse list and delete nodes between sentinels
-	Node * traveller = this->head_->next_;
-	while (traveller != this->tail_)
+	// traverse list and destroy nodes between sentinels
+	Node * traveller = this->head_.next_;
+	while (traveller != &this->tail_)
 	{
+		Node * delendum = traveller;
 		traveller = traveller->next_;
-		delete traveller->previous_;
+
+		delendum->~Node();
+		this->allocator_.deallocate(delendum);
 	}
 
 	// resetting pointers of sentinels
-	this->head_->next_ = this->tail_;
-	this->tail_->previous_ = this->head_;
+	this->head_.next_ = &this->tail_;
+	this->tail_.previous_ = &this->head_;
 
 	// zero node counter
 	this->number_of_elements_ = 0;
 }
 
-template <typename T>
-bool List<T>::operator==(List<T> const & rhs) const
+template <typename T, template <typename> class Allocator>
+bool List<T, Allocator>::operator==(List const & rhs) const
 {
 	// the lists cannot be equal if their size differs
 	if (this->size() != rhs.size())
@@ -369,8 +457,8 @@ bool List<T>::operator==(List<T> const & rhs) const
 	}
 
 	// iterate through both lists, comparing each element
-	List<T>::Iterator i = this->begin();
-	List<T>::Iterator j = rhs.begin();
+	Iterator i = this->begin();
+	Iterator j = rhs.begin();
 	while (i != this->end())
 	{
 		// if two elements don't match up, the Lists are different
@@ -384,36 +472,25 @@ bool List<T>::operator==(List<T> const & rhs) const
 	return true;
 }
 
-template <typename T>
-bool List<T>::operator!=(List<T> const & rhs) const
+template <typename T, template <typename> class Allocator>
+bool List<T, Allocator>::operator!=(List const & rhs) const
 {
 	return !(*this == rhs);
 }
 
-template <typename T>
-List<T>::~List()
-{
-	// clear list
-	this->clear();
-
-	// delete sentinels
-	delete this->head_;
-	delete this->tail_;
-}
-
-template <typename T>
-List<T>::Iterator::Iterator(Node * where_to_point,
-							Node * first_sentinel,
-							Node * last_sentinel
-							)
+template <typename T, template <typename> class Allocator>
+List<T, Allocator>::Iterator::Iterator(Node * where_to_point,
+										Node * first_sentinel,
+										Node * last_sentinel
+										)
 {
 	this->current_ = where_to_point;
 	this->first_sentinel_ = first_sentinel;
 	this->last_sentinel_ = last_sentinel;
 }
 
-template <typename T>
-typename List<T>::Iterator List<T>::Iterator::operator++()
+template <typename T, template <typename> class Allocator>
+typename List<T, Allocator>::Iterator List<T, Allocator>::Iterator::operator++()
 {
 	if (this->current_ != this->last_sentinel_)
 	{
@@ -422,8 +499,9 @@ typename List<T>::Iterator List<T>::Iterator::operator++()
 	return *this;
 }
 
-template <typename T>
-typename List<T>::Iterator List<T>::Iterator::operator++(int)
+template <typename T, template <typename> class Allocator>
+typename List<T, Allocator>::Iterator
+List<T, Allocator>::Iterator::operator++(int)
 {
 	Iterator rv = *this;
 	if (this->current_ != this->last_sentinel_)
@@ -433,8 +511,8 @@ typename List<T>::Iterator List<T>::Iterator::operator++(int)
 	return rv;
 }
 
-template <typename T>
-typename List<T>::Iterator List<T>::Iterator::operator--()
+template <typename T, template <typename> class Allocator>
+typename List<T, Allocator>::Iterator List<T, Allocator>::Iterator::operator--()
 {
 	if (this->current_->previous_ != this->first_sentinel_)
 	{
@@ -443,8 +521,9 @@ typename List<T>::Iterator List<T>::Iterator::operator--()
 	return *this;
 }
 
-template <typename T>
-typename List<T>::Iterator List<T>::Iterator::operator--(int)
+template <typename T, template <typename> class Allocator>
+typename List<T, Allocator>::Iterator
+List<T, Allocator>::Iterator::operator--(int)
 {
 	Iterator rv = *this;
 	if (this->current_->previous_ != this->first_sentinel_)
@@ -454,32 +533,38 @@ typename List<T>::Iterator List<T>::Iterator::operator--(int)
 	return rv;
 }
 
-template <typename T>
-bool List<T>::Iterator::operator==(Iterator const & rhs) const
+template <typename T, template <typename> class Allocator>
+bool List<T, Allocator>::Iterator::operator==(Iterator const & rhs) const
 {
 	return this->current_ == rhs.current_;
 }
 
-template <typename T>
-bool List<T>::Iterator::operator!=(Iterator const & rhs) const
+template <typename T, template <typename> class Allocator>
+bool List<T, Allocator>::Iterator::operator!=(Iterator const & rhs) const
 {
 	return !(*this == rhs);
 }
-	
-template <typename T>
-typename List<T>::Iterator List<T>::begin() const
+
+template <typename T, template <typename> class Allocator>
+typename List<T, Allocator>::Iterator List<T, Allocator>::begin() const
 {
-	return Iterator(this->head_->next_, this->head_, this->tail_);
+	// sentinels are members, hence the casts in a const method
+	Node * head = const_cast<Node *>(&this->head_);
+	Node * tail = const_cast<Node *>(&this->tail_);
+	return Iterator(head->next_, head, tail);
 }
 
-template <typename T>
-typename List<T>::Iterator List<T>::end() const
+template <typename T, template <typename> class Allocator>
+typename List<T, Allocator>::Iterator List<T, Allocator>::end() const
 {
-	return Iterator(this->tail_, this->head_, this->tail_);
+	// sentinels are members, hence the casts in a const method
+	Node * head = const_cast<Node *>(&this->head_);
+	Node * tail = const_cast<Node *>(&this->tail_);
+	return Iterator(tail, head, tail);
 }
 
-template <typename T>
-typename List<T>::Node * List<T>::find(T const & val) const
+template <typename T, template <typename> class Allocator>
+typename List<T, Allocator>::Node * List<T, Allocator>::find(T const & val) const
 {
 	// if the List is empty, nothing will be found
 	if (this->size() == 0)
@@ -487,10 +572,10 @@ typename List<T>::Node * List<T>::find(T const & val) const
 		return nullptr;
 	}
 
-	Node * traveller = this->head_->next_;
+	Node * traveller = this->head_.next_;
 
 	// traverse list to find node
-	while(traveller != this->tail_)
+	while(traveller != &this->tail_)
 	{
 		if (traveller->value_ == val)
 		{
@@ -504,6 +589,61 @@ typename List<T>::Node * List<T>::find(T const & val) const
 	return nullptr;
 }
 
+template <typename T, template <typename> class Allocator>
+void List<T, Allocator>::link(Node * new_node, Node * previous, Node * next)
+{
+	// setting new_node's pointers
+	new_node->previous_ = previous;
+	new_node->next_ = next;
+
+	// setting neighbouring nodes' pointers
+	previous->next_ = new_node;
+	next->previous_ = new_node;
+
+	// incrementing counter
+	++this->number_of_elements_;
+}
+
+template <typename T, template <typename> class Allocator>
+void List<T, Allocator>::unlink(Node * delendum)
+{
+	// set neighbouring nodes' pointers
+	delendum->previous_->next_ = delendum->next_;
+	delendum->next_->previous_ = delendum->previous_;
+
+	// destroy delendum and give its storage back to the allocator
+	delendum->~Node();
+	this->allocator_.deallocate(delendum);
+
+	// decrementing node counter
+	--this->number_of_elements_;
+}
+
+template <typename T, template <typename> class Allocator>
+void List<T, Allocator>::steal(List & obj)
+{
+	// the Nodes belong to the other allocator, so that has to come along too
+	this->allocator_.swap(obj.allocator_);
+
+	// nothing to relink if the other List is empty
+	if (obj.size() == 0)
+	{
+		return;
+	}
+
+	// hook the other List's chain of Nodes between our sentinels
+	this->head_.next_ = obj.head_.next_;
+	this->head_.next_->previous_ = &this->head_;
+	this->tail_.previous_ = obj.tail_.previous_;
+	this->tail_.previous_->next_ = &this->tail_;
+	this->number_of_elements_ = obj.number_of_elements_;
+
+	// leave the other List empty
+	obj.head_.next_ = &obj.tail_;
+	obj.tail_.previous_ = &obj.head_;
+	obj.number_of_elements_ = 0;
+}
+
 } // namespace nostl
 
 #endif // BANCH_NOSTL_LIST_H
@@ -0,0 +1,442 @@
+#ifndef BANCH_NOSTL_RADIX_TRIE_HXX
+#define BANCH_NOSTL_RADIX_TRIE_HXX
+
+/// \file radix_trie.hxx
+///
+/// \brief compressed trie of strings for prefix lookups
+
+#include "nostl/allocator.hxx"
+#include "nostl/vector.hxx"
+
+#include <new>
+#include <string>
+#include <utility>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief map from strings to values that can list the keys with a prefix
+///
+/// \tparam V type of values (default constructible)
+/// \tparam Allocator allocator policy the Nodes are obtained from
+///
+/// Chains of Nodes with a single child are merged into one Node with a longer
+/// label (a radix or Patricia trie), so there are at most twice as many
+/// Nodes as keys. The children of a Node are kept sorted by the first
+/// character of their labels, which makes every step down a binary search
+/// and puts the keys in lexicographic order for free: the first k keys with
+/// a prefix take time proportional to the prefix plus what is returned.
+template <typename V, template <typename> class Allocator = PoolAllocator>
+class RadixTrie {
+public:
+	/// \brief a key and its value, as returned by complete()
+	struct Entry {
+		std::string key; ///< the key
+		V const * value; ///< the value (until the trie is changed)
+	}; // struct Entry
+
+
+	/// \brief constructor w/o parameters (empty trie)
+	inline RadixTrie() : root_(std::string()), number_of_elements_(0) {}
+
+
+	/// \brief add a key with a value, unless the key is there already
+	///
+	/// \param key to add
+	/// \param value to map it to
+	///
+	/// \return false if the key was already there (its value is untouched)
+	inline bool insert(std::string const & key, V value);
+
+	/// \brief get the value of a key, adding the key if it's missing
+	///
+	/// \param key to look up
+	///
+	/// \return reference to the value (default constructed if it was missing)
+	inline V & operator[](std::string const & key);
+
+	/// \brief remove a key
+	///
+	/// \param key to remove
+	///
+	/// \return false if the key wasn't there
+	inline bool remove(std::string const & key);
+
+	/// \brief clear the trie (i.e. remove all keys)
+	inline void clear();
+
+
+	/// \brief find the value of a key
+	///
+	/// \param key to look up
+	///
+	/// \return pointer to the value or nullptr if the key isn't there
+	inline V * find(std::string const & key)
+	{
+		Node * node = this->at(key, false);
+		return node != nullptr && node->terminal_ ? &node->value_ : nullptr;
+	}
+
+	/// \brief find the value of a key
+	///
+	/// \param key to look up
+	///
+	/// \return pointer to the value or nullptr if the key isn't there
+	inline V const * find(std::string const & key) const
+	{
+		return const_cast<RadixTrie *>(this)->find(key);
+	}
+
+	/// \brief list the first keys (in lexicographic order) with a prefix
+	///
+	/// \param prefix the keys have to start with
+	/// \param k most keys to list
+	///
+	/// \return the keys with their values
+	inline Vector<Entry> complete(std::string const & prefix,
+									unsigned int k) const;
+
+	/// \brief get the number of keys
+	///
+	/// \return the trie's size
+	inline unsigned int size() const { return this->number_of_elements_; }
+
+	/// \brief tell whether the trie is empty
+	///
+	/// \return true if there are no keys
+	inline bool empty() const { return this->number_of_elements_ == 0; }
+
+
+	/// \brief copy constructor (deleted, Nodes have a single owner)
+	RadixTrie(RadixTrie const &) = delete;
+
+	/// \brief copy assignment (deleted, Nodes have a single owner)
+	RadixTrie & operator=(RadixTrie const &) = delete;
+
+	/// \brief destructor (frees memory)
+	inline ~RadixTrie() { this->clear(); }
+
+
+private:
+	/// \brief a Node of the trie
+	struct Node {
+		/// \brief constructor
+		///
+		/// \param label characters on the edge into the Node
+		explicit Node(std::string label)
+			: label_(std::move(label)), terminal_(false), value_() {}
+
+		std::string label_; ///< characters on the edge into the Node
+		Vector<Node *> children_; ///< sorted by first character of label
+		bool terminal_; ///< true if a key ends here
+		V value_; ///< value of the key ending here (if terminal)
+	}; // struct Node
+
+	/// \brief find the Node a key ends at
+	///
+	/// \param key to look up
+	/// \param create if true, missing Nodes are created (and edges split)
+	///
+	/// \return the Node, or nullptr if there is none and create is false
+	inline Node * at(std::string const & key, bool create);
+
+	/// \brief find the child of a Node whose label starts with a character
+	///
+	/// \param node whose children to search
+	/// \param c first character of the label
+	///
+	/// \return index of the child, or of where it would go
+	static inline unsigned int child(Node const * node, char c);
+
+	/// \brief merge a Node with its only child
+	///
+	/// \param node to merge (not the root, not terminal, one child)
+	inline void merge(Node * node);
+
+	/// \brief collect keys in lexicographic order
+	///
+	/// \param node to start at
+	/// \param key characters up to and including node's label
+	/// \param k most keys to collect in total
+	/// \param entries to collect into
+	inline void collect(Node const * node, std::string & key, unsigned int k,
+						Vector<Entry> & entries) const;
+
+	/// \brief destroy a Node with all its descendants
+	///
+	/// \param node to destroy
+	inline void destroy(Node * node);
+
+private:
+	Node root_; ///< root (its label is empty, it never goes away)
+	unsigned int number_of_elements_; ///< number of keys
+	Allocator<Node> allocator_; ///< where the Nodes come from
+}; // class RadixTrie
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+template <typename V, template <typename> class Allocator>
+bool RadixTrie<V, Allocator>::insert(std::string const & key, V value)
+{
+	Node * node = this->at(key, true);
+	if (node->terminal_)
+	{
+		return false;
+	}
+
+	node->terminal_ = true;
+	node->value_ = std::move(value);
+	++this->number_of_elements_;
+	return true;
+}
+
+template <typename V, template <typename> class Allocator>
+V & RadixTrie<V, Allocator>::operator[](std::string const & key)
+{
+	Node * node = this->at(key, true);
+	if (!node->terminal_)
+	{
+		node->terminal_ = true;
+		node->value_ = V();
+		++this->number_of_elements_;
+	}
+	return node->value_;
+}
+
+template <typename V, template <typename> class Allocator>
+bool RadixTrie<V, Allocator>::remove(std::string const & key)
+{
+	// remember the way down, Nodes may have to be merged on the way back
+	Vector<Node *> path;
+	Node * node = &this->root_;
+	unsigned int position = 0;
+	while (position < key.size())
+	{
+		unsigned int k = child(node, key[position]);
+		if (k == node->children_.size())
+		{
+			return false;
+		}
+		Node * next = node->children_[k];
+		if (next->label_[0] != key[position] ||
+				key.compare(position, next->label_.size(), next->label_) != 0)
+		{
+			return false;
+		}
+		path.push_back(node);
+		node = next;
+		position += node->label_.size();
+	}
+	if (!node->terminal_)
+	{
+		return false;
+	}
+
+	node->terminal_ = false;
+	node->value_ = V();
+	--this->number_of_elements_;
+	if (node == &this->root_)
+	{
+		return true;
+	}
+
+	// a leaf goes away (which may leave its parent with a single child), a
+	// Node with a single child merges with it
+	if (node->children_.empty())
+	{
+		Node * parent = path.back();
+		parent->children_.erase(child(parent, node->label_[0]));
+		this->destroy(node);
+		node = parent;
+	}
+	if (node != &this->root_ && !node->terminal_ &&
+			node->children_.size() == 1)
+	{
+		this->merge(node);
+	}
+	return true;
+}
+
+template <typename V, template <typename> class Allocator>
+void RadixTrie<V, Allocator>::clear()
+{
+	for (unsigned int k = 0; k < this->root_.children_.size(); ++k)
+	{
+		this->destroy(this->root_.children_[k]);
+	}
+	this->root_.children_.clear();
+	this->root_.terminal_ = false;
+	this->root_.value_ = V();
+	this->number_of_elements_ = 0;
+}
+
+template <typename V, template <typename> class Allocator>
+Vector<typename RadixTrie<V, Allocator>::Entry>
+RadixTrie<V, Allocator>::complete(std::string const & prefix,
+									unsigned int k) const
+{
+	Vector<Entry> entries;
+
+	// walk down the prefix, it may end in the middle of a label
+	Node const * node = &this->root_;
+	std::string key;
+	unsigned int position = 0;
+	while (position < prefix.size())
+	{
+		unsigned int j = child(node, prefix[position]);
+		if (j == node->children_.size())
+		{
+			return entries;
+		}
+		node = node->children_[j];
+		unsigned int rest = prefix.size() - position;
+		unsigned int length = rest < node->label_.size() ? rest
+														: node->label_.size();
+		if (node->label_.compare(0, length, prefix, position, length) != 0)
+		{
+			return entries;
+		}
+		key += node->label_;
+		position += length;
+	}
+
+	this->collect(node, key, k, entries);
+	return entries;
+}
+
+template <typename V, template <typename> class Allocator>
+typename RadixTrie<V, Allocator>::Node *
+RadixTrie<V, Allocator>::at(std::string const & key, bool create)
+{
+	Node * node = &this->root_;
+	unsigned int position = 0;
+	while (position < key.size())
+	{
+		unsigned int k = child(node, key[position]);
+		if (k == node->children_.size() ||
+				node->children_[k]->label_[0] != key[position])
+		{
+			if (!create)
+			{
+				return nullptr;
+			}
+
+			// the rest of the key becomes a new leaf
+			Node * leaf = new (this->allocator_.allocate())
+												Node(key.substr(position));
+			node->children_.insert(k, leaf);
+			return leaf;
+		}
+
+		Node * next = node->children_[k];
+		unsigned int common = 1;
+		while (common < next->label_.size() &&
+				position + common < key.size() &&
+				next->label_[common] == key[position + common])
+		{
+			++common;
+		}
+
+		if (common < next->label_.size())
+		{
+			if (!create)
+			{
+				return nullptr;
+			}
+
+			// the key leaves the label half way, split the edge there
+			Node * middle = new (this->allocator_.allocate())
+										Node(next->label_.substr(0, common));
+			next->label_.erase(0, common);
+			middle->children_.push_back(next);
+			node->children_[k] = middle;
+			next = middle;
+		}
+
+		node = next;
+		position += common;
+	}
+	return node;
+}
+
+template <typename V, template <typename> class Allocator>
+unsigned int RadixTrie<V, Allocator>::child(Node const * node, char c)
+{
+	unsigned int first = 0, last = node->children_.size();
+	while (first < last)
+	{
+		unsigned int middle = first + (last - first) / 2;
+		if (static_cast<unsigned char>(node->children_[middle]->label_[0]) <
+				static_cast<unsigned char>(c))
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+	return first;
+}
+
+template <typename V, template <typename> class Allocator>
+void RadixTrie<V, Allocator>::merge(Node * node)
+{
+	Node * only = node->children_[0];
+	node->label_ += only->label_;
+	node->terminal_ = only->terminal_;
+	node->value_ = std::move(only->value_);
+	node->children_ = std::move(only->children_);
+	this->destroy(only);
+}
+
+template <typename V, template <typename> class Allocator>
+void RadixTrie<V, Allocator>::collect(Node const * node, std::string & key,
+										unsigned int k,
+										Vector<Entry> & entries) const
+{
+	if (entries.size() == k)
+	{
+		return;
+	}
+
+	// a key comes before the longer ones it's a prefix of
+	if (node->terminal_)
+	{
+		Entry entry = { key, &node->value_ };
+		entries.push_back(entry);
+	}
+
+	for (unsigned int j = 0;
+			j < node->children_.size() && entries.size() < k;
+			++j)
+	{
+		Node const * next = node->children_[j];
+		key += next->label_;
+		this->collect(next, key, k, entries);
+		key.erase(key.size() - next->label_.size());
+	}
+}
+
+template <typename V, template <typename> class Allocator>
+void RadixTrie<V, Allocator>::destroy(Node * node)
+{
+	for (unsigned int k = 0; k < node->children_.size(); ++k)
+	{
+		this->destroy(node->children_[k]);
+	}
+	node->~Node();
+	this->allocator_.deallocate(node);
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_RADIX_TRIE_HXX
@@ -5,18 +5,32 @@
 ///
 /// \brief class to derive classes from that use serialization
 
+#include "nostl/sink.hxx"
+
 #include <iostream>
 
 // TODO this doesn't really belong into this namespace
 namespace nostl {
 
 /// \brief abstract class for a serializable object
+///
+/// \note derived classes override serialize(Sink &) and should bring the
+/// stream overload back into scope with a using-declaration
 class Serializable {
 public:
 	/// \brief virtual serializing function
 	///
-	/// \param stream to serialize into
-	virtual void serialize(std::ostream &) const = 0;
+	/// \param sink to serialize into (flushing is up to the caller)
+	virtual void serialize(Sink &) const = 0;
+
+	/// \brief serializing function for streams
+	///
+	/// \param os stream to serialize into (flushed once, at the end)
+	void serialize(std::ostream & os) const
+	{
+		Sink sink(os);
+		this->serialize(sink);
+	}
 
 
 	/// \brief virtual deserializing function
@@ -6,6 +6,7 @@
 /// \brief re-implementation of std::Set<T>
 
 #include "nostl/list.hxx"
+#include "nostl/unrolled_list.hxx"
 
 /// \brief namespace for STL reimplementations
 namespace nostl {
@@ -13,12 +14,17 @@ namespace nostl {
 /// \brief re-implementation of std::Set<T>
 ///
 /// @tparam T type of elements that the Set contains
+/// @tparam Allocator allocator policy of the underlying List
+/// @tparam Container the kind of List the Set keeps its elements in (List or
+/// UnrolledList)
 ///
 /// I had to re-implement the Set class because using STL containers was
 /// prohibited. This set uses the previously made custom List class. The
 /// only addition is that it checks for multiple addition (a Set may only
-/// contain each element only once).
-template <typename T>
+/// contain each element only once). Sets can be moved in O(1), since the
+/// List they consist of can.
+template <typename T, template <typename> class Allocator = PoolAllocator,
+			template <typename, template <typename> class> class Container = List>
 class Set {
 public:
 	/// \brief add element to the Set
@@ -26,6 +32,20 @@ public:
 	/// \param value of new element
 	inline void insert(T const &);
 
+	/// \brief add element to the Set by moving it in
+	///
+	/// \param value of new element
+	///
+	/// \note the value is left untouched if the Set already contains it
+	inline void insert(T &&);
+
+	/// \brief tell whether an element is in the Set
+	///
+	/// \param value to look for
+	///
+	/// \return true if the Set contains the value
+	inline bool contains(T const &) const;
+
 	/// \brief remove an element from the Set
 	///
 	/// \param value of element to remove
@@ -40,14 +60,14 @@ public:
 	/// \param Set to check equality with
 	///
 	/// \return true if the two Sets are equal
-	inline bool operator==(Set<T> const &) const;
+	inline bool operator==(Set const &) const;
 
 	/// \brief ineqality operator
 	///
 	/// \param Set to check ineqality with
 	///
 	/// \return true if the two Sets differ somehow
-	inline bool operator!=(Set<T> const &) const;
+	inline bool operator!=(Set const &) const;
 
 
 	/// \brief get the size of the Set (i.e. the number of its elements)
@@ -57,7 +77,7 @@ public:
 
 public:
 	/// \brief use the List class's Iterator
-	using Iterator = typename nostl::List<T>::Iterator;
+	using Iterator = typename Container<T, Allocator>::Iterator;
 
 	/// \brief get Iterator to the first element of the Set
 	///
@@ -71,7 +91,7 @@ public:
 
 
 private:
-	List<T> list_; ///< Set is implemented using a doubly-linked List
+	Container<T, Allocator> list_; ///< Set is implemented using a List
 }; // class Set
 
 
@@ -80,48 +100,72 @@ private:
 // INLINE DEFINITIONS //
 ////////////////////////
 
-template <typename T>
-void Set<T>::insert(T const & val)
+template <typename T, template <typename> class Allocator,
+			template <typename, template <typename> class> class Container>
+void Set<T, Allocator, Container>::insert(T const & val)
+{
+	// make sure list/set doesn't contain item yet
+	if (!this->contains(val))
+	{
+		this->list_.append(val);
+	}
+}
+
+template <typename T, template <typename> class Allocator,
+			template <typename, template <typename> class> class Container>
+void Set<T, Allocator, Container>::insert(T && val)
 {
 	// make sure list/set doesn't contain item yet
-	if (this->size() != 0)
+	if (!this->contains(val))
+	{
+		this->list_.append(std::move(val));
+	}
+}
+
+template <typename T, template <typename> class Allocator,
+			template <typename, template <typename> class> class Container>
+bool Set<T, Allocator, Container>::contains(T const & val) const
+{
+	for (Iterator i = this->list_.begin(); i != this->list_.end(); ++i)
 	{
-		for (typename List<T>::Iterator i = this->list_.begin();
-				i != this->list_.end(); ++i)
+		if (*i == val)
 		{
-			if (*i == val)
-			{
-				return;
-			}
+			return true;
 		}
 	}
 
-	this->list_.append(val);
+	return false;
 }
 
-template <typename T>
-bool Set<T>::operator==(Set<T> const & rhs) const
+template <typename T, template <typename> class Allocator,
+			template <typename, template <typename> class> class Container>
+bool Set<T, Allocator, Container>::operator==(Set const & rhs) const
 {
 	return (this->list_ == rhs.list_);
 }
 
-template <typename T>
-bool Set<T>::operator!=(Set<T> const & rhs) const
+template <typename T, template <typename> class Allocator,
+			template <typename, template <typename> class> class Container>
+bool Set<T, Allocator, Container>::operator!=(Set const & rhs) const
 {
 	return !(*this == rhs);
 }
 
-template <typename T>
-typename Set<T>::Iterator Set<T>::begin() const
+template <typename T, template <typename> class Allocator,
+			template <typename, template <typename> class> class Container>
+typename Set<T, Allocator, Container>::Iterator
+Set<T, Allocator, Container>::begin() const
 {
-	typename List<T>::Iterator i = this->list_.begin();
+	Iterator i = this->list_.begin();
 	return i;
 }
 
-template <typename T>
-typename Set<T>::Iterator Set<T>::end() const
+template <typename T, template <typename> class Allocator,
+			template <typename, template <typename> class> class Container>
+typename Set<T, Allocator, Container>::Iterator
+Set<T, Allocator, Container>::end() const
 {
-	typename List<T>::Iterator i = this->list_.end();
+	Iterator i = this->list_.end();
 	return i;
 }
 
@@ -0,0 +1,261 @@
+#ifndef BANCH_NOSTL_SINK_HXX
+#define BANCH_NOSTL_SINK_HXX
+
+/// \file sink.hxx
+///
+/// \brief buffered output that only flushes when asked to
+
+#include "nostl/cow_string.hxx"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief output buffer in front of a stream or a file descriptor
+///
+/// Everything written is collected in a large buffer that is handed over to
+/// the target only when it's full or at an explicit flush() (and once more on
+/// destruction). Unlike std::endl, '\n' never flushes, so serializing a big
+/// book costs a few large writes instead of one per line.
+class Sink {
+public:
+	/// \brief size of the buffer in bytes
+	static unsigned int const CAPACITY = 1 << 16;
+
+
+	/// \brief constructor that targets a stream
+	///
+	/// \param os stream to hand the bytes over to
+	explicit inline Sink(std::ostream & os);
+
+	/// \brief constructor that targets a file descriptor (bypassing streams)
+	///
+	/// \param fd open file descriptor to write(2) into (not closed by the Sink)
+	explicit inline Sink(int fd);
+
+
+	/// \brief write a range of characters
+	///
+	/// \param data address of first character
+	/// \param size number of characters
+	inline void write(char const *, unsigned int);
+
+	/// \brief write a character
+	///
+	/// \param c character to write
+	///
+	/// \return reference to this
+	inline Sink & operator<<(char);
+
+	/// \brief write a null terminated string
+	///
+	/// \param str string to write
+	///
+	/// \return reference to this
+	inline Sink & operator<<(char const * str)
+	{
+		this->write(str, std::strlen(str));
+		return *this;
+	}
+
+	/// \brief write a string
+	///
+	/// \param str string to write
+	///
+	/// \return reference to this
+	inline Sink & operator<<(std::string const & str)
+	{
+		this->write(str.data(), str.size());
+		return *this;
+	}
+
+	/// \brief write a string
+	///
+	/// \param str string to write
+	///
+	/// \return reference to this
+	inline Sink & operator<<(CowString const & str)
+	{
+		this->write(str.data(), str.size());
+		return *this;
+	}
+
+	/// \brief write an unsigned number in decimal
+	///
+	/// \param value to write
+	///
+	/// \return reference to this
+	inline Sink & operator<<(unsigned long long);
+
+	/// \brief write an unsigned number in decimal
+	///
+	/// \param value to write
+	///
+	/// \return reference to this
+	inline Sink & operator<<(unsigned int value)
+	{
+		return *this << static_cast<unsigned long long>(value);
+	}
+
+
+	/// \brief hand the buffered bytes over to the target (a checkpoint)
+	inline void flush();
+
+	/// \brief tell whether every hand over succeeded
+	///
+	/// \return false if the target reported an error
+	inline bool good() const { return this->good_; }
+
+	/// \brief get the number of hand overs (write(2) calls for descriptors)
+	///
+	/// \return number of writes to the target
+	inline unsigned long writes() const { return this->writes_; }
+
+
+	/// \brief copy constructor (deleted, the buffer has a single owner)
+	Sink(Sink const &) = delete;
+
+	/// \brief copy assignment (deleted, the buffer has a single owner)
+	Sink & operator=(Sink const &) = delete;
+
+	/// \brief destructor (flushes)
+	inline ~Sink() { this->flush(); }
+
+
+private:
+	/// \brief hand the buffered bytes over to the target (no stream flush)
+	inline void drain();
+
+	/// \brief hand a range of bytes over to the target
+	///
+	/// \param data address of first byte
+	/// \param size number of bytes
+	inline void handOver(char const *, unsigned int);
+
+private:
+	std::ostream * os_; ///< target stream (nullptr if targeting fd_)
+	int fd_; ///< target file descriptor (if os_ is nullptr)
+	char buffer_[CAPACITY]; ///< bytes not handed over yet
+	unsigned int used_; ///< number of bytes in buffer_
+	unsigned long writes_; ///< number of hand overs so far
+	bool good_; ///< false once the target reported an error
+}; // class Sink
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+Sink::Sink(std::ostream & os)
+	: os_(&os), fd_(-1), used_(0), writes_(0), good_(true) {}
+
+Sink::Sink(int fd)
+	: os_(nullptr), fd_(fd), used_(0), writes_(0), good_(true) {}
+
+void Sink::write(char const * data, unsigned int size)
+{
+	if (size > CAPACITY - this->used_)
+	{
+		this->drain();
+
+		// big chunks go straight to the target
+		if (size > CAPACITY)
+		{
+			this->handOver(data, size);
+			return;
+		}
+	}
+
+	std::memcpy(this->buffer_ + this->used_, data, size);
+	this->used_ += size;
+}
+
+Sink & Sink::operator<<(char c)
+{
+	if (this->used_ == CAPACITY)
+	{
+		this->drain();
+	}
+	this->buffer_[this->used_++] = c;
+	return *this;
+}
+
+Sink & Sink::operator<<(unsigned long long value)
+{
+	// digits come out backwards
+	char digits[20];
+	unsigned int k = sizeof(digits);
+	do
+	{
+		digits[--k] = '0' + value % 10;
+		value /= 10;
+	}
+	while (value != 0);
+
+	this->write(digits + k, sizeof(digits) - k);
+	return *this;
+}
+
+void Sink::flush()
+{
+	this->drain();
+	if (this->os_ != nullptr)
+	{
+		this->os_->flush();
+	}
+}
+
+void Sink::drain()
+{
+	if (this->used_ != 0)
+	{
+		this->handOver(this->buffer_, this->used_);
+		this->used_ = 0;
+	}
+}
+
+void Sink::handOver(char const * data, unsigned int size)
+{
+	if (this->os_ != nullptr)
+	{
+		++this->writes_;
+		if (!this->os_->write(data, size))
+		{
+			this->good_ = false;
+		}
+		return;
+	}
+
+	// write(2) may take less than asked for
+	while (size != 0)
+	{
+		++this->writes_;
+		ssize_t written = ::write(this->fd_, data, size);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			this->good_ = false;
+			return;
+		}
+		data += written;
+		size -= written;
+	}
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_SINK_HXX
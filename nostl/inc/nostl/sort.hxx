@@ -0,0 +1,117 @@
+#ifndef BANCH_NOSTL_SORT_HXX
+#define BANCH_NOSTL_SORT_HXX
+
+/// \file sort.hxx
+///
+/// \brief stable sorting of arrays
+
+#include "nostl/vector.hxx"
+
+#include <utility>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+/// \brief default ordering policy (operator<)
+///
+/// \tparam T type of the elements to order
+template <typename T>
+struct Less {
+	/// \brief compare two elements
+	///
+	/// \param lhs left hand side
+	/// \param rhs right hand side
+	///
+	/// \return true if lhs goes before rhs
+	bool operator()(T const & lhs, T const & rhs) const { return lhs < rhs; }
+}; // struct Less
+
+/// \brief sort a range of elements, keeping the order of equal ones
+///
+/// \tparam T type of the elements (movable, default constructible)
+/// \tparam Order function object that tells whether an element goes before
+/// another one
+///
+/// \param begin address of first element
+/// \param end address past the last element
+/// \param order ordering policy instance to use
+///
+/// Bottom-up merge sort: O(n log n) comparisons in the worst case, with a
+/// buffer of n elements. Short runs are insertion sorted first.
+template <typename T, typename Order>
+void sort(T * begin, T * end, Order order)
+{
+	unsigned int const RUN = 16; // length of insertion sorted runs
+	unsigned int size = end - begin;
+
+	// insertion sort the runs
+	for (unsigned int first = 0; first < size; first += RUN)
+	{
+		unsigned int last = first + RUN < size ? first + RUN : size;
+		for (unsigned int k = first + 1; k < last; ++k)
+		{
+			T value = std::move(begin[k]);
+			unsigned int j = k;
+			for (; j > first && order(value, begin[j - 1]); --j)
+			{
+				begin[j] = std::move(begin[j - 1]);
+			}
+			begin[j] = std::move(value);
+		}
+	}
+
+	// merge pairs of runs back and forth between the range and the buffer
+	Vector<T> buffer(size);
+	T * from = begin;
+	T * to = buffer.begin();
+	for (unsigned int width = RUN; width < size; width *= 2)
+	{
+		for (unsigned int first = 0; first < size; first += 2 * width)
+		{
+			unsigned int middle = first + width < size ? first + width : size;
+			unsigned int last = middle + width < size ? middle + width : size;
+			unsigned int i = first, j = middle, k = first;
+			while (i < middle && j < last)
+			{
+				// taking from the left on ties keeps the sort stable
+				to[k++] = std::move(order(from[j], from[i]) ? from[j++]
+															: from[i++]);
+			}
+			while (i < middle)
+			{
+				to[k++] = std::move(from[i++]);
+			}
+			while (j < last)
+			{
+				to[k++] = std::move(from[j++]);
+			}
+		}
+		std::swap(from, to);
+	}
+
+	// the result may have ended up in the buffer
+	if (from != begin)
+	{
+		for (unsigned int k = 0; k < size; ++k)
+		{
+			begin[k] = std::move(from[k]);
+		}
+	}
+}
+
+/// \brief sort a range of elements by operator<, keeping the order of equal
+/// ones
+///
+/// \tparam T type of the elements (movable, default constructible)
+///
+/// \param begin address of first element
+/// \param end address past the last element
+template <typename T>
+inline void sort(T * begin, T * end)
+{
+	sort(begin, end, Less<T>());
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_SORT_HXX
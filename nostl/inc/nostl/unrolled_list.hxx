@@ -0,0 +1,626 @@
+#ifndef BANCH_NOSTL_UNROLLED_LIST_HXX
+#define BANCH_NOSTL_UNROLLED_LIST_HXX
+
+/// \file unrolled_list.hxx
+///
+/// \brief a List that stores several elements per Node
+
+#include "nostl/allocator.hxx"
+
+#include <new>
+#include <utility>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief unrolled doubly-linked list
+///
+/// \tparam T type of elements that the UnrolledList contains
+/// \tparam Allocator allocator policy the Chunks are obtained from
+///
+/// Instead of one element per Node, elements are packed into cache line
+/// aligned Chunks of a few hundred bytes, so traversing the list touches
+/// memory sequentially and chases a pointer every Chunk instead of every
+/// element. It has the same interface as List (iterators included), so the
+/// two can be swapped for each other, e.g. as the backend of a Set.
+///
+/// \note unlike with List, inserting or removing elements invalidates
+/// iterators that point into the same Chunk
+template <typename T, template <typename> class Allocator = PoolAllocator>
+class UnrolledList {
+public:
+	/// \brief constructor w/o parameters --- doesn't allocate anything yet
+	inline UnrolledList() : head_(nullptr), tail_(nullptr),
+							number_of_elements_(0) {}
+
+	/// \brief copy constructor
+	///
+	/// \param UnrolledList to copy
+	inline UnrolledList(UnrolledList const &);
+
+	/// \brief move constructor (O(1), the other UnrolledList is left empty)
+	///
+	/// \param UnrolledList to steal the elements of
+	inline UnrolledList(UnrolledList &&);
+
+	/// \brief assignment operator
+	///
+	/// \param UnrolledList to set *this* equal to
+	///
+	/// \return the UnrolledList itself
+	inline UnrolledList & operator=(UnrolledList const &);
+
+	/// \brief move assignment operator
+	///
+	/// \param UnrolledList to steal the elements of (it is left empty)
+	///
+	/// \return the UnrolledList itself
+	inline UnrolledList & operator=(UnrolledList &&);
+
+
+	/// \brief add element to end of UnrolledList
+	///
+	/// \param value of new element
+	inline void append(T const & val) { this->emplace_back(val); }
+
+	/// \brief add element to end of UnrolledList by moving it in
+	///
+	/// \param value of new element
+	inline void append(T && val) { this->emplace_back(std::move(val)); }
+
+	/// \brief construct element in place at the end of UnrolledList
+	///
+	/// \tparam Args types of constructor arguments
+	///
+	/// \param args arguments forwarded to the constructor of T
+	template <typename... Args>
+	inline void emplace_back(Args &&... args);
+
+	/// \brief add element to beginning of UnrolledList
+	///
+	/// \param value of new element
+	inline void prepend(T const & val) { this->emplace_front(val); }
+
+	/// \brief add element to beginning of UnrolledList by moving it in
+	///
+	/// \param value of new element
+	inline void prepend(T && val) { this->emplace_front(std::move(val)); }
+
+	/// \brief remove an element from the UnrolledList
+	///
+	/// \param value of element to remove
+	///
+	/// \note this function only deletes the first occurrence of the value
+	/// that's passed as a parameter
+	inline void remove(T const &);
+
+	/// \brief clear the list (i.e. remove all of its elements)
+	inline void clear();
+
+
+	/// \brief get the size of the list (i.e. the number of its elements)
+	///
+	/// \return the UnrolledList's size
+	inline unsigned int size() const { return this->number_of_elements_; }
+
+
+	/// \brief equality operator
+	///
+	/// \param UnrolledList to check equality with
+	///
+	/// \return true if all elements of the UnrolledLists match
+	inline bool operator==(UnrolledList const &) const;
+
+	/// \brief inequality operator
+	///
+	/// \param UnrolledList to check inequality with
+	///
+	/// \return true if the UnrolledLists differ somehow
+	inline bool operator!=(UnrolledList const &) const;
+
+
+	/// \brief destructor
+	inline ~UnrolledList() { this->clear(); }
+
+
+private:
+	/// \brief bytes of a Chunk that are left for the elements
+	static constexpr unsigned int payload_ = 256 - 2 * sizeof(void *)
+												- sizeof(unsigned int);
+
+	/// \brief number of elements in a Chunk (a Chunk is 256 bytes, unless
+	/// the elements are so big that not even 4 would fit)
+	static constexpr unsigned int capacity_ =
+						(payload_ / sizeof(T) < 4) ? 4 : payload_ / sizeof(T);
+
+	/// \brief a Chunk stores several consecutive elements of the list
+	///
+	/// The elements occupy the first count_ places of the storage, the rest is
+	/// uninitialized.
+	struct alignas(64) Chunk {
+		/// \brief constructor (creates empty Chunk)
+		Chunk() : previous_(nullptr), next_(nullptr), count_(0) {}
+
+		/// \brief get address of an element
+		///
+		/// \param index of element inside the Chunk
+		///
+		/// \return address of the element
+		T * at(unsigned int k)
+		{
+			return reinterpret_cast<T *>(this->storage_) + k;
+		}
+
+		alignas(T) unsigned char storage_[capacity_ * sizeof(T)]; ///< elements
+		Chunk * previous_; ///< address of preceding Chunk
+		Chunk * next_; ///< address of succeeding Chunk
+		unsigned int count_; ///< number of elements in the Chunk
+	};
+
+private:
+	/// \brief construct element in place at the beginning of UnrolledList
+	///
+	/// \param args arguments forwarded to the constructor of T
+	template <typename... Args>
+	inline void emplace_front(Args &&... args);
+
+	/// \brief create an empty Chunk and link it in after another one
+	///
+	/// \param Chunk to link after (nullptr links to the beginning)
+	///
+	/// \return the new Chunk
+	inline Chunk * insertChunk(Chunk *);
+
+	/// \brief unlink a Chunk and give its storage back (elements are left alone)
+	///
+	/// \param Chunk to get rid of
+	inline void eraseChunk(Chunk *);
+
+	/// \brief take over all Chunks of another list (*this* must be empty)
+	///
+	/// \param UnrolledList to steal from (it is left empty)
+	inline void steal(UnrolledList &);
+
+private:
+	Chunk * head_; ///< first Chunk (or nullptr if empty)
+	Chunk * tail_; ///< last Chunk (or nullptr if empty)
+	unsigned int number_of_elements_; ///< size of the UnrolledList
+	Allocator<Chunk> allocator_; ///< where the Chunks come from
+
+
+public:
+	/// \brief iterator with the same behaviour as List's Iterator
+	class Iterator {
+	public:
+		/// \brief constructor for the UnrolledList's Iterator
+		///
+		/// \param address of Chunk to point into (nullptr means end())
+		/// \param index of element in the Chunk
+		/// \param address of the UnrolledList the Iterator belongs to
+		inline Iterator(Chunk * chunk, unsigned int index,
+						UnrolledList const * list)
+			: chunk_(chunk), index_(index), list_(list) {}
+
+
+		/// \brief dereference operator
+		///
+		/// \return the element currently pointed to
+		inline T & operator*() { return *this->chunk_->at(this->index_); }
+
+		/// \brief const dereference operator
+		///
+		/// \return the element currently pointed to
+		inline T const & operator*() const
+		{
+			return *this->chunk_->at(this->index_);
+		}
+
+
+		/// \brief preincrement operator (doesn't go past end())
+		///
+		/// \return Iterator of next element
+		inline Iterator operator++();
+
+		/// \brief postincrement operator (doesn't go past end())
+		///
+		/// \param int dummy parameter
+		///
+		/// \return Iterator of current element
+		inline Iterator operator++(int);
+
+		/// \brief predecrement operator (doesn't go below the first element)
+		///
+		/// \return Iterator of previous element
+		inline Iterator operator--();
+
+		/// \brief postdecrement operator (doesn't go below the first element)
+		///
+		/// \param int dummy parameter
+		///
+		/// \return Iterator of current element
+		inline Iterator operator--(int);
+
+
+		/// \brief equality operator
+		///
+		/// \param Iterator to check equality with
+		///
+		/// \return true if the Iterators point to the same element
+		inline bool operator==(Iterator const & rhs) const
+		{
+			return this->chunk_ == rhs.chunk_ && this->index_ == rhs.index_;
+		}
+
+		/// \brief inequality operator
+		///
+		/// \param Iterator to check inequality with
+		///
+		/// \return true if the Iterators point to different elements
+		inline bool operator!=(Iterator const & rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+
+	private:
+		Chunk * chunk_; ///< Chunk currently pointed into
+		unsigned int index_; ///< index of element inside the Chunk
+		UnrolledList const * list_; ///< needed to step back from end()
+	}; // class Iterator
+
+
+public:
+	/// \brief get Iterator to the first element of the UnrolledList
+	///
+	/// \return the first element
+	inline Iterator begin() const
+	{
+		return (this->head_ == nullptr) ? this->end()
+										: Iterator(this->head_, 0, this);
+	}
+
+	/// \brief get Iterator to the element that would come after the last one
+	///
+	/// \return the past-the-last element
+	inline Iterator end() const { return Iterator(nullptr, 0, this); }
+}; // class UnrolledList
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+template <typename T, template <typename> class Allocator>
+UnrolledList<T, Allocator>::UnrolledList(UnrolledList const & obj)
+	: head_(nullptr), tail_(nullptr), number_of_elements_(0)
+{
+	for (Chunk * chunk = obj.head_; chunk != nullptr; chunk = chunk->next_)
+	{
+		for (unsigned int k = 0; k < chunk->count_; ++k)
+		{
+			this->emplace_back(*chunk->at(k));
+		}
+	}
+}
+
+template <typename T, template <typename> class Allocator>
+UnrolledList<T, Allocator>::UnrolledList(UnrolledList && obj)
+	: head_(nullptr), tail_(nullptr), number_of_elements_(0)
+{
+	this->steal(obj);
+}
+
+template <typename T, template <typename> class Allocator>
+UnrolledList<T, Allocator> &
+UnrolledList<T, Allocator>::operator=(UnrolledList const & rhs)
+{
+	// checking for self-assignment
+	if (this == &rhs)
+	{
+		return *this;
+	}
+
+	this->clear();
+	for (Chunk * chunk = rhs.head_; chunk != nullptr; chunk = chunk->next_)
+	{
+		for (unsigned int k = 0; k < chunk->count_; ++k)
+		{
+			this->emplace_back(*chunk->at(k));
+		}
+	}
+
+	return *this;
+}
+
+template <typename T, template <typename> class Allocator>
+UnrolledList<T, Allocator> &
+UnrolledList<T, Allocator>::operator=(UnrolledList && rhs)
+{
+	// checking for self-assignment
+	if (this == &rhs)
+	{
+		return *this;
+	}
+
+	this->clear();
+	this->steal(rhs);
+
+	return *this;
+}
+
+template <typename T, template <typename> class Allocator>
+template <typename... Args>
+void UnrolledList<T, Allocator>::emplace_back(Args &&... args)
+{
+	// start a new Chunk if the last one is full
+	if (this->tail_ == nullptr || this->tail_->count_ == capacity_)
+	{
+		this->insertChunk(this->tail_);
+	}
+
+	new (this->tail_->at(this->tail_->count_)) T(std::forward<Args>(args)...);
+	++this->tail_->count_;
+	++this->number_of_elements_;
+}
+
+template <typename T, template <typename> class Allocator>
+template <typename... Args>
+void UnrolledList<T, Allocator>::emplace_front(Args &&... args)
+{
+	// start a new Chunk if the first one is full
+	if (this->head_ == nullptr || this->head_->count_ == capacity_)
+	{
+		this->insertChunk(nullptr);
+	}
+
+	// make room at the front of the first Chunk
+	Chunk * chunk = this->head_;
+	for (unsigned int k = chunk->count_; k > 0; --k)
+	{
+		new (chunk->at(k)) T(std::move(*chunk->at(k - 1)));
+		chunk->at(k - 1)->~T();
+	}
+
+	new (chunk->at(0)) T(std::forward<Args>(args)...);
+	++chunk->count_;
+	++this->number_of_elements_;
+}
+
+template <typename T, template <typename> class Allocator>
+void UnrolledList<T, Allocator>::remove(T const & val)
+{
+	for (Chunk * chunk = this->head_; chunk != nullptr; chunk = chunk->next_)
+	{
+		for (unsigned int k = 0; k < chunk->count_; ++k)
+		{
+			if (!(*chunk->at(k) == val))
+			{
+				continue;
+			}
+
+			// close the gap
+			chunk->at(k)->~T();
+			for (unsigned int j = k + 1; j < chunk->count_; ++j)
+			{
+				new (chunk->at(j - 1)) T(std::move(*chunk->at(j)));
+				chunk->at(j)->~T();
+			}
+			--chunk->count_;
+			--this->number_of_elements_;
+
+			// keep Chunks at least half full by merging in the next one if
+			// it fits
+			Chunk * next = chunk->next_;
+			if (chunk->count_ < capacity_ / 2 && next != nullptr &&
+					chunk->count_ + next->count_ <= capacity_)
+			{
+				for (unsigned int j = 0; j < next->count_; ++j)
+				{
+					new (chunk->at(chunk->count_ + j)) T(std::move(*next->at(j)));
+					next->at(j)->~T();
+				}
+				chunk->count_ += next->count_;
+				this->eraseChunk(next);
+			}
+
+			if (chunk->count_ == 0)
+			{
+				this->eraseChunk(chunk);
+			}
+			return;
+		}
+	}
+}
+
+template <typename T, template <typename> class Allocator>
+void UnrolledList<T, Allocator>::clear()
+{
+	Chunk * chunk = this->head_;
+	while (chunk != nullptr)
+	{
+		Chunk * delendum = chunk;
+		chunk = chunk->next_;
+
+		for (unsigned int k = 0; k < delendum->count_; ++k)
+		{
+			delendum->at(k)->~T();
+		}
+		delendum->~Chunk();
+		this->allocator_.deallocate(delendum);
+	}
+
+	this->head_ = nullptr;
+	this->tail_ = nullptr;
+	this->number_of_elements_ = 0;
+}
+
+template <typename T, template <typename> class Allocator>
+bool UnrolledList<T, Allocator>::operator==(UnrolledList const & rhs) const
+{
+	// the lists cannot be equal if their size differs
+	if (this->size() != rhs.size())
+	{
+		return false;
+	}
+
+	// iterate through both lists, comparing each element
+	Iterator i = this->begin();
+	Iterator j = rhs.begin();
+	while (i != this->end())
+	{
+		if (*(i++) != *(j++))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <typename T, template <typename> class Allocator>
+bool UnrolledList<T, Allocator>::operator!=(UnrolledList const & rhs) const
+{
+	return !(*this == rhs);
+}
+
+template <typename T, template <typename> class Allocator>
+typename UnrolledList<T, Allocator>::Chunk *
+UnrolledList<T, Allocator>::insertChunk(Chunk * previous)
+{
+	Chunk * chunk = new (this->allocator_.allocate()) Chunk;
+
+	chunk->previous_ = previous;
+	chunk->next_ = (previous == nullptr) ? this->head_ : previous->next_;
+
+	if (chunk->previous_ != nullptr)
+	{
+		chunk->previous_->next_ = chunk;
+	}
+	else
+	{
+		this->head_ = chunk;
+	}
+
+	if (chunk->next_ != nullptr)
+	{
+		chunk->next_->previous_ = chunk;
+	}
+	else
+	{
+		this->tail_ = chunk;
+	}
+
+	return chunk;
+}
+
+template <typename T, template <typename> class Allocator>
+void UnrolledList<T, Allocator>::eraseChunk(Chunk * delendum)
+{
+	if (delendum->previous_ != nullptr)
+	{
+		delendum->previous_->next_ = delendum->next_;
+	}
+	else
+	{
+		this->head_ = delendum->next_;
+	}
+
+	if (delendum->next_ != nullptr)
+	{
+		delendum->next_->previous_ = delendum->previous_;
+	}
+	else
+	{
+		this->tail_ = delendum->previous_;
+	}
+
+	delendum->~Chunk();
+	this->allocator_.deallocate(delendum);
+}
+
+template <typename T, template <typename> class Allocator>
+void UnrolledList<T, Allocator>::steal(UnrolledList & obj)
+{
+	// the Chunks belong to the other allocator, so that has to come along too
+	this->allocator_.swap(obj.allocator_);
+
+	this->head_ = obj.head_;
+	this->tail_ = obj.tail_;
+	this->number_of_elements_ = obj.number_of_elements_;
+
+	obj.head_ = nullptr;
+	obj.tail_ = nullptr;
+	obj.number_of_elements_ = 0;
+}
+
+template <typename T, template <typename> class Allocator>
+typename UnrolledList<T, Allocator>::Iterator
+UnrolledList<T, Allocator>::Iterator::operator++()
+{
+	// end() stays where it is
+	if (this->chunk_ == nullptr)
+	{
+		return *this;
+	}
+
+	if (++this->index_ == this->chunk_->count_)
+	{
+		this->chunk_ = this->chunk_->next_;
+		this->index_ = 0;
+	}
+	return *this;
+}
+
+template <typename T, template <typename> class Allocator>
+typename UnrolledList<T, Allocator>::Iterator
+UnrolledList<T, Allocator>::Iterator::operator++(int)
+{
+	Iterator rv = *this;
+	++(*this);
+	return rv;
+}
+
+template <typename T, template <typename> class Allocator>
+typename UnrolledList<T, Allocator>::Iterator
+UnrolledList<T, Allocator>::Iterator::operator--()
+{
+	if (this->chunk_ == nullptr)
+	{
+		// step back from end() to the last element (if there is one)
+		if (this->list_->tail_ != nullptr)
+		{
+			this->chunk_ = this->list_->tail_;
+			this->index_ = this->chunk_->count_ - 1;
+		}
+	}
+	else if (this->index_ > 0)
+	{
+		--this->index_;
+	}
+	else if (this->chunk_->previous_ != nullptr)
+	{
+		this->chunk_ = this->chunk_->previous_;
+		this->index_ = this->chunk_->count_ - 1;
+	}
+	// the first element stays where it is
+
+	return *this;
+}
+
+template <typename T, template <typename> class Allocator>
+typename UnrolledList<T, Allocator>::Iterator
+UnrolledList<T, Allocator>::Iterator::operator--(int)
+{
+	Iterator rv = *this;
+	--(*this);
+	return rv;
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_UNROLLED_LIST_HXX
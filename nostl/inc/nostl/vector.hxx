@@ -0,0 +1,403 @@
+#ifndef BANCH_NOSTL_VECTOR_HXX
+#define BANCH_NOSTL_VECTOR_HXX
+
+/// \file vector.hxx
+///
+/// \brief re-implementation of std::vector<T>
+
+#include "nostl/allocator.hxx"
+
+#include <new>
+#include <utility>
+
+/// \brief namespace for STL reimplementations
+namespace nostl {
+
+//////////////////
+// DECLARATIONS //
+//////////////////
+
+/// \brief re-implementation of std::vector<T>
+///
+/// \tparam T type of elements that the Vector contains
+/// \tparam Storage policy the storage comes from (like HeapStorage)
+///
+/// A growable array: elements are stored contiguously, capacity doubles when
+/// it runs out. This is what the hash and index structures keep their tables
+/// in; the Lists are still there for when stable addresses matter more than
+/// locality.
+///
+/// \note copies take their storage from a default constructed Storage, moves
+/// take the Storage along with the elements
+template <typename T, typename Storage = HeapStorage>
+class Vector : private Storage {
+public:
+	/// \brief constructor w/o parameters --- doesn't allocate anything yet
+	inline Vector() : data_(nullptr), size_(0), capacity_(0) {}
+
+	/// \brief constructor with a storage policy instance
+	///
+	/// \param storage to take the memory from
+	explicit inline Vector(Storage const & storage)
+		: Storage(storage), data_(nullptr), size_(0), capacity_(0) {}
+
+	/// \brief constructor that fills the Vector with copies of a value
+	///
+	/// \param n number of elements
+	/// \param value to copy into every element
+	inline Vector(unsigned int n, T const & value = T());
+
+	/// \brief copy constructor
+	///
+	/// \param Vector to copy
+	inline Vector(Vector const &);
+
+	/// \brief move constructor (O(1), the other Vector is left empty)
+	///
+	/// \param Vector to steal the elements of
+	inline Vector(Vector && obj)
+		: Storage(std::move(static_cast<Storage &>(obj))),
+			data_(obj.data_), size_(obj.size_), capacity_(obj.capacity_)
+	{
+		obj.data_ = nullptr;
+		obj.size_ = 0;
+		obj.capacity_ = 0;
+	}
+
+	/// \brief assignment operator
+	///
+	/// \param Vector to set *this* equal to
+	///
+	/// \return the Vector itself
+	inline Vector & operator=(Vector const &);
+
+	/// \brief move assignment operator
+	///
+	/// \param Vector to steal the elements of (it is left empty)
+	///
+	/// \return the Vector itself
+	inline Vector & operator=(Vector &&);
+
+
+	/// \brief add element to end of Vector
+	///
+	/// \param value of new element
+	inline void push_back(T const & val) { this->emplace_back(val); }
+
+	/// \brief add element to end of Vector by moving it in
+	///
+	/// \param value of new element
+	inline void push_back(T && val) { this->emplace_back(std::move(val)); }
+
+	/// \brief construct element in place at the end of Vector
+	///
+	/// \tparam Args types of constructor arguments
+	///
+	/// \param args arguments forwarded to the constructor of T
+	template <typename... Args>
+	inline void emplace_back(Args &&... args);
+
+	/// \brief remove the last element
+	inline void pop_back() { this->data_[--this->size_].~T(); }
+
+	/// \brief add element at a position (the ones after it move back)
+	///
+	/// \param k index of new element (at most size())
+	/// \param value of new element
+	inline void insert(unsigned int k, T value);
+
+	/// \brief remove element at a position (the ones after it move forward)
+	///
+	/// \param k index of element to remove
+	inline void erase(unsigned int k);
+
+	/// \brief make sure there's room for a given number of elements
+	///
+	/// \param n number of elements to make room for
+	inline void reserve(unsigned int n);
+
+	/// \brief change the number of elements (new ones are copies of a value)
+	///
+	/// \param n new size
+	/// \param value to copy into new elements
+	inline void resize(unsigned int n, T const & value = T());
+
+	/// \brief clear the Vector (capacity is kept)
+	inline void clear();
+
+
+	/// \brief get the size of the Vector (i.e. the number of its elements)
+	///
+	/// \return the Vector's size
+	inline unsigned int size() const { return this->size_; }
+
+	/// \brief get the number of elements the Vector has room for
+	///
+	/// \return the Vector's capacity
+	inline unsigned int capacity() const { return this->capacity_; }
+
+	/// \brief tell whether the Vector is empty
+	///
+	/// \return true if there are no elements
+	inline bool empty() const { return this->size_ == 0; }
+
+
+	/// \brief index operator
+	///
+	/// \param index of element
+	///
+	/// \return reference to element
+	inline T & operator[](unsigned int k) { return this->data_[k]; }
+
+	/// \brief const index operator
+	///
+	/// \param index of element
+	///
+	/// \return const reference to element
+	inline T const & operator[](unsigned int k) const { return this->data_[k]; }
+
+	/// \brief get the last element
+	///
+	/// \return reference to last element
+	inline T & back() { return this->data_[this->size_ - 1]; }
+
+	/// \brief get the last element
+	///
+	/// \return const reference to last element
+	inline T const & back() const { return this->data_[this->size_ - 1]; }
+
+
+	/// \brief get address of the first element (for tight loops)
+	///
+	/// \return address of the storage
+	inline T * begin() { return this->data_; }
+
+	/// \brief get address of the first element (for tight loops)
+	///
+	/// \return address of the storage
+	inline T const * begin() const { return this->data_; }
+
+	/// \brief get address past the last element
+	///
+	/// \return address past the last element
+	inline T * end() { return this->data_ + this->size_; }
+
+	/// \brief get address past the last element
+	///
+	/// \return address past the last element
+	inline T const * end() const { return this->data_ + this->size_; }
+
+
+	/// \brief equality operator
+	///
+	/// \param Vector to check equality with
+	///
+	/// \return true if all elements of the Vectors match
+	inline bool operator==(Vector const &) const;
+
+	/// \brief inequality operator
+	///
+	/// \param Vector to check inequality with
+	///
+	/// \return true if the Vectors differ somehow
+	inline bool operator!=(Vector const & rhs) const { return !(*this == rhs); }
+
+
+	/// \brief destructor (frees memory)
+	inline ~Vector();
+
+
+private:
+	/// \brief move elements into a new storage of a given capacity
+	///
+	/// \param new capacity (must not be smaller than the size)
+	inline void reallocate(unsigned int);
+
+private:
+	T * data_; ///< storage (only the first size_ elements are constructed)
+	unsigned int size_; ///< number of elements
+	unsigned int capacity_; ///< number of elements the storage has room for
+}; // class Vector
+
+
+
+////////////////////////
+// INLINE DEFINITIONS //
+////////////////////////
+
+template <typename T, typename Storage>
+Vector<T, Storage>::Vector(unsigned int n, T const & value)
+	: data_(nullptr), size_(0), capacity_(0)
+{
+	this->resize(n, value);
+}
+
+template <typename T, typename Storage>
+Vector<T, Storage>::Vector(Vector const & obj)
+	: Storage(), data_(nullptr), size_(0), capacity_(0)
+{
+	this->reserve(obj.size_);
+	for (unsigned int k = 0; k < obj.size_; ++k)
+	{
+		new (this->data_ + k) T(obj.data_[k]);
+	}
+	this->size_ = obj.size_;
+}
+
+template <typename T, typename Storage>
+Vector<T, Storage> & Vector<T, Storage>::operator=(Vector const & rhs)
+{
+	// checking for self-assignment
+	if (this == &rhs)
+	{
+		return *this;
+	}
+
+	this->clear();
+	this->reserve(rhs.size_);
+	for (unsigned int k = 0; k < rhs.size_; ++k)
+	{
+		new (this->data_ + k) T(rhs.data_[k]);
+	}
+	this->size_ = rhs.size_;
+
+	return *this;
+}
+
+template <typename T, typename Storage>
+Vector<T, Storage> & Vector<T, Storage>::operator=(Vector && rhs)
+{
+	// checking for self-assignment
+	if (this == &rhs)
+	{
+		return *this;
+	}
+
+	this->clear();
+	this->deallocate(this->data_);
+
+	static_cast<Storage &>(*this) = std::move(static_cast<Storage &>(rhs));
+	this->data_ = rhs.data_;
+	this->size_ = rhs.size_;
+	this->capacity_ = rhs.capacity_;
+
+	rhs.data_ = nullptr;
+	rhs.size_ = 0;
+	rhs.capacity_ = 0;
+
+	return *this;
+}
+
+template <typename T, typename Storage>
+template <typename... Args>
+void Vector<T, Storage>::emplace_back(Args &&... args)
+{
+	if (this->size_ == this->capacity_)
+	{
+		this->reallocate(this->capacity_ == 0 ? 8 : 2 * this->capacity_);
+	}
+
+	new (this->data_ + this->size_) T(std::forward<Args>(args)...);
+	++this->size_;
+}
+
+template <typename T, typename Storage>
+void Vector<T, Storage>::insert(unsigned int k, T value)
+{
+	this->emplace_back(std::move(value));
+	for (unsigned int j = this->size_ - 1; j > k; --j)
+	{
+		std::swap(this->data_[j], this->data_[j - 1]);
+	}
+}
+
+template <typename T, typename Storage>
+void Vector<T, Storage>::erase(unsigned int k)
+{
+	for (unsigned int j = k + 1; j < this->size_; ++j)
+	{
+		this->data_[j - 1] = std::move(this->data_[j]);
+	}
+	this->pop_back();
+}
+
+template <typename T, typename Storage>
+void Vector<T, Storage>::reserve(unsigned int n)
+{
+	if (n > this->capacity_)
+	{
+		this->reallocate(n);
+	}
+}
+
+template <typename T, typename Storage>
+void Vector<T, Storage>::resize(unsigned int n, T const & value)
+{
+	while (this->size_ > n)
+	{
+		this->pop_back();
+	}
+
+	this->reserve(n);
+	while (this->size_ < n)
+	{
+		new (this->data_ + this->size_) T(value);
+		++this->size_;
+	}
+}
+
+template <typename T, typename Storage>
+void Vector<T, Storage>::clear()
+{
+	for (unsigned int k = 0; k < this->size_; ++k)
+	{
+		this->data_[k].~T();
+	}
+	this->size_ = 0;
+}
+
+template <typename T, typename Storage>
+bool Vector<T, Storage>::operator==(Vector const & rhs) const
+{
+	if (this->size_ != rhs.size_)
+	{
+		return false;
+	}
+
+	for (unsigned int k = 0; k < this->size_; ++k)
+	{
+		if (!(this->data_[k] == rhs.data_[k]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <typename T, typename Storage>
+Vector<T, Storage>::~Vector()
+{
+	this->clear();
+	this->deallocate(this->data_);
+}
+
+template <typename T, typename Storage>
+void Vector<T, Storage>::reallocate(unsigned int n)
+{
+	T * storage = static_cast<T *>(this->allocate(n * sizeof(T)));
+
+	for (unsigned int k = 0; k < this->size_; ++k)
+	{
+		new (storage + k) T(std::move(this->data_[k]));
+		this->data_[k].~T();
+	}
+
+	this->deallocate(this->data_);
+	this->data_ = storage;
+	this->capacity_ = n;
+}
+
+} // namespace nostl
+
+#endif // BANCH_NOSTL_VECTOR_HXX
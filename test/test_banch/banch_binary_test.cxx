@@ -0,0 +1,188 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/binary.hxx"
+#include "banch/interactiveFunctions.hxx"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+void fill(RecipeBook & book)
+{
+	Recipe * foo = new Recipe("foo");
+	foo->add(new Beverage("mineral water", 10));
+	foo->add(new Extra("lemon slices"));
+
+	Recipe * bar = new Recipe("bar");
+	bar->add(new Beverage("milk", 8));
+	bar->add(new Beverage(std::string(300, 'x'), 70000));
+
+	book.add(foo);
+	book.add(bar);
+}
+
+} // namespace
+
+TEST_CASE("Varints and integers survive a round trip", "[binary]")
+{
+	std::stringstream ss;
+	{
+		nostl::Sink sink(ss);
+		BinaryWriter writer(sink);
+		writer.writeVarint(0);
+		writer.writeVarint(127);
+		writer.writeVarint(128);
+		writer.writeVarint(~0ULL);
+		writer.writeUint32(0xdeadbeef);
+		writer.writeString("hello");
+	}
+
+	std::string data = ss.str();
+	CHECK( data.size() == 1 + 1 + 2 + 10 + 4 + 6 );
+
+	BinaryReader reader(data.data(), data.data() + data.size());
+	CHECK( reader.readVarint() == 0 );
+	CHECK( reader.readVarint() == 127 );
+	CHECK( reader.readVarint() == 128 );
+	CHECK( reader.readVarint() == ~0ULL );
+	CHECK( reader.readUint32() == 0xdeadbeef );
+	std::string str;
+	reader.readString(str);
+	CHECK( str == "hello" );
+	CHECK( reader.good() );
+	CHECK( reader.atEnd() );
+
+	reader.readByte();
+	CHECK_FALSE( reader.good() );
+}
+
+TEST_CASE("A recipe book survives a binary round trip", "[binary]")
+{
+	RecipeBook book;
+	fill(book);
+
+	std::stringstream binary;
+	book.serializeBinary(binary);
+	CHECK( isBinaryFormat(binary) );
+	CHECK( binary.tellg() == 0 );
+
+	RecipeBook copy;
+	REQUIRE( copy.deserializeBinary(binary) );
+	CHECK( copy.number_of_entries() == 2 );
+	CHECK( copy.getNth(2).number_of_ingredients() == 2 );
+
+	std::stringstream expected, actual;
+	book.serialize(expected);
+	copy.serialize(actual);
+	CHECK( actual.str() == expected.str() );
+}
+
+TEST_CASE("Text and binary database files can be converted", "[binary]")
+{
+	RecipeBook book;
+	fill(book);
+
+	std::stringstream text;
+	book.serialize(text);
+	CHECK_FALSE( isBinaryFormat(text) );
+
+	std::stringstream binary;
+	REQUIRE( convertFormat(text, binary) );
+	CHECK( isBinaryFormat(binary) );
+
+	std::stringstream back;
+	REQUIRE( convertFormat(binary, back) );
+	CHECK( back.str() == text.str() );
+}
+
+TEST_CASE("A database file can be converted in place", "[binary]")
+{
+	char const * const path = "banch_binary_test.tmp";
+	RecipeBook book;
+	fill(book);
+	{
+		std::ofstream ofs(path);
+		book.serialize(ofs);
+	}
+
+	std::stringstream out;
+	std::stringstream in;
+
+	SECTION("same path twice")
+	{
+		in.str(std::string(path) + "\n" + path + "\n");
+		Fconvert_recipebook convert(out, in);
+		convert();
+
+		std::ifstream ifs(path, std::ios::in | std::ios::binary);
+		REQUIRE( isBinaryFormat(ifs) );
+		RecipeBook copy;
+		REQUIRE( copy.deserializeBinary(ifs) );
+		REQUIRE( copy.number_of_entries() == book.number_of_entries() );
+	}
+
+	SECTION("a corrupt input leaves the output alone")
+	{
+		std::string const corrupt = "banch_binary_test_corrupt.tmp";
+		{
+			std::ofstream ofs(corrupt, std::ios::out | std::ios::binary);
+			std::stringstream binary;
+			book.serializeBinary(binary);
+			ofs << binary.str().substr(0, binary.str().size() / 2);
+		}
+		in.str(corrupt + "\n" + path + "\n");
+		Fconvert_recipebook convert(out, in);
+		convert();
+		std::remove(corrupt.c_str());
+
+		CHECK( out.str().find("Failed") != std::string::npos );
+		std::ifstream ifs(path);
+		RecipeBook copy;
+		copy.deserialize(ifs);
+		REQUIRE( copy.number_of_entries() == book.number_of_entries() );
+	}
+
+	std::remove(path);
+}
+
+TEST_CASE("Corrupt binary data is rejected", "[binary]")
+{
+	RecipeBook book;
+	fill(book);
+
+	std::stringstream binary;
+	book.serializeBinary(binary);
+	std::string data = binary.str();
+
+	SECTION("truncated")
+	{
+		std::stringstream truncated(data.substr(0, data.size() - 3));
+		RecipeBook copy;
+		CHECK_FALSE( copy.deserializeBinary(truncated) );
+		CHECK( copy.number_of_entries() == 0 );
+	}
+
+	SECTION("unknown ingredient tag")
+	{
+		// first ingredient of "foo": magic, version, count, name
+		data[4 + 1 + 1 + 1 + 3 + 1] = 42;
+		std::stringstream corrupt(data);
+		RecipeBook copy;
+		CHECK_FALSE( copy.deserializeBinary(corrupt) );
+		CHECK( copy.number_of_entries() == 0 );
+	}
+
+	SECTION("wrong version")
+	{
+		data[4] = BINARY_VERSION + 1;
+		std::stringstream corrupt(data);
+		RecipeBook copy;
+		CHECK_FALSE( copy.deserializeBinary(corrupt) );
+	}
+}
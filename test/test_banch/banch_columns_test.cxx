@@ -0,0 +1,157 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/columns.hxx"
+
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+/// fills a book with n recipes, the kth of them having k % 4 + 1 beverages
+/// (k units of "water" and some "juice") and an extra
+void fill(RecipeBook & book, unsigned int n)
+{
+	for (unsigned int k = 0; k < n; ++k)
+	{
+		Recipe * recipe = new Recipe("recipe" + std::to_string(k));
+		recipe->add(new Beverage("water", k));
+		for (unsigned int j = 0; j < k % 4; ++j)
+		{
+			recipe->add(new Beverage("juice", j + 1));
+		}
+		recipe->add(new Extra("ice"));
+		book.add(recipe);
+	}
+}
+
+/// sums up the quanta of the beverages with a name the slow way
+unsigned long long naiveQuanta(RecipeBook & book, std::string const & name)
+{
+	unsigned long long total = 0;
+	for (unsigned int k = 1; k <= book.number_of_entries(); ++k)
+	{
+		Recipe & recipe = book.getNth(k);
+		for (unsigned int i = 1; i <= recipe.number_of_ingredients(); ++i)
+		{
+			IngredientValue value;
+			if (recipe.getNth(i).toValue(value) &&
+					value.kind == IngredientValue::BEVERAGE && value.name == name)
+			{
+				total += value.quanta;
+			}
+		}
+	}
+	return total;
+}
+
+/// counts the recipes with more than n ingredients the slow way
+unsigned int naiveMoreThan(RecipeBook & book, unsigned int n)
+{
+	unsigned int count = 0;
+	for (unsigned int k = 1; k <= book.number_of_entries(); ++k)
+	{
+		count += book.getNth(k).number_of_ingredients() > n;
+	}
+	return count;
+}
+
+/// checks every scan against the slow way
+void check(ColumnarBook const & columns, RecipeBook & book)
+{
+	REQUIRE( columns.totalQuanta("water") == naiveQuanta(book, "water") );
+	REQUIRE( columns.totalQuanta("juice") == naiveQuanta(book, "juice") );
+	REQUIRE( columns.totalQuanta("ice") == 0 );
+	REQUIRE( columns.totalQuanta("nothing") == 0 );
+	for (unsigned int n = 0; n < 7; ++n)
+	{
+		REQUIRE( columns.countRecipesWithMoreThan(n) == naiveMoreThan(book, n) );
+	}
+	REQUIRE( columns.countKind(IngredientValue::EXTRA) ==
+				naiveMoreThan(book, 0) );
+	REQUIRE( columns.rows() - columns.deadRows() ==
+				columns.countKind(IngredientValue::BEVERAGE) +
+				columns.countKind(IngredientValue::EXTRA) );
+}
+
+} // namespace
+
+TEST_CASE("A columnar book mirrors a RecipeBook", "[columns]")
+{
+	RecipeBook book;
+	fill(book, 10);
+
+	ColumnarBook columns(book);
+
+	REQUIRE( columns.recipeSlots() == 10 );
+	REQUIRE( columns.rows() == 10 + 13 + 10 );
+	REQUIRE( columns.deadRows() == 0 );
+	REQUIRE( columns.name(columns.nameId("water")) == "water" );
+	REQUIRE( columns.nameId("nothing") == ColumnarBook::NO_NAME );
+	check(columns, book);
+
+	SECTION("rows of a recipe are contiguous after a build")
+	{
+		std::uint32_t const * recipes = columns.recipes();
+		for (unsigned int k = 1; k < columns.rows(); ++k)
+		{
+			REQUIRE( recipes[k - 1] <= recipes[k] );
+		}
+	}
+
+	SECTION("edits are followed")
+	{
+		book.getNth(3).add(new Beverage("water", 100));
+		book.getNth(5).remove(1u);
+		book.remove(7u);
+		fill(book, 3);
+
+		REQUIRE( columns.deadRows() != 0 );
+		check(columns, book);
+	}
+
+	SECTION("clearing and loading are followed")
+	{
+		std::stringstream ss;
+		book.serialize(ss);
+		book.clear();
+
+		REQUIRE( columns.rows() == 0 );
+		REQUIRE( columns.countRecipesWithMoreThan(0) == 0 );
+
+		book.deserialize(ss);
+		check(columns, book);
+		REQUIRE( columns.rows() == 33 );
+	}
+
+	SECTION("dead rows get compacted away")
+	{
+		fill(book, 90);
+		while (book.number_of_entries() > 1)
+		{
+			book.remove(1u);
+		}
+		fill(book, 1);
+
+		REQUIRE( columns.deadRows() == 0 );
+		REQUIRE( columns.recipeSlots() == 2 );
+		check(columns, book);
+
+		columns.rebuild();
+		check(columns, book);
+	}
+}
+
+TEST_CASE("A columnar book survives its RecipeBook", "[columns]")
+{
+	RecipeBook * book = new RecipeBook;
+	fill(*book, 2);
+	ColumnarBook columns(*book);
+	delete book;
+
+	REQUIRE( columns.rows() == 0 );
+	columns.rebuild();
+	REQUIRE( columns.rows() == 0 );
+}
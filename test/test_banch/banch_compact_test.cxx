@@ -0,0 +1,140 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/compact.hxx"
+
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+Recipe * makeRecipe()
+{
+	Recipe * foo = new Recipe("foo");
+	foo->add(new Beverage("mineral water", 10));
+	foo->add(new Extra("lemon slices"));
+	foo->add(new Beverage("milk", 8));
+	return foo;
+}
+
+/// visitor that sums up the quanta and counts the extras
+struct Counter {
+	unsigned int quanta;
+	unsigned int extras;
+
+	void beverage(nostl::CowString const &, unsigned int q) { quanta += q; }
+	void extra(nostl::CowString const &) { ++extras; }
+};
+
+} // namespace
+
+TEST_CASE("A compact recipe keeps values inline", "[compact]")
+{
+	CompactRecipe foo("foo");
+	foo.add(IngredientValue::beverage("gin", 4));
+	foo.add(IngredientValue::extra("ice"));
+	foo.add(IngredientValue::beverage("tonic water", 10));
+
+	REQUIRE( foo.number_of_ingredients() == 3 );
+	REQUIRE( foo.getName() == "foo" );
+	REQUIRE( foo.getNth(1) == IngredientValue::beverage("gin", 4) );
+	REQUIRE( foo.getNth(2).kind == IngredientValue::EXTRA );
+
+	Counter counter = { 0, 0 };
+	foo.visit(counter);
+	REQUIRE( counter.quanta == 14 );
+	REQUIRE( counter.extras == 1 );
+
+	foo.remove(1);
+	REQUIRE( foo.number_of_ingredients() == 2 );
+	REQUIRE( foo.getNth(1).name == "ice" );
+	REQUIRE( foo.getNth(2).name == "tonic water" );
+
+	foo.clear();
+	REQUIRE( foo.number_of_ingredients() == 0 );
+}
+
+TEST_CASE("A compact recipe prints and serializes like a recipe", "[compact]")
+{
+	Recipe * recipe = makeRecipe();
+	CompactRecipe compact(*recipe);
+	REQUIRE( compact.number_of_ingredients() == 3 );
+
+	std::stringstream expected, actual;
+	recipe->show(expected, true);
+	compact.show(actual, true);
+	CHECK( actual.str() == expected.str() );
+
+	expected.str("");
+	actual.str("");
+	recipe->serialize(expected);
+	compact.serialize(actual);
+	CHECK( actual.str() == expected.str() );
+
+	// and back
+	Recipe * again = compact.toRecipe();
+	REQUIRE( again->number_of_ingredients() == 3 );
+	actual.str("");
+	again->serialize(actual);
+	CHECK( actual.str() == expected.str() );
+
+	delete again;
+	delete recipe;
+}
+
+TEST_CASE("A compact recipe deserializes every format", "[compact]")
+{
+	Recipe * recipe = makeRecipe();
+	CompactRecipe expected(*recipe);
+
+	std::stringstream text;
+	recipe->serialize(text);
+	text.ignore(1024, '\n'); // "startrecipe" is read by the book
+	std::string data = text.str().substr(text.tellg());
+
+	SECTION("stream")
+	{
+		CompactRecipe compact;
+		compact.deserialize(text);
+		CHECK( compact == expected );
+	}
+
+	SECTION("in place")
+	{
+		LineScanner scanner(data.data(), data.data() + data.size());
+		CompactRecipe compact;
+		compact.deserialize(scanner);
+		CHECK( compact == expected );
+		CHECK( compact.getNth(1).name.borrowed() );
+	}
+
+	SECTION("binary")
+	{
+		std::stringstream binary;
+		{
+			nostl::Sink sink(binary);
+			BinaryWriter writer(sink);
+			recipe->serializeBinary(writer);
+		}
+		std::string bytes = binary.str();
+
+		BinaryReader reader(bytes.data(), bytes.data() + bytes.size());
+		CompactRecipe compact;
+		compact.deserializeBinary(reader);
+		CHECK( reader.good() );
+		CHECK( reader.atEnd() );
+		CHECK( compact == expected );
+
+		std::stringstream again;
+		{
+			nostl::Sink sink(again);
+			BinaryWriter writer(sink);
+			compact.serializeBinary(writer);
+		}
+		CHECK( again.str() == bytes );
+	}
+
+	delete recipe;
+}
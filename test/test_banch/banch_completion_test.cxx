@@ -0,0 +1,80 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/completion.hxx"
+
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+/// names of the completed Recipes, separated by spaces
+std::string names(nostl::Vector<Recipe *> const & recipes)
+{
+	std::string result;
+	for (unsigned int k = 0; k < recipes.size(); ++k)
+	{
+		result += (k == 0 ? "" : " ") + recipes[k]->getName();
+	}
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("Recipe names are completed from a prefix", "[completion]")
+{
+	RecipeBook book;
+	book.add(new Recipe("Mojito"));
+	book.add(new Recipe("Margarita"));
+
+	NameCompleter completer(book);
+
+	Recipe * martini = new Recipe("martini");
+	book.add(martini);
+	book.add(new Recipe("Manhattan"));
+	book.add(new Recipe("Negroni"));
+
+	SECTION("prefixes ignore case and completions come in name order")
+	{
+		REQUIRE( names(completer.complete("m")) ==
+					"Manhattan Margarita martini Mojito" );
+		REQUIRE( names(completer.complete("MAR")) == "Margarita martini" );
+		REQUIRE( names(completer.complete("negroni")) == "Negroni" );
+		REQUIRE( names(completer.complete("negronis")) == "" );
+		REQUIRE( names(completer.complete("x")) == "" );
+		REQUIRE( names(completer.complete("m", 2)) == "Manhattan Margarita" );
+		REQUIRE( completer.complete("").size() == 5 );
+		REQUIRE( completer.names() == 5 );
+	}
+
+	SECTION("Recipes with the same name are all completed")
+	{
+		Recipe * another = new Recipe("Martini");
+		book.add(another);
+		REQUIRE( completer.names() == 5 );
+		REQUIRE( names(completer.complete("mart")) == "martini Martini" );
+		REQUIRE( names(completer.complete("mart", 1)) == "martini" );
+
+		book.remove(martini);
+		REQUIRE( completer.complete("mart").size() == 1 );
+		REQUIRE( completer.complete("mart")[0] == another );
+	}
+
+	SECTION("removals, clearing and loading are followed")
+	{
+		book.remove(martini);
+		REQUIRE( names(completer.complete("mar")) == "Margarita" );
+		REQUIRE( completer.names() == 4 );
+
+		std::stringstream ss;
+		book.serialize(ss);
+		book.clear();
+		REQUIRE( completer.names() == 0 );
+		REQUIRE( names(completer.complete("m")) == "" );
+
+		book.deserialize(ss);
+		REQUIRE( names(completer.complete("m")) == "Manhattan Margarita Mojito" );
+	}
+}
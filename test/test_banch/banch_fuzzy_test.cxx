@@ -0,0 +1,112 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/fuzzy.hxx"
+
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+/// names of the matched Recipes with their distances, like "gimlet 1"
+std::string describe(nostl::Vector<FuzzyMatch> const & matches)
+{
+	std::string result;
+	for (unsigned int k = 0; k < matches.size(); ++k)
+	{
+		result += (k == 0 ? "" : ", ") + matches[k].recipe->getName() + ' ' +
+					std::to_string(matches[k].distance);
+		if (matches[k].ingredient)
+		{
+			result += " (" + matches[k].text + ')';
+		}
+	}
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("Edit distances are bounded", "[fuzzy]")
+{
+	REQUIRE( editDistance("", "", 2) == 0 );
+	REQUIRE( editDistance("gin", "gin", 2) == 0 );
+	REQUIRE( editDistance("gin", "", 5) == 3 );
+	REQUIRE( editDistance("kitten", "sitting", 5) == 3 );
+	REQUIRE( editDistance("kitten", "sitting", 2) == 3 );
+	REQUIRE( editDistance("margarita", "magarita", 1) == 1 );
+	REQUIRE( editDistance("daiquiri", "daikiri", 2) == 2 );
+	REQUIRE( editDistance("negroni", "martini", 3) == 4 );
+	REQUIRE( editDistance("ab", "abcdef", 3) == 4 );
+}
+
+TEST_CASE("Recipes can be found despite typos", "[fuzzy]")
+{
+	RecipeBook book;
+	Recipe * margarita = new Recipe("Margarita");
+	margarita->add(new Beverage("tequila", 4));
+	margarita->add(new Beverage("triple sec", 2));
+	book.add(margarita);
+
+	FuzzyIndex index(book);
+
+	Recipe * daiquiri = new Recipe("Daiquiri");
+	daiquiri->add(new Beverage("white rum", 4));
+	book.add(daiquiri);
+	Recipe * paloma = new Recipe("Paloma");
+	paloma->add(new Beverage("tequila", 4));
+	paloma->add(new Beverage("grapefruit soda", 10));
+	book.add(paloma);
+
+	REQUIRE( index.terms() == 7 );
+
+	REQUIRE( describe(index.search("margarita")) == "Margarita 0" );
+	REQUIRE( describe(index.search("MAGRARITA")) == "Margarita 2" );
+	REQUIRE( describe(index.search("daikiri")) == "Daiquiri 2" );
+	REQUIRE( describe(index.search("daikiri", 1)) == "" );
+	REQUIRE( describe(index.search("tequilla")) ==
+				"Margarita 1 (tequila), Paloma 1 (tequila)" );
+	REQUIRE( describe(index.search("tequilla", 2, 1)) ==
+				"Margarita 1 (tequila)" );
+	REQUIRE( describe(index.search("gin")) == "" );
+	REQUIRE( describe(index.search("")) == "" );
+
+	SECTION("short queries are checked against every term")
+	{
+		Recipe * gin = new Recipe("gin");
+		gin->add(new Beverage("gn", 4));
+		book.add(gin);
+		REQUIRE( describe(index.search("gim", 1)) == "gin 1" );
+	}
+
+	SECTION("edits are followed")
+	{
+		paloma->remove(1u);
+		REQUIRE( describe(index.search("tequilla")) ==
+					"Margarita 1 (tequila)" );
+
+		paloma->add(new Extra("salt"));
+		REQUIRE( describe(index.search("slat")) == "Paloma 2 (salt)" );
+
+		book.remove(margarita);
+		REQUIRE( describe(index.search("margarita")) == "" );
+		REQUIRE( index.terms() == 5 );
+
+		book.clear();
+		REQUIRE( index.terms() == 0 );
+		REQUIRE( describe(index.search("paloma")) == "" );
+	}
+
+	SECTION("lots of removals get compacted away")
+	{
+		for (unsigned int k = 0; k < 3000; ++k)
+		{
+			Recipe * recipe = new Recipe("shot " + std::to_string(k));
+			recipe->add(new Beverage("liqueur " + std::to_string(k), 1));
+			book.add(recipe);
+			book.remove(recipe);
+		}
+		REQUIRE( index.terms() == 7 );
+		REQUIRE( describe(index.search("palomaa")) == "Paloma 1" );
+	}
+}
@@ -0,0 +1,130 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/ingredient_index.hxx"
+
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+/// names of the Recipes in a result, separated by spaces
+std::string names(nostl::Vector<Recipe *> const & recipes)
+{
+	std::string result;
+	for (unsigned int k = 0; k < recipes.size(); ++k)
+	{
+		result += (k == 0 ? "" : " ") + recipes[k]->getName();
+	}
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("Ingredient names are normalized", "[ingredient_index]")
+{
+	REQUIRE( IngredientIndex::normalize("  Lime   JUICE ") == "lime juice" );
+	REQUIRE( IngredientIndex::normalize("gin") == "gin" );
+	REQUIRE( IngredientIndex::normalize("\t\n") == "" );
+}
+
+TEST_CASE("Recipes can be found by their ingredients", "[ingredient_index]")
+{
+	RecipeBook book;
+	Recipe * gimlet = new Recipe("gimlet");
+	gimlet->add(new Beverage("Gin", 6));
+	gimlet->add(new Beverage("lime juice", 2));
+	book.add(gimlet);
+
+	IngredientIndex index(book);
+
+	Recipe * daiquiri = new Recipe("daiquiri");
+	daiquiri->add(new Beverage("rum", 6));
+	daiquiri->add(new Beverage("Lime  juice", 3));
+	book.add(daiquiri);
+	Recipe * mojito = new Recipe("mojito");
+	mojito->add(new Beverage("rum", 4));
+	mojito->add(new Extra("mint"));
+	mojito->add(new Extra("ice"));
+	book.add(mojito);
+	Recipe * tonic = new Recipe("gin tonic");
+	tonic->add(new Beverage("gin", 4));
+	tonic->add(new Beverage("tonic water", 10));
+	tonic->add(new Extra("ice"));
+	book.add(tonic);
+
+	REQUIRE( index.terms() == 6 );
+	REQUIRE( names(index.recipesWith("GIN")) == "gimlet gin tonic" );
+	REQUIRE( names(index.recipesWith("lime juice")) == "gimlet daiquiri" );
+	REQUIRE( names(index.recipesWith("vodka")) == "" );
+
+	SECTION("queries combine names")
+	{
+		REQUIRE( names(index.query("rum")) == "daiquiri mojito" );
+		REQUIRE( names(index.query("rum AND lime juice")) == "daiquiri" );
+		REQUIRE( names(index.query("gin OR mint")) == "gimlet mojito gin tonic" );
+		REQUIRE( names(index.query("ice NOT rum")) == "gin tonic" );
+		REQUIRE( names(index.query("ice AND NOT rum")) == "gin tonic" );
+		REQUIRE( names(index.query("NOT ice")) == "gimlet daiquiri" );
+		REQUIRE( names(index.query("NOT vodka")) ==
+					"gimlet daiquiri mojito gin tonic" );
+		REQUIRE( names(index.query("rum AND gin OR tonic water")) ==
+					"gin tonic" );
+		REQUIRE( names(index.query("vodka OR lime juice NOT gin")) ==
+					"daiquiri" );
+		REQUIRE( names(index.query("")) == "" );
+	}
+
+	SECTION("edits of Recipes are followed")
+	{
+		Ingredient * ice = new Extra("ICE");
+		gimlet->add(ice);
+		REQUIRE( names(index.recipesWith("ice")) == "gimlet mojito gin tonic" );
+
+		// another ice keeps the gimlet posted
+		gimlet->add(new Extra("ice"));
+		gimlet->remove(ice);
+		REQUIRE( names(index.recipesWith("ice")) == "gimlet mojito gin tonic" );
+
+		gimlet->remove(3u);
+		REQUIRE( names(index.recipesWith("ice")) == "mojito gin tonic" );
+
+		mojito->clear();
+		REQUIRE( names(index.recipesWith("ice")) == "gin tonic" );
+		REQUIRE( names(index.recipesWith("mint")) == "" );
+		REQUIRE( index.terms() == 5 );
+	}
+
+	SECTION("removals, clearing and loading are followed")
+	{
+		book.remove(daiquiri);
+		REQUIRE( names(index.recipesWith("lime juice")) == "gimlet" );
+		REQUIRE( names(index.query("NOT gin")) == "mojito" );
+
+		std::stringstream ss;
+		book.serialize(ss);
+		book.clear();
+		REQUIRE( index.terms() == 0 );
+		REQUIRE( names(index.query("NOT gin")) == "" );
+
+		book.deserialize(ss);
+		REQUIRE( names(index.recipesWith("rum")) == "mojito" );
+		REQUIRE( names(index.recipesWith("gin")) == "gimlet gin tonic" );
+	}
+
+	SECTION("ids of removed Recipes get recycled")
+	{
+		for (unsigned int k = 0; k < 200; ++k)
+		{
+			Recipe * recipe = new Recipe("shot");
+			recipe->add(new Beverage("vodka", 1));
+			book.add(recipe);
+			book.remove(recipe);
+		}
+		REQUIRE( names(index.recipesWith("vodka")) == "" );
+		REQUIRE( names(index.query("NOT vodka")) ==
+					"gimlet daiquiri mojito gin tonic" );
+	}
+}
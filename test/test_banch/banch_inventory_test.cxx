@@ -0,0 +1,146 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/inventory.hxx"
+
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+/// an inventory entry
+Stock stock(std::string name, unsigned long long units)
+{
+	Stock stock = { name, units };
+	return stock;
+}
+
+/// Recipes and servings of a result, like "3 daiquiri, 1 gimlet"
+std::string describe(nostl::Vector<Makeable> const & makeable)
+{
+	std::stringstream ss;
+	for (unsigned int k = 0; k < makeable.size(); ++k)
+	{
+		ss << (k == 0 ? "" : ", ");
+		if (makeable[k].servings == InventoryMatcher::UNLIMITED)
+		{
+			ss << "any";
+		}
+		else
+		{
+			ss << makeable[k].servings;
+		}
+		ss << ' ' << makeable[k].recipe->getName();
+	}
+	return ss.str();
+}
+
+} // namespace
+
+TEST_CASE("An inventory is matched against a book", "[inventory]")
+{
+	RecipeBook book;
+	Recipe * gimlet = new Recipe("gimlet");
+	gimlet->add(new Beverage("gin", 6));
+	gimlet->add(new Beverage("lime juice", 2));
+	book.add(gimlet);
+
+	InventoryMatcher matcher(book);
+
+	Recipe * daiquiri = new Recipe("daiquiri");
+	daiquiri->add(new Beverage("rum", 4));
+	daiquiri->add(new Beverage("lime juice", 2));
+	daiquiri->add(new Beverage("Rum", 2)); // adds up with the other rum
+	book.add(daiquiri);
+	Recipe * mojito = new Recipe("mojito");
+	mojito->add(new Beverage("rum", 4));
+	mojito->add(new Extra("mint"));
+	book.add(mojito);
+	Recipe * water = new Recipe("water");
+	water->add(new Extra("ice"));
+	book.add(water);
+
+	REQUIRE( matcher.names() == 5 );
+
+	nostl::Vector<Stock> inventory;
+	inventory.push_back(stock("rum", 13));
+	inventory.push_back(stock("lime  JUICE", 10));
+	inventory.push_back(stock("mint", 1));
+	inventory.push_back(stock("ice", 1));
+	inventory.push_back(stock("vodka", 100));
+
+	REQUIRE( describe(matcher.makeable(inventory)) ==
+				"any water, 3 mojito, 2 daiquiri" );
+
+	SECTION("units of a name add up, missing ones rule Recipes out")
+	{
+		inventory.push_back(stock("gin", 6));
+		inventory.push_back(stock("gin", 7));
+		inventory.push_back(stock("rum", 11));
+		inventory[3].units = 0;
+		REQUIRE( describe(matcher.makeable(inventory)) ==
+					"6 mojito, 4 daiquiri, 2 gimlet" );
+	}
+
+	SECTION("edits are followed")
+	{
+		mojito->add(new Beverage("soda", 10));
+		gimlet->remove(1u);
+		book.remove(daiquiri);
+		inventory.push_back(stock("soda", 25));
+		REQUIRE( describe(matcher.makeable(inventory)) ==
+					"any water, 5 gimlet, 2 mojito" );
+
+		book.clear();
+		REQUIRE( matcher.makeable(inventory).empty() );
+		REQUIRE( matcher.names() == 0 );
+	}
+
+	SECTION("names beyond the first 64 are matched")
+	{
+		for (unsigned int k = 0; k < 3000; ++k)
+		{
+			Recipe * recipe = new Recipe("shot" + std::to_string(k));
+			recipe->add(new Beverage("liqueur" + std::to_string(k), 1));
+			recipe->add(new Beverage("rum", 1));
+			book.add(recipe);
+			if (k % 2 == 1)
+			{
+				book.remove(recipe);
+			}
+		}
+		inventory.push_back(stock("liqueur2998", 2));
+		inventory.push_back(stock("liqueur71", 1));
+		inventory.push_back(stock("liqueur1", 1));
+		REQUIRE( describe(matcher.makeable(inventory)) ==
+					"any water, 3 mojito, 2 daiquiri, 2 shot2998" );
+	}
+}
+
+TEST_CASE("Ingredients without a value can't be matched", "[inventory]")
+{
+	struct Mystery : Ingredient {
+		void print(std::ostream &) const {}
+		void serialize(nostl::Sink &) const {}
+		void deserialize(std::istream &) {}
+		void deserialize(LineScanner &) {}
+		void serializeBinary(BinaryWriter &) const {}
+		void deserializeBinary(BinaryReader &) {}
+	};
+
+	RecipeBook book;
+	Recipe * recipe = new Recipe("mystery");
+	recipe->add(new Beverage("gin", 1));
+	recipe->add(new Mystery);
+	book.add(recipe);
+	InventoryMatcher matcher(book);
+
+	nostl::Vector<Stock> inventory;
+	inventory.push_back(stock("gin", 1));
+	REQUIRE( matcher.makeable(inventory).empty() );
+
+	recipe->remove(2u);
+	REQUIRE( matcher.makeable(inventory).size() == 1 );
+}
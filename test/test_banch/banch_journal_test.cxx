@@ -0,0 +1,183 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/journal.hxx"
+
+#include <cstdio> // test removes its temporary files
+#include <fstream>
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+char const * const PATH = "banch_journal_test.tmp";
+char const * const JOURNAL_PATH = "banch_journal_test.tmp.journal";
+
+/// text serialization of a book
+std::string text(RecipeBook const & book)
+{
+	std::stringstream ss;
+	book.serialize(ss);
+	return ss.str();
+}
+
+/// size of a file
+long sizeOf(char const * path)
+{
+	std::ifstream ifs(path, std::ios::in | std::ios::binary | std::ios::ate);
+	return ifs ? static_cast<long>(ifs.tellg()) : -1;
+}
+
+/// get rid of the files of the test
+void removeFiles()
+{
+	std::remove(PATH);
+	std::remove(JOURNAL_PATH);
+}
+
+} // namespace
+
+TEST_CASE("Edits are journaled and recovered", "[journal]")
+{
+	removeFiles();
+	{
+		RecipeBook book;
+		Journal journal(book);
+		REQUIRE( journal.open(PATH) );
+		CHECK( book.number_of_entries() == 0 );
+
+		Recipe * foo = new Recipe("foo");
+		foo->add(new Beverage("mineral water", 10));
+		book.add(foo);
+		book.add(new Recipe("bar"));
+		REQUIRE( journal.commit() );
+		CHECK( journal.pending() == 0 );
+
+		// a save is as big as the edit
+		long before = sizeOf(JOURNAL_PATH);
+		foo->add(new Extra("lemon slices"));
+		CHECK( journal.pending() == 1 );
+		REQUIRE( journal.commit() );
+		CHECK( sizeOf(JOURNAL_PATH) - before < 32 );
+
+		book.getNth(2).add(new Beverage("milk", 8));
+		foo->remove(1u);
+		book.add(new Recipe("baz"));
+		book.remove(3u);
+		REQUIRE( journal.commit() );
+
+		// not committed, so lost
+		book.add(new Recipe("lost"));
+	}
+	CHECK( sizeOf(PATH) == -1 );
+
+	RecipeBook book;
+	Journal journal(book);
+	REQUIRE( journal.open(PATH) );
+	CHECK( book.number_of_entries() == 2 );
+	CHECK( book.getNth(1).getName() == "foo" );
+	CHECK( book.getNth(1).number_of_ingredients() == 1 );
+	CHECK( book.getNth(2).number_of_ingredients() == 1 );
+
+	SECTION("compaction writes a snapshot and starts over")
+	{
+		book.add(new Recipe("new"));
+		REQUIRE( journal.compact() );
+		CHECK( sizeOf(PATH) > 0 );
+		CHECK( journal.journalBytes() == static_cast<unsigned long>(
+												sizeOf(JOURNAL_PATH)) );
+		book.remove(1u);
+		REQUIRE( journal.commit() );
+		std::string expected = text(book);
+
+		RecipeBook recovered;
+		Journal again(recovered);
+		REQUIRE( again.open(PATH) );
+		CHECK( text(recovered) == expected );
+	}
+
+	SECTION("a cleared book is saved as a snapshot")
+	{
+		book.clear();
+		book.add(new Recipe("only"));
+		CHECK( journal.pending() == 0 );
+		REQUIRE( journal.commit() );
+		std::string expected = text(book);
+
+		RecipeBook recovered;
+		Journal again(recovered);
+		REQUIRE( again.open(PATH) );
+		CHECK( text(recovered) == expected );
+	}
+
+	SECTION("a torn record at the end is cut off")
+	{
+		book.add(new Recipe("torn"));
+		REQUIRE( journal.commit() );
+		long size = sizeOf(JOURNAL_PATH);
+		{
+			std::ofstream ofs(JOURNAL_PATH, std::ios::out | std::ios::binary |
+												std::ios::in);
+			ofs.seekp(size - 2);
+			ofs.put('!');
+		}
+
+		RecipeBook recovered;
+		Journal again(recovered);
+		REQUIRE( again.open(PATH) );
+		CHECK( recovered.number_of_entries() == 2 );
+		CHECK( sizeOf(JOURNAL_PATH) < size );
+
+		// and appending goes on after the last intact record
+		recovered.add(new Recipe("fine"));
+		REQUIRE( again.commit() );
+		RecipeBook last;
+		Journal third(last);
+		REQUIRE( third.open(PATH) );
+		CHECK( last.number_of_entries() == 3 );
+		CHECK( last.findByName("fine") != nullptr );
+	}
+
+	SECTION("removing a stray Recipe cuts nothing off")
+	{
+		book.add(new Recipe("before"));
+		book.remove(new Recipe("stray"));
+		book.add(new Recipe("after"));
+		CHECK( journal.pending() == 2 );
+		REQUIRE( journal.commit() );
+
+		RecipeBook recovered;
+		Journal again(recovered);
+		REQUIRE( again.open(PATH) );
+		CHECK( recovered.number_of_entries() == 4 );
+		CHECK( recovered.findByName("after") != nullptr );
+	}
+
+	SECTION("a journal of another snapshot is ignored")
+	{
+		std::string old;
+		{
+			std::ifstream ifs(JOURNAL_PATH, std::ios::in | std::ios::binary);
+			std::stringstream ss;
+			ss << ifs.rdbuf();
+			old = ss.str();
+		}
+		{
+			std::ofstream ofs(PATH, std::ios::out | std::ios::binary);
+			RecipeBook other;
+			other.add(new Recipe("other"));
+			other.serializeBinary(ofs);
+		}
+
+		RecipeBook recovered;
+		Journal again(recovered);
+		REQUIRE( again.open(PATH) );
+		CHECK( recovered.number_of_entries() == 1 );
+		CHECK( recovered.getNth(1).getName() == "other" );
+		CHECK( sizeOf(JOURNAL_PATH) < static_cast<long>(old.size()) );
+	}
+
+	removeFiles();
+}
@@ -0,0 +1,98 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/lazy_book.hxx"
+
+#include <cstdio> // test removes its temporary file
+#include <fstream>
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+char const * const PATH = "banch_lazy_book_test.tmp";
+
+} // namespace
+
+TEST_CASE("Recipes are built from a file when they are asked for",
+			"[lazybook]")
+{
+	RecipeBook book;
+	for (unsigned int k = 0; k < 100; ++k)
+	{
+		Recipe * recipe = new Recipe("recipe " + std::to_string(k));
+		recipe->add(new Beverage("beverage " + std::to_string(k), k));
+		if (k % 2 == 0)
+		{
+			recipe->add(new Extra("extra " + std::to_string(k)));
+		}
+		book.add(recipe);
+	}
+	book.add(new Recipe("startrecipe"));
+	book.add(new Recipe("recipe 7"));
+
+	SECTION("text format")
+	{
+		std::ofstream ofs(PATH);
+		book.serialize(ofs);
+	}
+
+	SECTION("binary format")
+	{
+		std::ofstream ofs(PATH, std::ios::out | std::ios::binary);
+		book.serializeBinary(ofs);
+	}
+
+	LazyBook lazy(8);
+	REQUIRE( lazy.open(PATH) );
+	REQUIRE( lazy.number_of_entries() == 102 );
+	CHECK( lazy.cached() == 0 );
+	CHECK( lazy.getName(101) == "startrecipe" );
+
+	std::stringstream names;
+	lazy.list(names);
+	CHECK( names.str().find("recipe 99\nstartrecipe\nrecipe 7\n") !=
+			std::string::npos );
+	CHECK( lazy.cached() == 0 );
+
+	// built Recipes are the same as the ones saved
+	for (unsigned int n = 1; n <= lazy.number_of_entries(); ++n)
+	{
+		REQUIRE( lazy.getNth(n) == book.getNth(n) );
+	}
+	CHECK( lazy.cached() == 8 );
+
+	// lookups find the first of a name
+	REQUIRE( lazy.findByName("recipe 7") != nullptr );
+	CHECK( *lazy.findByName("recipe 7") == book.getNth(8) );
+	CHECK( lazy.numberOf("recipe 7") == 8 );
+	CHECK( lazy.findByName("recipe 100") == nullptr );
+
+	// the Recipe asked for over and over stays built
+	Recipe * often = &lazy.getNth(1);
+	for (unsigned int n = 2; n <= 50; ++n)
+	{
+		lazy.getNth(n);
+		CHECK( &lazy.getNth(1) == often );
+	}
+	CHECK( lazy.cached() == 8 );
+
+	lazy.close();
+	CHECK( lazy.number_of_entries() == 0 );
+	std::remove(PATH);
+}
+
+TEST_CASE("A corrupt binary file can't be browsed", "[lazybook]")
+{
+	{
+		std::ofstream ofs(PATH, std::ios::out | std::ios::binary);
+		ofs << "BNCH";
+	}
+	LazyBook lazy;
+	CHECK_FALSE( lazy.open(PATH) );
+	CHECK( lazy.number_of_entries() == 0 );
+	CHECK_FALSE( lazy.open("there/is/no/such/file") );
+	std::remove(PATH);
+}
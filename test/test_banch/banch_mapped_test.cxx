@@ -0,0 +1,246 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+
+#include <cstdio> // test removes its temporary file
+#include <cstring>
+#include <fstream>
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+char const * const PATH = "banch_mapped_test.tmp";
+
+void fill(RecipeBook & book)
+{
+	Recipe * foo = new Recipe("foo");
+	foo->add(new Beverage("mineral water", 10));
+	foo->add(new Extra("lemon slices"));
+
+	Recipe * bar = new Recipe("bar");
+	bar->add(new Beverage("milk", 8));
+
+	book.add(foo);
+	book.add(bar);
+	book.add(new Recipe("empty"));
+}
+
+} // namespace
+
+TEST_CASE("Lines can be scanned in place", "[mapped]")
+{
+	std::string data = "foo\n\nbar";
+	LineScanner scanner(data.data(), data.data() + data.size());
+
+	char const * line;
+	unsigned int size;
+	REQUIRE( scanner.next(line, size) );
+	CHECK( std::string(line, size) == "foo" );
+	REQUIRE( scanner.next(line, size) );
+	CHECK( size == 0 );
+	REQUIRE( scanner.next(line, size) );
+	CHECK( std::string(line, size) == "bar" );
+	CHECK_FALSE( scanner.next(line, size) );
+}
+
+TEST_CASE("Scanning lines by blocks agrees with getline", "[mapped]")
+{
+	// line lengths around the block size, so newlines fall everywhere in a
+	// block, the tail included
+	std::string data;
+	unsigned int seed = 7;
+	for (unsigned int k = 0; k < 500; ++k)
+	{
+		seed = seed * 1103515245 + 12345;
+		data.append((seed >> 16) % 70, 'a' + k % 26);
+		data += '\n';
+	}
+	data += "no newline at the end";
+
+	for (unsigned int cut = 0; cut < 80; ++cut)
+	{
+		std::string const text = data.substr(cut, data.size() - 2 * cut);
+		std::istringstream iss(text);
+		LineScanner scanner(text.data(), text.data() + text.size());
+
+		std::string expected;
+		char const * line = nullptr;
+		unsigned int size = 0;
+		while (getline(iss, expected))
+		{
+			REQUIRE( scanner.next(line, size) );
+			REQUIRE( std::string(line, size) == expected );
+		}
+		CHECK_FALSE( scanner.next(line, size) );
+	}
+}
+
+TEST_CASE("Quantities are parsed like operator>> does", "[mapped]")
+{
+	CHECK( parseUnsigned("0", 1) == 0 );
+	CHECK( parseUnsigned("42", 2) == 42 );
+	CHECK( parseUnsigned("  7x", 4) == 7 );
+	CHECK( parseUnsigned("4294967295", 10) == 4294967295u );
+	CHECK( parseUnsigned("", 0) == 0 );
+
+	// what operator>> stores where it converts or fails
+	char const * const odd[] = { "4294967296", "99999999999999999999", "+3",
+									"-3", "-0", "\r12", "x" };
+	for (unsigned int k = 0; k < sizeof(odd) / sizeof(odd[0]); ++k)
+	{
+		std::istringstream iss(odd[k]);
+		unsigned int expected = 0;
+		iss >> expected;
+		INFO( odd[k] );
+		CHECK( parseUnsigned(odd[k], std::strlen(odd[k])) == expected );
+	}
+	CHECK( parseUnsigned("4294967296", 10) == 4294967295u );
+}
+
+TEST_CASE("A database file can be loaded through a mapping", "[mapped]")
+{
+	RecipeBook book;
+	fill(book);
+
+	std::stringstream expected;
+	book.serialize(expected);
+
+	SECTION("text format")
+	{
+		std::ofstream ofs(PATH);
+		book.serialize(ofs);
+	}
+
+	SECTION("binary format")
+	{
+		std::ofstream ofs(PATH, std::ios::out | std::ios::binary);
+		book.serializeBinary(ofs);
+	}
+
+	RecipeBook copy;
+	REQUIRE( copy.load(PATH) );
+	std::remove(PATH);
+
+	CHECK( copy.number_of_entries() == 3 );
+	CHECK( copy.getNth(1).getName() == "foo" );
+	CHECK( copy.getNth(2).number_of_ingredients() == 1 );
+
+	std::stringstream actual;
+	copy.serialize(actual);
+	CHECK( actual.str() == expected.str() );
+
+	// loaded recipes can be edited like any other
+	copy.getNth(1).add(new Extra("ice"));
+	copy.getNth(1).remove(1);
+	copy.add(new Recipe("new"));
+	CHECK( copy.number_of_entries() == 4 );
+	CHECK( copy.getNth(1).number_of_ingredients() == 2 );
+}
+
+TEST_CASE("A loaded book can be saved over its own file", "[mapped]")
+{
+	// big enough for the names to span many pages of the mapping
+	{
+		RecipeBook book;
+		for (unsigned int k = 0; k < 20000; ++k)
+		{
+			Recipe * recipe = new Recipe("recipe " + std::to_string(k));
+			recipe->add(new Beverage("gin " + std::to_string(k), 4));
+			recipe->add(new Extra("lime"));
+			book.add(recipe);
+		}
+		REQUIRE( book.save(PATH) );
+	}
+
+	RecipeBook book;
+	REQUIRE( book.load(PATH) );
+	std::stringstream expected;
+	book.serialize(expected);
+
+	SECTION("text format")
+	{
+		REQUIRE( book.save(PATH) );
+	}
+
+	SECTION("binary format")
+	{
+		REQUIRE( book.save(PATH, true) );
+	}
+
+	// the names still point into the old file, which is intact
+	std::stringstream after;
+	book.serialize(after);
+	CHECK( after.str() == expected.str() );
+
+	RecipeBook copy;
+	REQUIRE( copy.load(PATH) );
+	std::stringstream reloaded;
+	copy.serialize(reloaded);
+	CHECK( reloaded.str() == expected.str() );
+
+	std::remove(PATH);
+}
+
+TEST_CASE("Loading a missing or corrupt file leaves the book empty", "[mapped]")
+{
+	RecipeBook book;
+	fill(book);
+
+	CHECK_FALSE( book.load("there/is/no/such/file") );
+	CHECK( book.number_of_entries() == 0 );
+
+	{
+		std::ofstream ofs(PATH, std::ios::out | std::ios::binary);
+		ofs << "BNCH";
+	}
+	fill(book);
+	CHECK_FALSE( book.load(PATH) );
+	CHECK( book.number_of_entries() == 0 );
+
+	{
+		std::ofstream ofs(PATH);
+	}
+	CHECK( book.load(PATH) );
+	CHECK( book.number_of_entries() == 0 );
+	std::remove(PATH);
+}
+
+TEST_CASE("Text can be deserialized on several threads", "[mapped]")
+{
+	RecipeBook book;
+	for (unsigned int i = 0; i < 500; ++i)
+	{
+		Recipe * recipe = new Recipe("recipe " + std::to_string(i));
+		recipe->add(new Beverage("beverage " + std::to_string(i), i));
+		if (i % 3 == 0)
+		{
+			// names that look like record boundaries
+			recipe->add(new Extra("endrecipe"));
+			recipe->add(new Beverage("startrecipe", 1));
+		}
+		book.add(recipe);
+	}
+	book.add(new Recipe("startrecipe"));
+
+	std::stringstream expected;
+	book.serialize(expected);
+	std::string data = expected.str();
+
+	for (unsigned int threads = 1; threads <= 8; ++threads)
+	{
+		RecipeBook copy;
+		copy.deserialize(data.data(), data.data() + data.size(), threads);
+		REQUIRE( copy.number_of_entries() == 501 );
+
+		std::stringstream actual;
+		copy.serialize(actual);
+		CHECK( actual.str() == data );
+	}
+
+	RecipeBook empty;
+	empty.deserialize(data.data(), data.data(), 4);
+	CHECK( empty.number_of_entries() == 0 );
+}
@@ -134,3 +134,73 @@ TEST_CASE("A recipe can be persistent", "[recipe][serialization]")
 		);
 	}
 }
+
+TEST_CASE("Recipes are compared by their contents", "[recipe]")
+{
+	Recipe negroni("Negroni");
+	negroni.add(new Beverage("gin", 3));
+	negroni.add(new Beverage("campari", 3));
+	negroni.add(new Beverage("sweet vermouth", 3));
+	negroni.add(new Extra("orange peel"));
+
+	// same ingredients, different objects in a different order
+	Recipe same("Negroni");
+	same.add(new Extra("orange peel"));
+	same.add(new Beverage("sweet vermouth", 3));
+	same.add(new Beverage("gin", 3));
+	same.add(new Beverage("campari", 3));
+
+	CHECK( negroni == same );
+	CHECK( negroni.fingerprint() == same.fingerprint() );
+
+	SECTION("any difference makes them unequal")
+	{
+		Recipe renamed("Negroni sbagliato");
+		Recipe fewer("Negroni");
+		Recipe other("Negroni");
+		renamed.add(new Beverage("gin", 3));
+		renamed.add(new Beverage("campari", 3));
+		renamed.add(new Beverage("sweet vermouth", 3));
+		renamed.add(new Extra("orange peel"));
+		fewer.add(new Beverage("gin", 3));
+		fewer.add(new Beverage("campari", 3));
+		fewer.add(new Beverage("sweet vermouth", 3));
+		other.add(new Beverage("gin", 3));
+		other.add(new Beverage("campari", 3));
+		other.add(new Beverage("sweet vermouth", 4));
+		other.add(new Extra("orange peel"));
+
+		CHECK( negroni != renamed );
+		CHECK( negroni != fewer );
+		CHECK( negroni != other );
+		CHECK( negroni.fingerprint() != renamed.fingerprint() );
+		CHECK( negroni.fingerprint() != fewer.fingerprint() );
+		CHECK( negroni.fingerprint() != other.fingerprint() );
+	}
+
+	SECTION("repeated ingredients count")
+	{
+		Recipe doubled("Negroni");
+		doubled.add(new Beverage("gin", 3));
+		doubled.add(new Beverage("gin", 3));
+		Recipe mixed("Negroni");
+		mixed.add(new Beverage("gin", 3));
+		mixed.add(new Beverage("campari", 3));
+
+		CHECK( doubled != mixed );
+		CHECK( doubled.fingerprint() != mixed.fingerprint() );
+	}
+
+	SECTION("the fingerprint follows removals")
+	{
+		Extra * peel = new Extra("lemon peel");
+		same.add(peel);
+		CHECK( negroni != same );
+		same.remove(peel);
+		CHECK( negroni == same );
+		CHECK( negroni.fingerprint() == same.fingerprint() );
+
+		same.clear();
+		CHECK( same.fingerprint() == Recipe("Negroni").fingerprint() );
+	}
+}
@@ -2,6 +2,7 @@
 #include "banch/banch.hxx"
 
 #include <sstream> // test uses stringstreams
+#include <string>
 
 using namespace Catch;
 using namespace banch;
@@ -116,3 +117,209 @@ TEST_CASE("A recipe book can be persistent", "[recipebook][serialization]")
 		CHECK( myDrinksCopy.number_of_entries() == 2 );
 	}
 }
+
+TEST_CASE("Recipes can be accessed by number", "[recipebook]")
+{
+	// create a book with a few recipes
+	RecipeBook qux;
+	Recipe * recipes[5];
+	for (unsigned int i = 0; i < 5; ++i)
+	{
+		recipes[i] = new Recipe(std::string(1, 'a' + i));
+		qux.add(recipes[i]);
+	}
+
+	// numbering starts from 1
+	CHECK( &qux.getNth(1) == recipes[0] );
+	CHECK( &qux.getNth(5) == recipes[4] );
+
+	// numbers shift after removal
+	qux.remove(2);
+	CHECK( qux.number_of_entries() == 4 );
+	CHECK( qux.getNth(2).getName() == "c" );
+
+	// same goes for Ingredients in a Recipe
+	Recipe & recipe = qux.getNth(1);
+	recipe.add(new Beverage("gin", 2));
+	recipe.add(new Beverage("tonic", 4));
+	recipe.add(new Extra("lime"));
+	recipe.remove(2u);
+	CHECK( recipe.number_of_ingredients() == 2 );
+
+	std::stringstream ss;
+	recipe.serialize(ss);
+	CHECK_THAT( ss.str().c_str(),
+			Equals( "startrecipe\n" \
+						"a\n" \
+						"beverage\ngin\n2\n" \
+						"extra\nlime\n" \
+						"endrecipe\n"
+			)
+	);
+}
+
+TEST_CASE("Recipes can be found by name", "[recipebook]")
+{
+	RecipeBook qux;
+	Recipe * foo = new Recipe("foo");
+	Recipe * bar = new Recipe("bar");
+	Recipe * otherFoo = new Recipe("foo");
+	qux.add(foo);
+	qux.add(bar);
+	qux.add(otherFoo);
+
+	CHECK( qux.findByName("foo") == foo );
+	CHECK( qux.findByName("bar") == bar );
+	CHECK( qux.findByName("baz") == nullptr );
+	CHECK( qux.findByName("") == nullptr );
+
+	SECTION("the next one of the same name takes over on removal")
+	{
+		qux.remove(foo);
+		CHECK( qux.findByName("foo") == otherFoo );
+		qux.remove(otherFoo);
+		CHECK( qux.findByName("foo") == nullptr );
+		CHECK( qux.findByName("bar") == bar );
+	}
+
+	SECTION("the index is rebuilt on deserialization")
+	{
+		std::stringstream ss;
+		qux.serialize(ss);
+		qux.deserialize(ss);
+
+		CHECK( qux.number_of_entries() == 3 );
+		CHECK( qux.findByName("bar") == &qux.getNth(2) );
+		CHECK( qux.findByName("foo") == &qux.getNth(1) );
+
+		qux.clear();
+		CHECK( qux.findByName("bar") == nullptr );
+	}
+}
+
+namespace {
+
+/// observer that counts the Recipes it's told about
+class RemovalCounter : public BookObserver {
+public:
+	RemovalCounter() : removed(0) {}
+
+	void recipeRemoved(Recipe const &) { ++this->removed; }
+
+	unsigned int removed;
+};
+
+} // namespace
+
+TEST_CASE("Observers only hear about removing Recipes of the book",
+			"[recipebook]")
+{
+	RecipeBook book;
+	book.add(new Recipe("foo"));
+	RemovalCounter counter;
+	book.attach(&counter);
+
+	// a stray Recipe is still deleted, like it always was
+	Recipe * stray = new Recipe("foo");
+	stray->add(new Extra("ice"));
+	book.remove(stray);
+	CHECK( counter.removed == 0 );
+	REQUIRE( book.number_of_entries() == 1 );
+	CHECK( book.findByName("foo") == &book.getNth(1) );
+
+	book.remove(1u);
+	CHECK( counter.removed == 1 );
+	CHECK( book.number_of_entries() == 0 );
+	book.detach(&counter);
+}
+
+TEST_CASE("Duplicate recipes can be removed", "[recipebook]")
+{
+	RecipeBook book;
+	for (unsigned int k = 0; k < 30; ++k)
+	{
+		// every name and quantity comes up three times
+		Recipe * recipe = new Recipe("recipe " + std::to_string(k % 10));
+		recipe->add(new Beverage("gin", k % 10));
+		recipe->add(new Extra("ice"));
+		book.add(recipe);
+	}
+	Recipe * lookalike = new Recipe("recipe 1");
+	lookalike->add(new Beverage("gin", 2));
+	lookalike->add(new Extra("ice"));
+	book.add(lookalike);
+
+	nostl::Vector<Recipe *> duplicates = book.findDuplicates();
+	REQUIRE( duplicates.size() == 20 );
+	CHECK( duplicates[0] == &book.getNth(11) );
+	CHECK( duplicates[19] == &book.getNth(30) );
+
+	CHECK( book.removeDuplicates() == 20 );
+	CHECK( book.number_of_entries() == 11 );
+	CHECK( book.getNth(11) == *lookalike );
+	CHECK( book.findByName("recipe 1") == &book.getNth(2) );
+	CHECK( book.findDuplicates().empty() );
+}
+
+TEST_CASE("A recipe book can keep its recipes in arenas", "[recipebook][arena]")
+{
+	RecipeBook book(RecipeBook::ARENA);
+	REQUIRE( book.inArena() );
+	REQUIRE_FALSE( RecipeBook().inArena() );
+
+	// a Recipe from the heap, still deleted on its own
+	Recipe * foo = new Recipe("foo");
+	foo->add(new Beverage("mineral water", 10));
+	foo->add(new Extra("lemon slices"));
+	book.add(foo);
+	Recipe * bar = new Recipe("bar");
+	bar->add(new Beverage("milk", 8));
+	book.add(bar);
+
+	std::stringstream expected;
+	book.serialize(expected);
+
+	SECTION("from a stream")
+	{
+		std::stringstream ss(expected.str());
+		book.deserialize(ss);
+	}
+
+	SECTION("in place, on several threads")
+	{
+		// the names are copied, the text may go away
+		std::string text = expected.str() + expected.str();
+		book.deserialize(text.data(), text.data() + text.size(), 4);
+		text.assign(text.size(), '?');
+		REQUIRE( book.number_of_entries() == 4 );
+		book.remove(3u);
+		book.remove(3u);
+	}
+
+	SECTION("from the binary format")
+	{
+		std::stringstream binary;
+		book.serializeBinary(binary);
+		REQUIRE( book.deserializeBinary(binary) );
+	}
+
+	std::stringstream loaded;
+	book.serialize(loaded);
+	CHECK( loaded.str() == expected.str() );
+	REQUIRE( book.findByName("bar") == &book.getNth(2) );
+
+	// edits of the Recipes in the arena
+	Recipe & recipe = book.getNth(1);
+	recipe.add(new Beverage("soda", 2));
+	recipe.remove(1u);
+	CHECK( recipe.number_of_ingredients() == 2 );
+	CHECK( recipe.getNth(2).fingerprint() == Beverage("soda", 2).fingerprint() );
+	book.add(new Recipe("baz"));
+	book.remove(2u);
+	CHECK( book.number_of_entries() == 2 );
+	CHECK( book.findByName("baz") == &book.getNth(2) );
+
+	book.clear();
+	CHECK( book.number_of_entries() == 0 );
+	CHECK( book.findByName("foo") == nullptr );
+}
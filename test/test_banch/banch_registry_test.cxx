@@ -0,0 +1,143 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/registry.hxx"
+
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+/// ingredient kind the library doesn't know about
+class Garnish : public Ingredient {
+public:
+	Garnish(std::string const & text = "") : text_(text) {}
+
+	void print(std::ostream & os) const { os << "garnish: " << this->text_; }
+
+	void serialize(nostl::Sink & sink) const
+	{
+		sink << "garnish\n" << this->text_ << '\n';
+	}
+	using Ingredient::serialize;
+
+	void deserialize(std::istream & is) { getline(is, this->text_); }
+
+	void deserialize(LineScanner & scanner)
+	{
+		char const * line;
+		unsigned int size;
+		if (scanner.next(line, size))
+		{
+			this->text_.assign(line, size);
+		}
+	}
+
+	void serializeBinary(BinaryWriter & writer) const
+	{
+		writer.writeByte(GARNISH_TAG);
+		writer.writeString(this->text_);
+	}
+
+	void deserializeBinary(BinaryReader & reader)
+	{
+		reader.readString(this->text_);
+	}
+
+	static std::uint8_t const GARNISH_TAG = 42;
+
+private:
+	std::string text_;
+};
+
+void registerGarnish()
+{
+	static bool registered = IngredientRegistry::instance().add(
+						"garnish", Garnish::GARNISH_TAG, &makeIngredient<Garnish>);
+	REQUIRE( registered );
+}
+
+} // namespace
+
+TEST_CASE("The built-in ingredient kinds are registered", "[registry]")
+{
+	IngredientRegistry const & registry = IngredientRegistry::instance();
+
+	REQUIRE( registry.find("beverage", 8) != nullptr );
+	REQUIRE( registry.find("beverage", 8)->tag == BINARY_TAG_BEVERAGE );
+	REQUIRE( registry.find(BINARY_TAG_EXTRA) == registry.find("extra", 5) );
+
+	REQUIRE( registry.find("bev", 3) == nullptr );
+	REQUIRE( registry.find("beverages", 9) == nullptr );
+	REQUIRE( registry.find("", 0) == nullptr );
+	REQUIRE( registry.find(std::uint8_t(0)) == nullptr );
+
+	Ingredient * ingredient = registry.find("beverage", 8)->factory();
+	REQUIRE( dynamic_cast<Beverage *>(ingredient) != nullptr );
+	delete ingredient;
+}
+
+TEST_CASE("Taken keywords and tags can't be registered again", "[registry]")
+{
+	IngredientRegistry & registry = IngredientRegistry::instance();
+	unsigned int size = registry.size();
+
+	REQUIRE_FALSE( registry.add("beverage", 200, &makeIngredient<Extra>) );
+	REQUIRE_FALSE( registry.add("cocktail", BINARY_TAG_EXTRA,
+								&makeIngredient<Extra>) );
+	REQUIRE( registry.size() == size );
+}
+
+TEST_CASE("New ingredient kinds plug into every format", "[registry]")
+{
+	registerGarnish();
+
+	RecipeBook book;
+	Recipe * foo = new Recipe("foo");
+	foo->add(new Beverage("gin", 4));
+	foo->add(new Garnish("a sprig of rosemary"));
+	foo->add(new Extra("ice"));
+	book.add(foo);
+
+	std::stringstream text;
+	book.serialize(text);
+	std::string data = text.str();
+
+	SECTION("text from a stream")
+	{
+		RecipeBook copy;
+		copy.deserialize(text);
+		REQUIRE( copy.getNth(1).number_of_ingredients() == 3 );
+
+		std::stringstream again;
+		copy.serialize(again);
+		REQUIRE( again.str() == data );
+	}
+
+	SECTION("text in place")
+	{
+		RecipeBook copy;
+		copy.deserialize(data.data(), data.data() + data.size(), 1);
+		REQUIRE( copy.getNth(1).number_of_ingredients() == 3 );
+
+		std::stringstream again;
+		copy.serialize(again);
+		REQUIRE( again.str() == data );
+	}
+
+	SECTION("binary")
+	{
+		std::stringstream binary;
+		book.serializeBinary(binary);
+
+		RecipeBook copy;
+		REQUIRE( copy.deserializeBinary(binary) );
+		REQUIRE( copy.getNth(1).number_of_ingredients() == 3 );
+
+		std::stringstream again;
+		copy.serialize(again);
+		REQUIRE( again.str() == data );
+	}
+}
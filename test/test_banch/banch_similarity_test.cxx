@@ -0,0 +1,139 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/similarity.hxx"
+
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+/// names of the Recipes of every cluster, like "a b, c d"
+std::string describe(nostl::Vector<nostl::Vector<Recipe *> > const & clusters)
+{
+	std::string result;
+	for (unsigned int k = 0; k < clusters.size(); ++k)
+	{
+		result += k == 0 ? "" : ", ";
+		for (unsigned int i = 0; i < clusters[k].size(); ++i)
+		{
+			result += (i == 0 ? "" : " ") + clusters[k][i]->getName();
+		}
+	}
+	return result;
+}
+
+/// add a Recipe with a range of numbered beverages
+Recipe * numbered(RecipeBook & book, std::string const & name,
+					unsigned int from, unsigned int to)
+{
+	Recipe * recipe = new Recipe(name);
+	for (unsigned int k = from; k < to; ++k)
+	{
+		recipe->add(new Beverage("beverage " + std::to_string(k), k));
+	}
+	book.add(recipe);
+	return recipe;
+}
+
+} // namespace
+
+TEST_CASE("MinHash signatures estimate the similarity", "[similarity]")
+{
+	RecipeBook book;
+	Recipe * all = numbered(book, "all", 0, 300);
+	Recipe * half = numbered(book, "half", 100, 300);
+	Recipe * none = numbered(book, "none", 300, 400);
+
+	MinHash signature = MinHash::of(*all);
+	CHECK( signature.similarity(signature) == 1.0 );
+	CHECK( signature.similarity(MinHash::of(*none)) < 0.15 );
+	CHECK( signature.similarity(MinHash::of(*half)) > 0.4 );
+	CHECK( signature.similarity(MinHash::of(*half)) < 0.95 );
+
+	// names are normalized and quantities don't count
+	Recipe loud("loud");
+	loud.add(new Beverage("White  RUM", 1));
+	Recipe quiet("quiet");
+	quiet.add(new Beverage("white rum", 5));
+	CHECK( MinHash::of(loud).similarity(MinHash::of(quiet)) == 1.0 );
+}
+
+TEST_CASE("Near-duplicate recipes are clustered", "[similarity]")
+{
+	RecipeBook book;
+	Recipe * mojito = new Recipe("Mojito");
+	mojito->add(new Beverage("white rum", 4));
+	mojito->add(new Beverage("lime juice", 2));
+	mojito->add(new Beverage("simple syrup", 1));
+	mojito->add(new Beverage("soda water", 8));
+	mojito->add(new Extra("mint leaves"));
+	book.add(mojito);
+
+	Recipe * daiquiri = new Recipe("Daiquiri");
+	daiquiri->add(new Beverage("white rum", 6));
+	daiquiri->add(new Beverage("lime juice", 3));
+	book.add(daiquiri);
+
+	book.add(new Recipe("Empty"));
+	book.add(new Recipe("Empty too"));
+
+	Recipe * house = new Recipe("Mojito (house)");
+	house->add(new Beverage("White rum", 5));
+	house->add(new Beverage("lime juice", 2));
+	house->add(new Beverage("simple syrup", 2));
+	house->add(new Beverage("soda water", 6));
+	house->add(new Extra("mint leaves"));
+	book.add(house);
+
+	Recipe * negroni = new Recipe("Negroni");
+	negroni->add(new Beverage("gin", 3));
+	negroni->add(new Beverage("campari", 3));
+	negroni->add(new Beverage("sweet vermouth", 3));
+	book.add(negroni);
+
+	Recipe * copy = new Recipe("Negroni copy");
+	copy->add(new Beverage("gin", 3));
+	copy->add(new Beverage("campari", 3));
+	copy->add(new Beverage("sweet vermouth", 3));
+	book.add(copy);
+
+	SECTION("on one thread")
+	{
+		NearDuplicateFinder finder(0.9);
+		CHECK( describe(finder.clusters(book)) ==
+				"Mojito Mojito (house), Negroni Negroni copy" );
+	}
+
+	SECTION("on several threads")
+	{
+		NearDuplicateFinder finder(0.9, 4);
+		CHECK( describe(finder.clusters(book)) ==
+				"Mojito Mojito (house), Negroni Negroni copy" );
+	}
+
+	SECTION("a lot of recipes")
+	{
+		// families of recipes that only differ in one of twenty ingredients
+		for (unsigned int k = 0; k < 1000; ++k)
+		{
+			Recipe * recipe = numbered(book, "family " + std::to_string(k % 50),
+										k % 50 * 1000, k % 50 * 1000 + 19);
+			recipe->add(new Extra("variation " + std::to_string(k)));
+		}
+
+		nostl::Vector<nostl::Vector<Recipe *> > one =
+										NearDuplicateFinder(0.7).clusters(book);
+		nostl::Vector<nostl::Vector<Recipe *> > four =
+									NearDuplicateFinder(0.7, 4).clusters(book);
+		CHECK( describe(one) == describe(four) );
+		REQUIRE( one.size() == 52 );
+		for (unsigned int k = 2; k < one.size(); ++k)
+		{
+			CHECK( one[k].size() == 20 );
+			CHECK( one[k][0]->getName() ==
+					"family " + std::to_string(k - 2) );
+		}
+	}
+}
@@ -0,0 +1,183 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/symbols.hxx"
+
+#include <cstdio>
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+char const * const PATH = "banch_symbols_test.tmp";
+
+/// name of the n-th Ingredient of the n-th Recipe
+nostl::CowString nameOf(RecipeBook & book, unsigned int recipe,
+						unsigned int ingredient)
+{
+	IngredientValue value;
+	REQUIRE( book.getNth(recipe).getNth(ingredient).toValue(value) );
+	return value.name;
+}
+
+} // namespace
+
+TEST_CASE("Names are interned once", "[symbols]")
+{
+	SymbolTable symbols;
+	std::string vodka = "vodka";
+
+	std::uint32_t id = symbols.intern(vodka.data(), vodka.size());
+	CHECK( id == 0 );
+	CHECK( symbols.intern(nostl::CowString("lime juice")) == 1 );
+	CHECK( symbols.intern(nostl::CowString("vodka")) == id );
+	CHECK( symbols.size() == 2 );
+
+	// the kept copy doesn't depend on what was interned
+	vodka = "gin";
+	CHECK( symbols.name(id) == "vodka" );
+	CHECK( symbols.name(id).borrowed() );
+	CHECK( symbols.find("vodka", 5) == id );
+	CHECK( symbols.find("gin", 3) == SymbolTable::NONE );
+	CHECK( symbols.bytes() == 15 );
+
+	// names differing in case and spacing share a normalized form
+	std::uint32_t shouted = symbols.intern(nostl::CowString("LIME  Juice"));
+	CHECK( symbols.size() == 3 );
+	CHECK( symbols.normalized(shouted) == 1 );
+	CHECK( symbols.normalized(1) == 1 );
+	std::uint32_t tea = symbols.intern(nostl::CowString("Iced Tea"));
+	CHECK( symbols.size() == 5 );
+	CHECK( symbols.name(symbols.normalized(tea)) == "iced tea" );
+
+	symbols.clear();
+	CHECK( symbols.size() == 0 );
+	CHECK( symbols.find("vodka", 5) == SymbolTable::NONE );
+	CHECK( symbols.intern(nostl::CowString("soda")) == 0 );
+}
+
+TEST_CASE("A book shares the names of its ingredients", "[symbols]")
+{
+	RecipeBook book;
+	for (unsigned int k = 0; k < 3; ++k)
+	{
+		Recipe * recipe = new Recipe("recipe " + std::to_string(k));
+		recipe->add(new Beverage("freshly squeezed lime juice", 2 + k));
+		recipe->add(new Extra("a slice of cucumber, cut rather thin"));
+		book.add(recipe);
+	}
+
+	// added later, to a Recipe already in the book
+	book.getNth(2).add(new Beverage("freshly squeezed lime juice", 9));
+
+	CHECK( book.symbols().size() == 2 );
+	nostl::CowString const juice = nameOf(book, 1, 1);
+	CHECK( juice == "freshly squeezed lime juice" );
+	CHECK( juice.borrowed() );
+	IngredientValue value;
+	REQUIRE( book.getNth(2).getNth(3).toValue(value) );
+	CHECK( book.symbols().name(value.symbol).data() == juice.data() );
+	CHECK( nameOf(book, 3, 1).data() == juice.data() );
+	CHECK( nameOf(book, 2, 3).data() == juice.data() );
+	CHECK( nameOf(book, 2, 2).data() == nameOf(book, 3, 2).data() );
+
+	// contents don't change
+	std::stringstream ss;
+	book.serialize(ss);
+	RecipeBook copy;
+	copy.deserialize(ss);
+	REQUIRE( copy.number_of_entries() == 3 );
+	for (unsigned int k = 1; k <= 3; ++k)
+	{
+		CHECK( copy.getNth(k) == book.getNth(k) );
+	}
+
+	SECTION("views into a mapping are interned too")
+	{
+		std::string const text = "startrecipe\nmapped\nbeverage\nvodka\n4\n"
+									"extra\nvodka\nendrecipe\n";
+		LineScanner scanner(text.data(), text.data() + text.size());
+		book.deserialize(scanner);
+		CHECK( book.symbols().size() == 1 );
+		CHECK( nameOf(book, 1, 1).data() == book.symbols().name(0).data() );
+		CHECK( nameOf(book, 1, 2).data() == book.symbols().name(0).data() );
+	}
+
+	SECTION("clearing the book forgets the names")
+	{
+		book.clear();
+		CHECK( book.symbols().size() == 0 );
+		book.add(new Recipe("empty"));
+		book.getNth(1).add(new Extra("mint"));
+		CHECK( book.symbols().size() == 1 );
+	}
+}
+
+TEST_CASE("A book in arena mode shares the names it loads", "[symbols]")
+{
+	RecipeBook book;
+	for (unsigned int k = 0; k < 500; ++k)
+	{
+		Recipe * recipe = new Recipe("recipe " + std::to_string(k));
+		recipe->add(new Beverage("gin", 1 + k % 7));
+		recipe->add(new Beverage("tonic water", 10));
+		recipe->add(new Extra("ice " + std::to_string(k % 3)));
+		book.add(recipe);
+	}
+
+	RecipeBook arena(RecipeBook::ARENA);
+	unsigned int threads = 1;
+
+	SECTION("text format")
+	{
+		REQUIRE( book.save(PATH) );
+	}
+
+	SECTION("text format, on several threads")
+	{
+		REQUIRE( book.save(PATH) );
+		threads = 4;
+	}
+
+	SECTION("binary format")
+	{
+		REQUIRE( book.save(PATH, true) );
+	}
+
+	REQUIRE( arena.load(PATH, threads) );
+	std::remove(PATH);
+
+	// one copy per distinct name, however many Ingredients have it
+	REQUIRE( arena.number_of_entries() == 500 );
+	CHECK( arena.symbols().size() == 5 );
+	nostl::CowString const gin = nameOf(arena, 1, 1);
+	nostl::CowString const ice = nameOf(arena, 1, 3);
+	for (unsigned int k = 2; k <= 500; ++k)
+	{
+		CHECK( nameOf(arena, k, 1).data() == gin.data() );
+		CHECK( nameOf(arena, k, 2).data() == nameOf(arena, 1, 2).data() );
+		if (k % 3 == 1)
+		{
+			CHECK( nameOf(arena, k, 3).data() == ice.data() );
+		}
+	}
+
+	// the ids are the book's
+	IngredientValue value;
+	REQUIRE( arena.getNth(250).getNth(1).toValue(value) );
+	CHECK( value.symbol == arena.symbols().find("gin", 3) );
+	CHECK( arena.symbols().name(value.symbol).data() == gin.data() );
+
+	// contents don't change
+	for (unsigned int k = 1; k <= 500; ++k)
+	{
+		CHECK( arena.getNth(k) == book.getNth(k) );
+	}
+
+	// Ingredients added later share them as well
+	arena.getNth(7).add(new Extra("ice 0"));
+	CHECK( nameOf(arena, 7, 4).data() == ice.data() );
+	CHECK( arena.symbols().size() == 5 );
+}
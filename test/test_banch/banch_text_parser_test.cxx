@@ -0,0 +1,242 @@
+#include "catch/catch.hpp"
+#include "banch/banch.hxx"
+#include "banch/text_parser.hxx"
+
+#include <sstream> // test uses stringstreams
+#include <string>
+
+using namespace Catch;
+using namespace banch;
+
+namespace {
+
+/// ingredient kind the library doesn't know about
+class Rim : public Ingredient {
+public:
+	Rim(std::string const & text = "") : text_(text) {}
+
+	void print(std::ostream & os) const { os << "rim: " << this->text_; }
+
+	void serialize(nostl::Sink & sink) const
+	{
+		sink << "rim\n" << this->text_ << '\n';
+	}
+	using Ingredient::serialize;
+
+	void deserialize(std::istream & is) { getline(is, this->text_); }
+
+	void deserialize(LineScanner & scanner)
+	{
+		char const * line;
+		unsigned int size;
+		if (scanner.next(line, size))
+		{
+			this->text_.assign(line, size);
+		}
+	}
+
+	void serializeBinary(BinaryWriter & writer) const
+	{
+		writer.writeByte(RIM_TAG);
+		writer.writeString(this->text_);
+	}
+
+	void deserializeBinary(BinaryReader & reader)
+	{
+		reader.readString(this->text_);
+	}
+
+	static std::uint8_t const RIM_TAG = 43;
+
+private:
+	std::string text_;
+};
+
+void registerRim()
+{
+	static bool registered = IngredientRegistry::instance().add(
+								"rim", Rim::RIM_TAG, &makeIngredient<Rim>);
+	REQUIRE( registered );
+}
+
+/// handler that writes down the events it gets
+class Recorder : public TextHandler {
+public:
+	bool recipeStart(nostl::CowString const & name)
+	{
+		this->events << "start " << name << ';';
+		return true;
+	}
+
+	void beverage(nostl::CowString const & name, unsigned int quanta)
+	{
+		this->events << "beverage " << name << ' ' << quanta << ';';
+	}
+
+	void extra(nostl::CowString const & text)
+	{
+		this->events << "extra " << text << ';';
+	}
+
+	void ingredient(std::unique_ptr<Ingredient> ingredient)
+	{
+		this->events << "other ";
+		ingredient->print(this->events);
+		this->events << ';';
+	}
+
+	void recipeEnd() { this->events << "end;"; }
+
+	std::stringstream events;
+};
+
+/// text of the book the tests parse
+std::string sample()
+{
+	RecipeBook book;
+	Recipe * recipe = new Recipe("gin tonic");
+	recipe->add(new Beverage("Gin", 4));
+	recipe->add(new Beverage("tonic  water", 10));
+	recipe->add(new Extra("lime"));
+	book.add(recipe);
+
+	recipe = new Recipe("mojito");
+	recipe->add(new Beverage("rum", 4));
+	recipe->add(new Extra("mint"));
+	recipe->add(new Extra("endrecipe"));
+	recipe->add(new Extra("lime"));
+	book.add(recipe);
+
+	book.add(new Recipe("water"));
+
+	std::stringstream ss;
+	book.serialize(ss);
+	return ss.str();
+}
+
+} // namespace
+
+TEST_CASE("The text parser pushes events in file order", "[text_parser]")
+{
+	std::string const text = sample();
+	std::string const expected =
+		"start gin tonic;beverage Gin 4;beverage tonic  water 10;extra lime;end;"
+		"start mojito;beverage rum 4;extra mint;extra endrecipe;extra lime;end;"
+		"start water;end;";
+
+	SECTION("from memory")
+	{
+		Recorder recorder;
+		LineScanner scanner(text.data(), text.data() + text.size());
+		parseText(scanner, recorder);
+		CHECK( recorder.events.str() == expected );
+	}
+
+	SECTION("from a stream")
+	{
+		Recorder recorder;
+		std::stringstream ss(text);
+		parseText(ss, recorder);
+		CHECK( recorder.events.str() == expected );
+	}
+
+	SECTION("writing the events gives the text back")
+	{
+		std::stringstream ss(text);
+		std::stringstream out;
+		nostl::Sink sink(out);
+		TextWriter writer(sink);
+		parseText(ss, writer);
+		sink.flush();
+		CHECK( out.str() == text );
+		CHECK( writer.recipes() == 3 );
+	}
+
+	SECTION("other kinds are built and handed over")
+	{
+		registerRim();
+		std::string const rimmed = "startrecipe\nmargarita\nrim\nsalt\n"
+									"extra\nlime\nendrecipe\n";
+		Recorder recorder;
+		std::stringstream ss(rimmed);
+		parseText(ss, recorder);
+		CHECK( recorder.events.str() ==
+					"start margarita;other rim: salt;extra lime;end;" );
+
+		std::stringstream out;
+		nostl::Sink sink(out);
+		TextWriter writer(sink);
+		LineScanner scanner(rimmed.data(), rimmed.data() + rimmed.size());
+		parseText(scanner, writer);
+		sink.flush();
+		CHECK( out.str() == rimmed );
+	}
+}
+
+TEST_CASE("A filter passes the matching recipes on", "[text_parser]")
+{
+	std::string const text = sample();
+	Recorder recorder;
+	RecipeFilter filter(recorder);
+
+	SECTION("no criteria pass everything")
+	{
+		std::stringstream ss(text);
+		parseText(ss, filter);
+		CHECK( filter.passed() == 3 );
+		CHECK( filter.dropped() == 0 );
+	}
+
+	SECTION("by name")
+	{
+		filter.nameContains("o");
+		std::stringstream ss(text);
+		parseText(ss, filter);
+		CHECK( recorder.events.str() ==
+			"start gin tonic;beverage Gin 4;beverage tonic  water 10;"
+			"extra lime;end;start mojito;beverage rum 4;extra mint;"
+			"extra endrecipe;extra lime;end;" );
+		CHECK( filter.dropped() == 1 );
+	}
+
+	SECTION("by ingredients (normalized)")
+	{
+		filter.require("lime");
+		filter.require("TONIC WATER");
+		std::stringstream ss(text);
+		parseText(ss, filter);
+		CHECK( recorder.events.str() ==
+			"start gin tonic;beverage Gin 4;beverage tonic  water 10;"
+			"extra lime;end;" );
+		CHECK( filter.passed() == 1 );
+		CHECK( filter.dropped() == 2 );
+	}
+
+	SECTION("without ingredients")
+	{
+		filter.exclude("gin");
+		LineScanner scanner(text.data(), text.data() + text.size());
+		parseText(scanner, filter);
+		CHECK( recorder.events.str() ==
+			"start mojito;beverage rum 4;extra mint;extra endrecipe;"
+			"extra lime;end;start water;end;" );
+	}
+
+	SECTION("rewriting")
+	{
+		std::stringstream out;
+		nostl::Sink sink(out);
+		TextWriter writer(sink);
+		RecipeFilter rewrite(writer);
+		rewrite.require("mint");
+		std::stringstream ss(text);
+		parseText(ss, rewrite);
+		sink.flush();
+
+		RecipeBook book;
+		book.deserialize(out);
+		REQUIRE( book.number_of_entries() == 1 );
+		CHECK( book.getNth(1).getName() == "mojito" );
+		CHECK( book.getNth(1).number_of_ingredients() == 4 );
+	}
+}
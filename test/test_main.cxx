@@ -1,2 +1,3 @@
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_NO_POSIX_SIGNALS // SIGSTKSZ isn't a constant in new glibcs
 #include "catch/catch.hpp"
@@ -0,0 +1,158 @@
+#include "catch/catch.hpp"
+#include "nostl/allocator.hxx"
+#include "nostl/list.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdint>
+#include <string> // test stores strings in pooled Lists and Vectors
+
+using namespace nostl;
+
+TEST_CASE("A pool recycles freed storage", "[allocator]")
+{
+	PoolAllocator<long> pool;
+	long * foo = pool.allocate();
+	long * bar = pool.allocate();
+	REQUIRE( foo != bar );
+
+	// the most recently freed storage is handed out first
+	pool.deallocate(foo);
+	REQUIRE( pool.allocate() == foo );
+}
+
+TEST_CASE("A pool can serve more than one block", "[allocator]")
+{
+	// allocate enough to need several (growing) blocks
+	PoolAllocator<int> pool;
+	int * ptrs[1000];
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		ptrs[i] = new (pool.allocate()) int(i);
+	}
+
+	// make sure nothing got overwritten
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		REQUIRE( *ptrs[i] == static_cast<int>(i) );
+	}
+}
+
+TEST_CASE("Lists work with both allocator policies", "[allocator][list]")
+{
+	List<std::string, HeapAllocator> foo;
+	List<std::string, PoolAllocator> bar;
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		foo.append(std::string(i, 'x'));
+		bar.append(std::string(i, 'x'));
+	}
+
+	REQUIRE( foo.size() == bar.size() );
+
+	// removing and readding reuses the pooled Nodes
+	bar.remove(std::string(50, 'x'));
+	bar.prepend(std::string(50, 'x'));
+	REQUIRE( bar.size() == 100 );
+	REQUIRE( *bar.begin() == std::string(50, 'x') );
+
+	bar.clear();
+	REQUIRE( bar.size() == 0 );
+
+	// copies have pools of their own
+	List<std::string, PoolAllocator> qux = bar;
+	qux.append("qux");
+	REQUIRE( bar.size() == 0 );
+	REQUIRE( qux.size() == 1 );
+}
+
+namespace {
+
+/// counts how many of its kind are alive
+struct Counted {
+	Counted() { ++alive; }
+	~Counted() { --alive; }
+	static int alive;
+};
+
+int Counted::alive = 0;
+
+} // namespace
+
+TEST_CASE("An arena hands out aligned memory", "[allocator][arena]")
+{
+	Arena arena;
+	REQUIRE( arena.blocks() == 0 );
+
+	char const * text = arena.copy("hello", 5);
+	REQUIRE( std::string(text, 5) == "hello" );
+
+	double * number = arena.create<double>(4.5);
+	REQUIRE( reinterpret_cast<std::uintptr_t>(number) % alignof(double) == 0 );
+	REQUIRE( *number == 4.5 );
+	REQUIRE( std::string(text, 5) == "hello" );
+
+	// bigger than a block gets a block of its own size
+	char * huge = static_cast<char *>(arena.allocate(1 << 21));
+	huge[(1 << 21) - 1] = 'x';
+	REQUIRE( arena.bytes() >= (1 << 21) + 5 + sizeof(double) );
+
+	// lots of small ones fill a few growing blocks
+	for (unsigned int k = 0; k < 100000; ++k)
+	{
+		REQUIRE( *arena.create<unsigned int>(k) == k );
+	}
+	REQUIRE( arena.blocks() < 20 );
+
+	arena.release();
+	REQUIRE( arena.blocks() == 0 );
+	REQUIRE( arena.bytes() == 0 );
+	REQUIRE( *arena.create<int>(7) == 7 );
+}
+
+TEST_CASE("An arena deletes what it adopted", "[allocator][arena]")
+{
+	{
+		Arena arena;
+		arena.adopt(new Counted);
+		arena.adopt(new Counted);
+		REQUIRE( Counted::alive == 2 );
+
+		arena.release();
+		REQUIRE( Counted::alive == 0 );
+
+		arena.adopt(new Counted);
+		REQUIRE( Counted::alive == 1 );
+	}
+	REQUIRE( Counted::alive == 0 );
+}
+
+TEST_CASE("Vectors can take their storage from an arena", "[allocator][arena]")
+{
+	Arena arena;
+	Vector<std::string, ArenaStorage> foo((ArenaStorage(&arena)));
+	for (unsigned int k = 0; k < 100; ++k)
+	{
+		foo.push_back(std::string(k, 'x'));
+	}
+	REQUIRE( foo.size() == 100 );
+	REQUIRE( foo[99] == std::string(99, 'x') );
+	REQUIRE( arena.bytes() >= 100 * sizeof(std::string) );
+
+	// moves take the arena along, copies go to the heap
+	Vector<std::string, ArenaStorage> bar(std::move(foo));
+	REQUIRE( bar.size() == 100 );
+	std::size_t bytes = arena.bytes();
+	Vector<std::string, ArenaStorage> qux(bar);
+	REQUIRE( qux.size() == 100 );
+	REQUIRE( arena.bytes() == bytes );
+	while (bar.size() <= 128)
+	{
+		bar.push_back("more");
+	}
+	REQUIRE( arena.bytes() > bytes );
+
+	// without an arena it's the heap
+	Vector<int, ArenaStorage> heap;
+	heap.push_back(1);
+	REQUIRE( heap[0] == 1 );
+}
@@ -0,0 +1,76 @@
+#include "catch/catch.hpp"
+#include "nostl/cow_string.hxx"
+
+#include <sstream> // test prints into stringstreams
+#include <string>
+
+using namespace nostl;
+
+TEST_CASE("An owned string behaves like an std::string", "[cow_string]")
+{
+	CowString foo("lemon");
+	REQUIRE_FALSE( foo.borrowed() );
+	REQUIRE( foo.size() == 5 );
+	REQUIRE( foo == "lemon" );
+	REQUIRE( foo == std::string("lemon") );
+	REQUIRE( foo != "lime" );
+	REQUIRE( foo.str() == "lemon" );
+
+	CowString bar;
+	REQUIRE( bar.empty() );
+	bar = std::string("lime");
+	REQUIRE( bar == "lime" );
+}
+
+TEST_CASE("A view borrows until it's mutated", "[cow_string]")
+{
+	char const buffer[] = "mineral water\nmilk\n";
+	CowString foo = CowString::view(buffer, 13);
+
+	REQUIRE( foo.borrowed() );
+	REQUIRE( foo.data() == buffer );
+	REQUIRE( foo == "mineral water" );
+
+	// copies of a view are views too
+	CowString bar = foo;
+	REQUIRE( bar.borrowed() );
+	REQUIRE( bar == foo );
+
+	// writing copies the characters first
+	bar.mutate() += " (still)";
+	REQUIRE_FALSE( bar.borrowed() );
+	REQUIRE( bar == "mineral water (still)" );
+	REQUIRE( foo.borrowed() );
+	REQUIRE( foo == "mineral water" );
+	REQUIRE( std::string(buffer) == "mineral water\nmilk\n" );
+}
+
+TEST_CASE("Views and owned strings hash and print the same", "[cow_string]")
+{
+	char const buffer[] = "milk";
+	CowString foo = CowString::view(buffer, 4);
+	CowString bar("milk");
+
+	REQUIRE( Hash<CowString>()(foo) == Hash<CowString>()(bar) );
+	REQUIRE( Hash<CowString>()(foo) == Hash<std::string>()("milk") );
+
+	std::stringstream ss;
+	ss << foo << ' ' << bar;
+	REQUIRE( ss.str() == "milk milk" );
+}
+
+TEST_CASE("An owned string can become a view", "[cow_string]")
+{
+	char const buffer[] = "milk";
+	CowString foo("a rather long name that doesn't fit in place");
+
+	foo.borrow(buffer, 4);
+	REQUIRE( foo.borrowed() );
+	REQUIRE( foo.data() == buffer );
+	REQUIRE( foo == "milk" );
+	REQUIRE( foo == CowString::view(buffer, 4) );
+
+	foo.mutate() += " shake";
+	REQUIRE( foo == "milk shake" );
+	REQUIRE( std::string(buffer) == "milk" );
+}
@@ -0,0 +1,74 @@
+#include "catch/catch.hpp"
+#include "nostl/hash_map.hxx"
+
+#include <string> // test uses strings as keys
+
+using namespace nostl;
+
+TEST_CASE("Empty hash map can be created", "[hash_map][sanity]")
+{
+	HashMap<int, int> foo;
+	REQUIRE( foo.size() == 0 );
+	REQUIRE( foo.empty() );
+	REQUIRE( foo.find(42) == nullptr );
+	REQUIRE_FALSE( foo.remove(42) );
+	REQUIRE( foo.begin() == foo.end() );
+}
+
+TEST_CASE("Keys can be added, found and removed", "[hash_map]")
+{
+	HashMap<std::string, unsigned int> foo;
+	REQUIRE( foo.insert("gin", 4) );
+	REQUIRE( foo.insert("tonic", 10) );
+	REQUIRE_FALSE( foo.insert("gin", 5) );
+	REQUIRE( *foo.find("gin") == 4 );
+
+	foo["lime"] += 2;
+	foo["lime"] += 2;
+	REQUIRE( foo.size() == 3 );
+	REQUIRE( *foo.find("lime") == 4 );
+
+	REQUIRE( foo.remove("gin") );
+	REQUIRE_FALSE( foo.contains("gin") );
+	REQUIRE( foo.contains("tonic") );
+	REQUIRE( foo.size() == 2 );
+
+	unsigned int sum = 0;
+	for (HashMap<std::string, unsigned int>::Iterator i = foo.begin();
+			i != foo.end(); ++i)
+	{
+		sum += i.value();
+	}
+	REQUIRE( sum == 14 );
+
+	foo.clear();
+	REQUIRE( foo.empty() );
+	REQUIRE( foo.find("tonic") == nullptr );
+}
+
+TEST_CASE("A hash map stays consistent under churn", "[hash_map]")
+{
+	HashMap<unsigned int, unsigned int> foo;
+	for (unsigned int i = 0; i < 10000; ++i)
+	{
+		REQUIRE( foo.insert(i, i * 2) );
+	}
+	for (unsigned int i = 0; i < 10000; i += 3)
+	{
+		REQUIRE( foo.remove(i) );
+	}
+
+	REQUIRE( foo.size() == 10000 - 3334 );
+	for (unsigned int i = 0; i < 10000; ++i)
+	{
+		if (i % 3 == 0)
+		{
+			REQUIRE( foo.find(i) == nullptr );
+		}
+		else
+		{
+			REQUIRE( foo.find(i) != nullptr );
+			REQUIRE( *foo.find(i) == i * 2 );
+		}
+	}
+}
@@ -0,0 +1,182 @@
+#include "catch/catch.hpp"
+#include "nostl/hash_set.hxx"
+
+#include <cctype> // test compares strings case-insensitively
+#include <string> // test stores strings
+
+using namespace nostl;
+
+TEST_CASE("Empty hash set can be created", "[hashset][sanity]")
+{
+	HashSet<int> foo;
+	REQUIRE( foo.size() == 0 );
+	REQUIRE_FALSE( foo.contains(0) );
+	REQUIRE( foo.begin() == foo.end() );
+}
+
+TEST_CASE("A hash set can be filled", "[hashset]")
+{
+	HashSet<int> foo;
+	for (int i = 0; i < 10000; ++i)
+	{
+		foo.insert(i);
+	}
+
+	SECTION("Filling works")
+	{
+		REQUIRE( foo.size() == 10000 );
+		REQUIRE( foo.contains(0) );
+		REQUIRE( foo.contains(9999) );
+		REQUIRE_FALSE( foo.contains(10000) );
+	}
+
+	SECTION("Same elements cannot be readded")
+	{
+		foo.insert(1);
+		foo.insert(0);
+		REQUIRE( foo.size() == 10000 );
+	}
+}
+
+TEST_CASE("A hash set iterates in insertion order", "[hashset][iterators]")
+{
+	// create new HashSet and fill with ints like {200, 5, 1}
+	HashSet<int> foo;
+	foo.insert(200);
+	foo.insert(5);
+	foo.insert(1);
+
+	HashSet<int>::Iterator i = foo.begin();
+	--i;
+	REQUIRE( *(i++) == 200 );
+	REQUIRE( *(i++) == 5 );
+	REQUIRE( *i == 1 );
+
+	i = foo.end();
+	--i;
+	REQUIRE( *(i--) == 1 );
+	REQUIRE( *i == 5 );
+
+	i = foo.end();
+	HashSet<int>::Iterator j = i;
+	++i;
+	REQUIRE( i == j );
+}
+
+TEST_CASE("Elements can be removed from a hash set", "[hashset]")
+{
+	HashSet<std::string> foo;
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		foo.insert(std::to_string(i));
+	}
+
+	// remove most of them, so entries get compacted on the way
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		if (i % 10 != 0)
+		{
+			foo.remove(std::to_string(i));
+		}
+	}
+	REQUIRE( foo.size() == 100 );
+
+	// order is kept
+	unsigned int expected = 0;
+	for (HashSet<std::string>::Iterator i = foo.begin(); i != foo.end(); ++i)
+	{
+		REQUIRE( *i == std::to_string(expected) );
+		expected += 10;
+	}
+
+	// remove a nonexistent one
+	foo.remove("foo");
+	REQUIRE( foo.size() == 100 );
+
+	// removed elements can be readded (they go to the end)
+	foo.insert("1");
+	REQUIRE( foo.contains("1") );
+	HashSet<std::string>::Iterator i = foo.end();
+	REQUIRE( *(--i) == "1" );
+
+	foo.clear();
+	REQUIRE( foo.size() == 0 );
+	REQUIRE_FALSE( foo.contains("0") );
+}
+
+TEST_CASE("Removing from the front of a hash set keeps begin() right",
+			"[hashset]")
+{
+	HashSet<int> foo;
+	for (int i = 0; i < 100; ++i)
+	{
+		foo.insert(i);
+	}
+
+	for (int i = 0; i < 100; ++i)
+	{
+		REQUIRE( *foo.begin() == i );
+		foo.remove(i);
+	}
+	REQUIRE( foo.begin() == foo.end() );
+}
+
+/// \brief hash policy that ignores case
+struct CaselessHash {
+	std::uint64_t operator()(std::string const & value) const
+	{
+		std::string lower;
+		for (unsigned int k = 0; k < value.size(); ++k)
+		{
+			lower += std::tolower(static_cast<unsigned char>(value[k]));
+		}
+		return Hash<std::string>()(lower);
+	}
+};
+
+/// \brief equality policy that ignores case
+struct CaselessEqual {
+	bool operator()(std::string const & lhs, std::string const & rhs) const
+	{
+		if (lhs.size() != rhs.size())
+		{
+			return false;
+		}
+		for (unsigned int k = 0; k < lhs.size(); ++k)
+		{
+			if (std::tolower(static_cast<unsigned char>(lhs[k])) !=
+					std::tolower(static_cast<unsigned char>(rhs[k])))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+TEST_CASE("Hash sets can use custom policies", "[hashset]")
+{
+	HashSet<std::string, CaselessHash, CaselessEqual> foo;
+	foo.insert("Gin");
+	foo.insert("GIN");
+	foo.insert("tonic");
+
+	REQUIRE( foo.size() == 2 );
+	REQUIRE( foo.contains("gin") );
+	REQUIRE( *foo.begin() == "Gin" );
+}
+
+TEST_CASE("Hash sets compare as sets", "[hashset]")
+{
+	HashSet<int> foo;
+	HashSet<int> bar;
+	foo.insert(1);
+	foo.insert(2);
+	bar.insert(2);
+	bar.insert(1);
+
+	REQUIRE( foo == bar );
+
+	bar.remove(1);
+	REQUIRE( foo != bar );
+}
@@ -0,0 +1,102 @@
+#include "catch/catch.hpp"
+#include "nostl/indexed_sequence.hxx"
+#include "nostl/hash_set.hxx"
+
+#include <string> // test stores strings
+
+using namespace nostl;
+
+TEST_CASE("Empty indexed sequence can be created", "[indexed][sanity]")
+{
+	IndexedSequence<int> foo;
+	REQUIRE( foo.size() == 0 );
+	REQUIRE( foo.first() == foo.slots() );
+}
+
+TEST_CASE("Elements of an indexed sequence can be found by rank", "[indexed]")
+{
+	// fill with {0, 1, ..., 999}
+	IndexedSequence<int> foo;
+	for (int i = 0; i < 1000; ++i)
+	{
+		REQUIRE( foo.append(i) == static_cast<unsigned int>(i) );
+	}
+
+	REQUIRE( foo.at(0) == 0 );
+	REQUIRE( foo.at(999) == 999 );
+
+	// erase every third element by rank, from the back
+	for (int i = 999; i >= 0; i -= 3)
+	{
+		foo.eraseAt(i);
+	}
+	REQUIRE( foo.size() == 666 );
+
+	// check what's left against the expected sequence
+	unsigned int rank = 0;
+	for (int i = 0; i < 1000; ++i)
+	{
+		if ((999 - i) % 3 != 0)
+		{
+			REQUIRE( foo.at(rank) == i );
+			REQUIRE( foo.rankOf(foo.slotOf(rank)) == rank );
+			++rank;
+		}
+	}
+}
+
+TEST_CASE("An indexed sequence can be compacted", "[indexed]")
+{
+	IndexedSequence<std::string> foo;
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		foo.append(std::to_string(i));
+	}
+	for (unsigned int i = 0; i < 50; ++i)
+	{
+		foo.eraseAt(0);
+	}
+
+	REQUIRE( foo.first() == 50 );
+
+	foo.compact();
+	REQUIRE( foo.slots() == 50 );
+	REQUIRE( foo.first() == 0 );
+	REQUIRE( foo.at(0) == "50" );
+	REQUIRE( foo.at(49) == "99" );
+
+	// appending after compaction works too
+	foo.append("100");
+	REQUIRE( foo.at(50) == "100" );
+	REQUIRE( foo.next(foo.slotOf(49)) == foo.slotOf(50) );
+}
+
+TEST_CASE("Hash sets can be indexed", "[indexed][hashset]")
+{
+	HashSet<int> foo;
+	for (int i = 0; i < 100; ++i)
+	{
+		foo.insert(i * 10);
+	}
+
+	REQUIRE( foo.at(42) == 420 );
+	REQUIRE( foo.indexOf(420) == 42 );
+	REQUIRE( foo.indexOf(421) == foo.size() );
+
+	foo.removeAt(0);
+	REQUIRE( foo.size() == 99 );
+	REQUIRE_FALSE( foo.contains(0) );
+	REQUIRE( foo.at(0) == 10 );
+	REQUIRE( foo.indexOf(420) == 41 );
+
+	// remove enough to trigger compaction and make sure ranks still work
+	for (int i = 0; i < 60; ++i)
+	{
+		foo.removeAt(10);
+	}
+	REQUIRE( foo.size() == 39 );
+	REQUIRE( foo.at(9) == 100 );
+	REQUIRE( foo.at(10) == 710 );
+	REQUIRE( foo.contains(710) );
+	REQUIRE_FALSE( foo.contains(700) );
+}
@@ -1,6 +1,9 @@
 #include "catch/catch.hpp"
 #include "nostl/list.hxx"
 
+#include <string> // test stores strings
+#include <utility> // test moves Lists
+
 using namespace nostl;
 
 TEST_CASE("Empty list can be created", "[list][sanity]")
@@ -190,3 +193,58 @@ TEST_CASE("Elements can be removed from a list", "[list]")
 	i = foo.begin();
 	REQUIRE( *i == 3 );
 }
+
+TEST_CASE("A list can be moved", "[list][move]")
+{
+	// create List with a few ints like {0, 1, ..., 99}
+	List<int> foo;
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		foo.append(i);
+	}
+
+	SECTION("Move construction steals the elements")
+	{
+		List<int> bar = std::move(foo);
+		REQUIRE( bar.size() == 100 );
+		REQUIRE( foo.size() == 0 );
+		REQUIRE( *bar.begin() == 0 );
+		REQUIRE( *(--bar.end()) == 99 );
+
+		// the moved-from List is still usable
+		foo.append(5);
+		REQUIRE( foo.size() == 1 );
+		REQUIRE( *foo.begin() == 5 );
+	}
+
+	SECTION("Move assignment steals the elements")
+	{
+		List<int> bar;
+		bar.append(1000);
+		bar = std::move(foo);
+		REQUIRE( bar.size() == 100 );
+		REQUIRE( foo.size() == 0 );
+
+		// an empty List can be moved too
+		bar = std::move(foo);
+		REQUIRE( bar.size() == 0 );
+		REQUIRE( bar.begin() == bar.end() );
+	}
+}
+
+TEST_CASE("Elements can be moved or emplaced into a list", "[list][move]")
+{
+	List<std::string> foo;
+	std::string bar(100, 'x');
+
+	foo.append(std::move(bar));
+	foo.prepend(std::string("first"));
+	foo.emplace_back(3, 'y');
+
+	REQUIRE( foo.size() == 3 );
+
+	List<std::string>::Iterator i = foo.begin();
+	REQUIRE( *(i++) == "first" );
+	REQUIRE( *(i++) == std::string(100, 'x') );
+	REQUIRE( *i == "yyy" );
+}
@@ -0,0 +1,151 @@
+#include "catch/catch.hpp"
+#include "nostl/radix_trie.hxx"
+
+#include <cstdlib> // test uses rand()
+#include <string> // test uses strings as keys
+
+using namespace nostl;
+
+namespace {
+
+/// keys of completions, separated by spaces
+std::string keys(Vector<RadixTrie<int>::Entry> const & entries)
+{
+	std::string result;
+	for (unsigned int k = 0; k < entries.size(); ++k)
+	{
+		result += (k == 0 ? "" : " ") + entries[k].key;
+	}
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("Empty radix trie can be created", "[radix_trie][sanity]")
+{
+	RadixTrie<int> foo;
+	REQUIRE( foo.size() == 0 );
+	REQUIRE( foo.empty() );
+	REQUIRE( foo.find("gin") == nullptr );
+	REQUIRE( foo.find("") == nullptr );
+	REQUIRE_FALSE( foo.remove("gin") );
+	REQUIRE( foo.complete("", 10).empty() );
+}
+
+TEST_CASE("Keys can be added to, found in and removed from a trie", "[radix_trie]")
+{
+	RadixTrie<int> foo;
+	REQUIRE( foo.insert("martini", 1) );
+	REQUIRE( foo.insert("margarita", 2) );
+	REQUIRE( foo.insert("mar", 3) );
+	REQUIRE( foo.insert("manhattan", 4) );
+	REQUIRE( foo.insert("", 5) );
+	REQUIRE_FALSE( foo.insert("mar", 6) );
+	foo["mojito"] += 7;
+	REQUIRE( foo.size() == 6 );
+
+	REQUIRE( *foo.find("mar") == 3 );
+	REQUIRE( *foo.find("margarita") == 2 );
+	REQUIRE( *foo.find("") == 5 );
+	REQUIRE( *foo.find("mojito") == 7 );
+	REQUIRE( foo.find("ma") == nullptr );
+	REQUIRE( foo.find("marg") == nullptr );
+	REQUIRE( foo.find("margaritas") == nullptr );
+
+	REQUIRE( foo.remove("mar") );
+	REQUIRE_FALSE( foo.remove("mar") );
+	REQUIRE_FALSE( foo.remove("marti") );
+	REQUIRE( foo.find("mar") == nullptr );
+	REQUIRE( *foo.find("martini") == 1 );
+	REQUIRE( foo.remove("martini") );
+	REQUIRE( *foo.find("margarita") == 2 );
+	REQUIRE( foo.remove("") );
+	REQUIRE( foo.size() == 3 );
+	REQUIRE( keys(foo.complete("", 10)) == "manhattan margarita mojito" );
+
+	foo.clear();
+	REQUIRE( foo.empty() );
+	REQUIRE( foo.find("mojito") == nullptr );
+}
+
+TEST_CASE("Keys with a prefix are listed in order", "[radix_trie]")
+{
+	RadixTrie<int> foo;
+	foo.insert("martini", 1);
+	foo.insert("margarita", 2);
+	foo.insert("mar", 3);
+	foo.insert("manhattan", 4);
+	foo.insert("Mai Tai", 5);
+	foo.insert("mojito", 6);
+
+	REQUIRE( keys(foo.complete("ma", 10)) == "manhattan mar margarita martini" );
+	REQUIRE( keys(foo.complete("ma", 2)) == "manhattan mar" );
+	REQUIRE( keys(foo.complete("marg", 10)) == "margarita" );
+	REQUIRE( keys(foo.complete("mar", 10)) == "mar margarita martini" );
+	REQUIRE( keys(foo.complete("martinis", 10)) == "" );
+	REQUIRE( keys(foo.complete("x", 10)) == "" );
+	REQUIRE( keys(foo.complete("", 3)) == "Mai Tai manhattan mar" );
+	REQUIRE( *foo.complete("mo", 1)[0].value == 6 );
+	REQUIRE( foo.complete("ma", 0).empty() );
+}
+
+TEST_CASE("A radix trie agrees with a naive map", "[radix_trie]")
+{
+	std::srand(42);
+	RadixTrie<int> foo;
+	Vector<std::string> naive;
+	for (unsigned int round = 0; round < 2000; ++round)
+	{
+		// short keys over a tiny alphabet share lots of prefixes
+		std::string key;
+		for (unsigned int k = std::rand() % 6; k > 0; --k)
+		{
+			key += static_cast<char>('a' + std::rand() % 3);
+		}
+
+		unsigned int at = 0;
+		while (at < naive.size() && naive[at] != key)
+		{
+			++at;
+		}
+		bool there = at < naive.size();
+
+		if (std::rand() % 3 == 0)
+		{
+			REQUIRE( foo.remove(key) == there );
+			if (there)
+			{
+				naive.erase(at);
+			}
+		}
+		else
+		{
+			REQUIRE( foo.insert(key, round) == !there );
+			if (!there)
+			{
+				naive.push_back(key);
+			}
+		}
+
+		REQUIRE( foo.size() == naive.size() );
+		for (unsigned int k = 0; k < naive.size(); ++k)
+		{
+			REQUIRE( foo.find(naive[k]) != nullptr );
+		}
+	}
+
+	// every key shows up under its prefixes, in order
+	Vector<RadixTrie<int>::Entry> all = foo.complete("", 1000);
+	REQUIRE( all.size() == naive.size() );
+	for (unsigned int k = 1; k < all.size(); ++k)
+	{
+		REQUIRE( all[k - 1].key < all[k].key );
+	}
+	Vector<RadixTrie<int>::Entry> some = foo.complete("ab", 1000);
+	unsigned int expected = 0;
+	for (unsigned int k = 0; k < naive.size(); ++k)
+	{
+		expected += naive[k].compare(0, 2, "ab") == 0;
+	}
+	REQUIRE( some.size() == expected );
+}
@@ -1,6 +1,9 @@
 #include "catch/catch.hpp"
 #include "nostl/set.hxx"
 
+#include <string> // test stores strings
+#include <utility> // test moves Sets
+
 using namespace nostl;
 
 TEST_CASE("Empty set can be created", "[set][sanity]")
@@ -204,3 +207,20 @@ TEST_CASE("Elements can be removed from a set", "[set]")
 	foo.remove(5); // --> {}
 	REQUIRE( foo.size() == 0 );
 }
+
+TEST_CASE("A set can be moved", "[set][move]")
+{
+	// create Set with a few strings
+	Set<std::string> foo;
+	foo.insert(std::string("gin"));
+	foo.insert(std::string("tonic"));
+	foo.insert(std::string("gin"));
+	REQUIRE( foo.size() == 2 );
+	REQUIRE( foo.contains("tonic") );
+
+	// move it into another Set
+	Set<std::string> bar = std::move(foo);
+	REQUIRE( bar.size() == 2 );
+	REQUIRE( foo.size() == 0 );
+	REQUIRE_FALSE( foo.contains("gin") );
+}
@@ -0,0 +1,85 @@
+#include "catch/catch.hpp"
+#include "nostl/sink.hxx"
+
+#include <cstdio> // test reads back a temporary file
+#include <fstream>
+#include <sstream> // test writes into stringstreams
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace nostl;
+
+TEST_CASE("A sink formats strings and numbers", "[sink]")
+{
+	std::stringstream ss;
+	{
+		Sink sink(ss);
+		sink << "beverage\n" << std::string("milk") << '\n'
+			<< CowString("x") << 0u << ' ' << 42u << ' '
+			<< 18446744073709551615ULL;
+	}
+	REQUIRE( ss.str() == "beverage\nmilk\nx0 42 18446744073709551615" );
+}
+
+TEST_CASE("A sink only hands over when full or flushed", "[sink]")
+{
+	std::stringstream ss;
+	Sink sink(ss);
+
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		sink << "line\n";
+	}
+	REQUIRE( ss.str().empty() );
+	REQUIRE( sink.writes() == 0 );
+
+	sink.flush();
+	REQUIRE( ss.str().size() == 5000 );
+	REQUIRE( sink.writes() == 1 );
+
+	// more than the buffer holds
+	std::string big(Sink::CAPACITY + 1, 'x');
+	sink << "a" << big;
+	REQUIRE( ss.str().size() == 5000 + 1 + big.size() );
+	REQUIRE( sink.writes() == 3 );
+	REQUIRE( sink.good() );
+}
+
+TEST_CASE("A sink can write into a file descriptor", "[sink]")
+{
+	char const * const path = "nostl_sink_test.tmp";
+	int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	REQUIRE( fd != -1 );
+	{
+		Sink sink(fd);
+		for (unsigned int i = 0; i < 100000; ++i)
+		{
+			sink << i << '\n';
+		}
+		sink.flush();
+		REQUIRE( sink.good() );
+		REQUIRE( sink.writes() < 20 );
+	}
+	::close(fd);
+
+	std::ifstream ifs(path);
+	unsigned int count = 0, last = 0;
+	while (ifs >> last)
+	{
+		++count;
+	}
+	std::remove(path);
+
+	REQUIRE( count == 100000 );
+	REQUIRE( last == 99999 );
+}
+
+TEST_CASE("A sink notices a broken descriptor", "[sink]")
+{
+	Sink sink(-1);
+	sink << "lost";
+	sink.flush();
+	REQUIRE_FALSE( sink.good() );
+}
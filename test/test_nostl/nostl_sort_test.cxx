@@ -0,0 +1,73 @@
+#include "catch/catch.hpp"
+#include "nostl/sort.hxx"
+#include "nostl/vector.hxx"
+
+#include <cstdlib> // test uses rand()
+#include <utility> // test sorts pairs
+
+using namespace nostl;
+
+namespace {
+
+/// orders pairs by their first element only
+struct ByFirst {
+	bool operator()(std::pair<int, int> const & lhs,
+					std::pair<int, int> const & rhs) const
+	{
+		return lhs.first < rhs.first;
+	}
+};
+
+} // namespace
+
+TEST_CASE("Small and empty ranges can be sorted", "[sort]")
+{
+	int none[1] = { 42 };
+	sort(none, none);
+	REQUIRE( none[0] == 42 );
+
+	int few[] = { 3, 1, 2 };
+	sort(few, few + 3);
+	REQUIRE( few[0] == 1 );
+	REQUIRE( few[1] == 2 );
+	REQUIRE( few[2] == 3 );
+}
+
+TEST_CASE("Large ranges can be sorted", "[sort]")
+{
+	std::srand(42);
+	unsigned int sizes[] = { 16, 17, 100, 1000, 4097 };
+	for (unsigned int s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s)
+	{
+		Vector<int> foo;
+		for (unsigned int k = 0; k < sizes[s]; ++k)
+		{
+			foo.push_back(std::rand() % 100);
+		}
+
+		sort(foo.begin(), foo.end());
+		for (unsigned int k = 1; k < foo.size(); ++k)
+		{
+			REQUIRE( foo[k - 1] <= foo[k] );
+		}
+	}
+}
+
+TEST_CASE("Sorting keeps the order of equal elements", "[sort]")
+{
+	Vector<std::pair<int, int> > foo;
+	for (int k = 0; k < 500; ++k)
+	{
+		foo.push_back(std::make_pair((k * 7) % 5, k));
+	}
+
+	sort(foo.begin(), foo.end(), ByFirst());
+	for (unsigned int k = 1; k < foo.size(); ++k)
+	{
+		REQUIRE( foo[k - 1].first <= foo[k].first );
+		if (foo[k - 1].first == foo[k].first)
+		{
+			REQUIRE( foo[k - 1].second < foo[k].second );
+		}
+	}
+}
@@ -0,0 +1,136 @@
+#include "catch/catch.hpp"
+#include "nostl/unrolled_list.hxx"
+#include "nostl/set.hxx"
+
+#include <string> // test stores strings
+#include <utility> // test moves UnrolledLists
+
+using namespace nostl;
+
+TEST_CASE("Empty unrolled list can be created", "[unrolled][sanity]")
+{
+	UnrolledList<int> foo;
+	REQUIRE( foo.size() == 0 );
+	REQUIRE( foo.begin() == foo.end() );
+}
+
+TEST_CASE("An unrolled list keeps the order of elements", "[unrolled]")
+{
+	// fill with enough ints to need plenty of Chunks: {-499, ..., 0, ..., 999}
+	UnrolledList<int> foo;
+	for (int i = 0; i < 1000; ++i)
+	{
+		foo.append(i);
+	}
+	for (int i = 1; i < 500; ++i)
+	{
+		foo.prepend(-i);
+	}
+
+	REQUIRE( foo.size() == 1499 );
+
+	int expected = -499;
+	for (UnrolledList<int>::Iterator i = foo.begin(); i != foo.end(); ++i)
+	{
+		REQUIRE( *i == expected++ );
+	}
+	REQUIRE( expected == 1000 );
+}
+
+TEST_CASE("Unrolled list iterators behave like List iterators",
+			"[unrolled][iterators]")
+{
+	// create new UnrolledList and fill with ints like {200, 5, 1}
+	UnrolledList<int> foo;
+	foo.append(5);
+	foo.append(1);
+	foo.prepend(200);
+
+	UnrolledList<int>::Iterator i = foo.begin();
+	REQUIRE( *(i++) == 200 );
+	REQUIRE( *i == 5 );
+
+	// don't go below the first element
+	i = foo.begin();
+	--i;
+	REQUIRE( *i == 200 );
+
+	// step back from end(), but don't go past it
+	i = foo.end();
+	--i;
+	REQUIRE( *(i--) == 1 );
+	REQUIRE( *i == 5 );
+
+	i = foo.end();
+	UnrolledList<int>::Iterator j = i;
+	++i;
+	REQUIRE( i == j );
+}
+
+TEST_CASE("Elements can be removed from an unrolled list", "[unrolled]")
+{
+	UnrolledList<std::string> foo;
+	for (unsigned int i = 0; i < 300; ++i)
+	{
+		foo.append(std::to_string(i));
+	}
+
+	// remove every other element, forcing Chunks to merge
+	for (unsigned int i = 0; i < 300; i += 2)
+	{
+		foo.remove(std::to_string(i));
+	}
+	REQUIRE( foo.size() == 150 );
+
+	unsigned int expected = 1;
+	for (UnrolledList<std::string>::Iterator i = foo.begin();
+			i != foo.end(); ++i)
+	{
+		REQUIRE( *i == std::to_string(expected) );
+		expected += 2;
+	}
+
+	// remove a nonexistent one
+	foo.remove("foo");
+	REQUIRE( foo.size() == 150 );
+
+	foo.clear();
+	REQUIRE( foo.size() == 0 );
+	REQUIRE( foo.begin() == foo.end() );
+}
+
+TEST_CASE("An unrolled list can be copied and moved", "[unrolled][move]")
+{
+	UnrolledList<int> foo;
+	for (int i = 0; i < 100; ++i)
+	{
+		foo.append(i);
+	}
+
+	UnrolledList<int> bar = foo;
+	REQUIRE( bar == foo );
+	bar.remove(13);
+	REQUIRE( bar != foo );
+
+	UnrolledList<int> qux = std::move(foo);
+	REQUIRE( qux.size() == 100 );
+	REQUIRE( foo.size() == 0 );
+
+	foo = qux;
+	REQUIRE( foo == qux );
+}
+
+TEST_CASE("A set can be kept in an unrolled list", "[unrolled][set]")
+{
+	Set<int, PoolAllocator, UnrolledList> foo;
+	for (int i = 0; i < 100; ++i)
+	{
+		foo.insert(i % 50);
+	}
+
+	REQUIRE( foo.size() == 50 );
+
+	foo.remove(10);
+	REQUIRE( foo.size() == 49 );
+	REQUIRE_FALSE( foo.contains(10) );
+}
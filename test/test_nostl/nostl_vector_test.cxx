@@ -0,0 +1,98 @@
+#include "catch/catch.hpp"
+#include "nostl/vector.hxx"
+
+#include <string> // test stores strings
+#include <utility> // test moves Vectors
+
+using namespace nostl;
+
+TEST_CASE("Empty vector can be created", "[vector][sanity]")
+{
+	Vector<int> foo;
+	REQUIRE( foo.size() == 0 );
+	REQUIRE( foo.empty() );
+	REQUIRE( foo.begin() == foo.end() );
+}
+
+TEST_CASE("A vector can be filled and indexed", "[vector]")
+{
+	Vector<std::string> foo;
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		foo.push_back(std::to_string(i));
+	}
+
+	REQUIRE( foo.size() == 1000 );
+	REQUIRE( foo.capacity() >= 1000 );
+	REQUIRE( foo[0] == "0" );
+	REQUIRE( foo[999] == "999" );
+	REQUIRE( foo.back() == "999" );
+
+	foo.pop_back();
+	foo.emplace_back(3, 'x');
+	REQUIRE( foo.back() == "xxx" );
+}
+
+TEST_CASE("A vector can be resized", "[vector]")
+{
+	Vector<int> foo(10, 7);
+	REQUIRE( foo.size() == 10 );
+	REQUIRE( foo[9] == 7 );
+
+	foo.resize(3);
+	REQUIRE( foo.size() == 3 );
+
+	foo.resize(5, 1);
+	REQUIRE( foo[2] == 7 );
+	REQUIRE( foo[4] == 1 );
+
+	foo.clear();
+	REQUIRE( foo.empty() );
+}
+
+TEST_CASE("A vector can be copied and moved", "[vector][move]")
+{
+	Vector<int> foo;
+	for (int i = 0; i < 100; ++i)
+	{
+		foo.push_back(i);
+	}
+
+	Vector<int> bar = foo;
+	REQUIRE( bar == foo );
+	bar[0] = 42;
+	REQUIRE( bar != foo );
+
+	Vector<int> qux = std::move(foo);
+	REQUIRE( qux.size() == 100 );
+	REQUIRE( foo.size() == 0 );
+
+	foo = qux;
+	REQUIRE( foo == qux );
+	qux = std::move(bar);
+	REQUIRE( qux[0] == 42 );
+}
+
+TEST_CASE("Elements can be inserted and erased anywhere", "[vector]")
+{
+	Vector<std::string> foo;
+	foo.insert(0, "b");
+	foo.insert(0, "a");
+	foo.insert(2, "d");
+	foo.insert(2, "c");
+
+	REQUIRE( foo.size() == 4 );
+	REQUIRE( foo[0] == "a" );
+	REQUIRE( foo[1] == "b" );
+	REQUIRE( foo[2] == "c" );
+	REQUIRE( foo[3] == "d" );
+
+	foo.erase(1);
+	REQUIRE( foo.size() == 3 );
+	REQUIRE( foo[1] == "c" );
+
+	foo.erase(2);
+	foo.erase(0);
+	REQUIRE( foo.size() == 1 );
+	REQUIRE( foo[0] == "c" );
+}